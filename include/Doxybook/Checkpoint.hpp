@@ -0,0 +1,69 @@
+#pragma once
+#include "Hash.hpp"
+#include "Output.hpp"
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace Doxybook2 {
+    // Journal of a conversion run, so that a run that has been interrupted
+    // can be resumed without starting from zero. The folder holds:
+    //
+    //   key        - identifies the input and the config the journal belongs to
+    //   model.cbor - snapshot of the loaded and finalized model (Doxygen::saveSnapshot)
+    //   journal    - one line per written file: hash of the contents and the path
+    //
+    // The journal is appended and flushed after every file, a line that has
+    // not been completed when the process was killed is ignored.
+    class Checkpoint {
+    public:
+        explicit Checkpoint(std::string dir);
+
+        // Reads the journal if it belongs to the same key, otherwise starts over.
+        // Returns true if the run is resumed.
+        bool open(const std::string& key);
+
+        // Removes the checkpoint, called once the run has finished
+        void remove();
+
+        bool isDone(const std::string& path) const;
+
+        // Called once the file has been written
+        void record(const std::string& path, const std::string& data);
+
+        size_t getDoneCount() const;
+
+        // The hash of the contents of every file written so far, by the path
+        std::unordered_map<std::string, Hash::Value> getDone() const;
+
+        std::string getSnapshotPath() const;
+
+        bool hasSnapshot() const;
+
+        // Marks the snapshot as complete, a snapshot without it is not used
+        void snapshotSaved();
+
+        // The key of the current input (index.xml or the combined file) and config
+        static std::string makeKey(const std::string& input, const std::string& configData);
+
+    private:
+        std::string dir;
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, Hash::Value> done;
+        std::ofstream journal;
+        bool snapshot{false};
+    };
+
+    // Records every file written into the output in the checkpoint journal
+    class CheckpointOutput : public Output {
+    public:
+        CheckpointOutput(Output& output, Checkpoint& checkpoint);
+
+        void write(const std::string& path, const std::string& data) override;
+
+    private:
+        Output& output;
+        Checkpoint& checkpoint;
+    };
+} // namespace Doxybook2
@@ -13,21 +13,55 @@ namespace Doxybook2 {
         // Put all stuff into categorized folders or everything into destination folder?
         bool useFolders{true};
 
+        // Spread the pages of each folder (and the images) into subfolders named after
+        // the first N hex digits of the hash of the page name (Classes/3f/classfoo.md).
+        // Only with useFolders, 0 keeps everything in one folder.
+        int folderShardLength{0};
+
         // Sort alphabetically
         bool sort{false};
 
+        // What is loaded at all? Members less visible than loadVisibility, undocumented
+        // classes and members (unless loadUndocumented), entities whose qualified name
+        // (or any of its enclosing scopes) matches one of the loadExclude wildcard patterns,
+        // and compounds in languages not in loadLanguages (if not empty) are skipped.
+        Visibility loadVisibility{Visibility::PRIVATE};
+        bool loadUndocumented{true};
+        std::vector<std::string> loadExclude{};
+        std::vector<std::string> loadLanguages{};
+
+        // What to do with the source code of the files: keep it in the page (inline),
+        // leave it out (none), or write it into a file next to the page (file)?
+        SourceListing sourceListing{SourceListing::INLINE};
+
         // Copy images from the Doxygen xml dir?
         bool copyImages{true};
 
         // Where to copy images
         std::string imagesFolder{"images"};
 
+        // Put the hash of the contents into the names of the copied images (logo.<hash>.png)?
+        bool hashImageNames{false};
+
+        // Write hashes.json with the hash of the contents of every generated file?
+        bool contentHashes{false};
+
+        // Write symbols.idx with the names of all symbols for "doxybook2 query"?
+        bool symbolIndex{false};
+
         // Convert all refids (including folder names) into lowercase?
         bool linkLowercase{false};
 
         // Output links as HTML <a> tags and inline code as <code> tags instead of Markdown.
         bool linkAndInlineCodeAsHTML{false};
 
+        // Generate Markdown pages or HTML pages that can be served as they are?
+        OutputFormat outputFormat{OutputFormat::MARKDOWN};
+
+        // HTML only: generate only the page bodies without <html>, <head>, and <body>,
+        // for themes that wrap the generated fragments into their own layout.
+        bool htmlFragments{false};
+
         // Should we put the class, namespace, modules, and files indexes
         // into their respective folders? (Hugo/Learn) needs that!
         bool indexInFolders{false};
@@ -110,9 +144,43 @@ namespace Doxybook2 {
         std::string formulaInlineEnd{"\\)"};
         std::string formulaBlockStart{"\\["};
         std::string formulaBlockEnd{"\\]"};
+
+        // How many threads should each stage of the page pipeline use?
+        int pipelineConvertThreads{1};
+        int pipelineRenderThreads{1};
+        int pipelineWriteThreads{1};
+
+        // How many pages can wait in front of each stage of the pipeline?
+        int pipelineQueueSize{64};
+
+        // How many threads run the work of all of the stages? 0 => one per core.
+        // The threads of each stage above are the most the stage may use at once.
+        int schedulerThreads{0};
+        bool schedulerPinThreads{false};
+
+        // Render in this many processes forked once the model is loaded, instead of the pipeline threads?
+        // 0 => use the pipeline. The pages are handed out in batches, the files are written by the parent.
+        int renderProcesses{0};
+        int renderProcessBatchSize{16};
+
+        // How long (seconds) and how large (bytes) can a single rendered page be? 0 => no limit.
+        // Pages over the limit are reported and replaced by a placeholder, or skipped.
+        int renderTimeLimit{0};
+        int renderSizeLimit{0};
+        bool renderLimitPlaceholder{true};
+
+        // Keep the brief and the summary of the nodes compressed in memory?
+        // Texts shorter than the minimum length are not worth it and are kept as they are.
+        bool compressText{false};
+        int compressTextMinLength{64};
+
+        // How many base classes keep their converted members in memory, to be listed
+        // as inherited members in the pages of the derived classes? 0 => none.
+        int inheritedCacheSize{64};
     };
 
     void loadConfig(Config& config, const std::string& path);
     void loadConfigData(Config& config, const std::string& src);
     void saveConfig(Config& config, const std::string& path);
+    std::string saveConfigData(const Config& config);
 } // namespace Doxybook2
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Config.hpp"
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -10,6 +11,15 @@ namespace Doxybook2 {
         std::vector<std::string> dependencies;
     };
 
-    extern std::unordered_map<std::string, DefaultTemplate> defaultTemplates;
-    extern void saveDefaultTemplates(const std::string& path);
+    typedef std::unordered_map<std::string, DefaultTemplate> DefaultTemplates;
+
+    extern DefaultTemplates defaultTemplates;
+    // Same names and dependencies as the Markdown templates, but generate HTML pages
+    extern DefaultTemplates defaultHtmlTemplates;
+    // HTML templates that generate only the body of the page (see Config::htmlFragments)
+    extern DefaultTemplates defaultHtmlFragmentTemplates;
+
+    // The default templates for the config.outputFormat
+    extern const DefaultTemplates& getDefaultTemplates(const Config& config);
+    extern void saveDefaultTemplates(const std::string& path, const DefaultTemplates& templates = defaultTemplates);
 } // namespace Doxybook2
\ No newline at end of file
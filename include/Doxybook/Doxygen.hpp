@@ -1,19 +1,31 @@
 #pragma once
 #include <unordered_map>
+#include <unordered_set>
 #include <string>
 #include "Node.hpp"
+#include "TextStore.hpp"
+#include "XmlSource.hpp"
+#include <memory>
 
 namespace Doxybook2 {
     class TextPrinter;
+    class Progress;
 
     class Doxygen {
     public:
         explicit Doxygen(const Config& config);
         virtual ~Doxygen() = default;
 
-        void load(const std::string& inputDir);
+        // Loads the Doxygen xml folder (with index.xml) or a single combined xml file (all.xml)
+        void load(const std::string& input);
         void finalize(const TextPrinter& plainPrinter, const TextPrinter& markdownPrinter);
 
+        // Saves the loaded and finalized model, so that it can be restored
+        // by loadSnapshot() instead of calling load() and finalize() again.
+        // The data of the pages is still loaded from the input when rendered.
+        void saveSnapshot(const std::string& path) const;
+        void loadSnapshot(const std::string& input, const std::string& path);
+
         const Node& getIndex() const {
             return *index;
         }
@@ -26,14 +38,22 @@ namespace Doxybook2 {
     private:
         typedef std::unordered_multimap<std::string, std::string> KindRefidMap;
 
-        KindRefidMap getIndexKinds(const std::string& inputDir) const;
+        KindRefidMap getIndexKinds() const;
         void getIndexCache(NodeCacheMap& cache, const NodePtr& node) const;
         void finalizeRecursively(const TextPrinter& plainPrinter,
                                  const TextPrinter& markdownPrinter,
-                                 const NodePtr& node);
+                                 const NodePtr& node,
+                                 Progress& progress);
         void updateGroupPointers(const NodePtr& node);
+        Hash::Value hashRecursively(const NodePtr& node, std::unordered_set<const Node*>& visited);
+        const Node::Inherited& inheritRecursively(Node& node, std::unordered_set<const Node*>& visited);
+        void compressTexts();
 
         const Config& config;
+        // Owns the xml of the compounds, the nodes load their data from it when rendered
+        std::unique_ptr<XmlSource> source;
+        // Owns the brief and the summary of the nodes
+        std::unique_ptr<TextStore> texts;
         // The root object that holds everything (index.xml)
         NodePtr index;
         NodeCacheMap cache;
@@ -57,17 +57,25 @@ namespace Doxybook2 {
 
     enum class FolderCategory { CLASSES, NAMESPACES, MODULES, PAGES, FILES, EXAMPLES };
 
+    enum class OutputFormat { MARKDOWN, HTML };
+
+    enum class SourceListing { INLINE, NONE, FILE };
+
     extern Kind toEnumKind(const std::string& str);
     extern Type toEnumType(const std::string& str);
     extern Visibility toEnumVisibility(const std::string& str);
     extern Virtual toEnumVirtual(const std::string& str);
     extern FolderCategory toEnumFolderCategory(const std::string& str);
+    extern OutputFormat toEnumOutputFormat(const std::string& str);
+    extern SourceListing toEnumSourceListing(const std::string& str);
 
     extern std::string toStr(Kind value);
     extern std::string toStr(Type value);
     extern std::string toStr(Visibility value);
     extern std::string toStr(Virtual value);
     extern std::string toStr(FolderCategory value);
+    extern std::string toStr(OutputFormat value);
+    extern std::string toStr(SourceListing value);
 
     extern Type kindToType(Kind kind);
 
@@ -76,6 +84,8 @@ namespace Doxybook2 {
     extern bool isKindFile(Kind kind);
     extern std::string typeFolderCategoryToFolderName(const Config& config, FolderCategory type);
     extern std::string typeToFolderName(const Config& config, Type type);
+    extern std::string shardFolderName(const Config& config, const std::string& name);
+    extern std::string shardPath(const Config& config, const std::string& name);
     extern std::string typeToIndexName(const Config& config, FolderCategory type);
     extern std::string typeToIndexTemplate(const Config& config, FolderCategory type);
     extern std::string typeToIndexTitle(const Config& config, FolderCategory type);
@@ -95,4 +105,20 @@ namespace Doxybook2 {
     inline void from_json(const nlohmann::json& j, FolderCategory& p) {
         p = toEnumFolderCategory(j.get<std::string>());
     }
+
+    inline void to_json(nlohmann::json& j, const OutputFormat& p) {
+        j = toStr(p);
+    }
+
+    inline void from_json(const nlohmann::json& j, OutputFormat& p) {
+        p = toEnumOutputFormat(j.get<std::string>());
+    }
+
+    inline void to_json(nlohmann::json& j, const SourceListing& p) {
+        j = toStr(p);
+    }
+
+    inline void from_json(const nlohmann::json& j, SourceListing& p) {
+        p = toEnumSourceListing(j.get<std::string>());
+    }
 } // namespace Doxybook2
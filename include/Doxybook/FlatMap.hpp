@@ -0,0 +1,158 @@
+#pragma once
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace Doxybook2 {
+    // A map kept as a vector sorted by key, usable as the object type of nlohmann::basic_json.
+    // The template data objects are small (rarely more than 30 keys), built once and then
+    // only read, so one contiguous allocation with a binary search beats a node per key.
+    // Iterates in the same order as std::map, so the dumped JSON is identical.
+    // The keys are not const, so that growing the vector moves the values instead
+    // of copying them, basic_json never hands out a mutable reference to a key.
+    template <class Key,
+        class T,
+        class IgnoredLess = std::less<Key>,
+        class Allocator = std::allocator<std::pair<const Key, T>>>
+    struct FlatMap : std::vector<std::pair<Key, T>,
+                         typename std::allocator_traits<Allocator>::template rebind_alloc<std::pair<Key, T>>> {
+        using key_type = Key;
+        using mapped_type = T;
+        // Not transparent on purpose, basic_json then only looks up by key_type
+        using key_compare = std::less<Key>;
+        using Container = std::vector<std::pair<Key, T>,
+            typename std::allocator_traits<Allocator>::template rebind_alloc<std::pair<Key, T>>>;
+        using iterator = typename Container::iterator;
+        using const_iterator = typename Container::const_iterator;
+        using size_type = typename Container::size_type;
+        using value_type = typename Container::value_type;
+
+        FlatMap() noexcept(noexcept(Container())) : Container{} {
+        }
+
+        explicit FlatMap(const Allocator& alloc) noexcept(noexcept(Container(alloc))) : Container{alloc} {
+        }
+
+        template <class It>
+        FlatMap(It first, It last, const Allocator& alloc = Allocator()) : Container{alloc} {
+            insert(first, last);
+        }
+
+        FlatMap(std::initializer_list<value_type> init, const Allocator& alloc = Allocator()) : Container{alloc} {
+            insert(init.begin(), init.end());
+        }
+
+        template <class K, class V> std::pair<iterator, bool> emplace(K&& key, V&& value) {
+            const auto it = lowerBound(key);
+            if (it != this->end() && !compare(key, it->first)) {
+                return {it, false};
+            }
+            return {insertAt(it, std::forward<K>(key), std::forward<V>(value)), true};
+        }
+
+        T& operator[](const key_type& key) {
+            const auto it = lowerBound(key);
+            if (it != this->end() && !compare(key, it->first)) {
+                return it->second;
+            }
+            return insertAt(it, key, T{})->second;
+        }
+
+        const T& operator[](const key_type& key) const {
+            return at(key);
+        }
+
+        T& at(const key_type& key) {
+            const auto it = find(key);
+            if (it == this->end()) {
+                throw std::out_of_range("key not found");
+            }
+            return it->second;
+        }
+
+        const T& at(const key_type& key) const {
+            const auto it = find(key);
+            if (it == this->end()) {
+                throw std::out_of_range("key not found");
+            }
+            return it->second;
+        }
+
+        size_type erase(const key_type& key) {
+            const auto it = find(key);
+            if (it == this->end()) {
+                return 0;
+            }
+            erase(it);
+            return 1;
+        }
+
+        iterator erase(const_iterator pos) {
+            return Container::erase(pos);
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            return Container::erase(first, last);
+        }
+
+        size_type count(const key_type& key) const {
+            return find(key) == this->end() ? 0 : 1;
+        }
+
+        iterator find(const key_type& key) {
+            const auto it = lowerBound(key);
+            return it != this->end() && !compare(key, it->first) ? it : this->end();
+        }
+
+        const_iterator find(const key_type& key) const {
+            const auto it = lowerBound(key);
+            return it != this->end() && !compare(key, it->first) ? it : this->end();
+        }
+
+        std::pair<iterator, bool> insert(value_type&& value) {
+            return emplace(std::move(value.first), std::move(value.second));
+        }
+
+        std::pair<iterator, bool> insert(const value_type& value) {
+            return emplace(value.first, value.second);
+        }
+
+        template <class InputIt,
+            class = typename std::enable_if<
+                std::is_convertible<typename std::iterator_traits<InputIt>::iterator_category,
+                    std::input_iterator_tag>::value>::type>
+        void insert(InputIt first, InputIt last) {
+            for (auto it = first; it != last; ++it) {
+                insert(*it);
+            }
+        }
+
+    private:
+        template <class K> iterator lowerBound(const K& key) {
+            return std::lower_bound(this->begin(), this->end(), key, [this](const value_type& a, const K& b) {
+                return compare(a.first, b);
+            });
+        }
+
+        template <class K> const_iterator lowerBound(const K& key) const {
+            return std::lower_bound(this->begin(), this->end(), key, [this](const value_type& a, const K& b) {
+                return compare(a.first, b);
+            });
+        }
+
+        template <class K, class V> iterator insertAt(const iterator pos, K&& key, V&& value) {
+            return Container::emplace(pos, std::forward<K>(key), std::forward<V>(value));
+        }
+
+        key_compare compare;
+    };
+
+    // The JSON type with FlatMap objects, dumps exactly like nlohmann::json
+    typedef nlohmann::basic_json<FlatMap> FlatJson;
+} // namespace Doxybook2
@@ -0,0 +1,36 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Doxybook2 {
+    // Runs numbered jobs in worker processes forked from this one.
+    // The workers start as copies of the parent, so they share everything
+    // loaded so far copy-on-write, and only the job numbers and the results
+    // go through the pipes. A worker that crashes takes down only the jobs
+    // it was running, it is replaced by a new one and the jobs are tried
+    // once more, one by one, to find the one responsible.
+    //
+    // The first exception thrown by a job stops handing out new batches
+    // and is rethrown by run() once the running batches are done.
+    //
+    // Only available where fork() is (not on Windows).
+    class ForkPool {
+    public:
+        // Called in the worker, returns the result of the job
+        typedef std::function<std::string(size_t job)> Worker;
+        // Called in the parent with the result, in the order the results arrive
+        typedef std::function<void(size_t job, std::string result)> Callback;
+
+        explicit ForkPool(size_t workers, size_t batchSize);
+
+        static bool isSupported();
+
+        // Runs the jobs 0 to count - 1 and returns the jobs that crashed their worker twice
+        std::vector<size_t> run(size_t count, const Worker& worker, const Callback& callback);
+
+    private:
+        size_t workers;
+        size_t batchSize;
+    };
+} // namespace Doxybook2
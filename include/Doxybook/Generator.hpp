@@ -1,7 +1,13 @@
 #pragma once
+#include "Checkpoint.hpp"
 #include "JsonConverter.hpp"
 #include "Doxygen.hpp"
+#include "Output.hpp"
+#include "Pipeline.hpp"
+#include "Progress.hpp"
 #include "Renderer.hpp"
+#include "Scheduler.hpp"
+#include <mutex>
 #include <string>
 #include <unordered_set>
 
@@ -16,23 +22,86 @@ namespace Doxybook2 {
             Filter skip;
         };
 
+        // A page that went over the render limits (config.renderTimeLimit, config.renderSizeLimit)
+        struct RenderViolation {
+            // Refid of the page, or the name of the index page
+            std::string refid;
+            std::string templateName;
+            std::string reason;
+        };
+
         explicit Generator(const Config& config,
             const Doxygen& doxygen,
             const JsonConverter& jsonConverter,
+            Output& output,
             const std::optional<std::string>& templatesPath);
 
         void print(const Filter& filter, const Filter& skip);
         void json(const Filter& filter, const Filter& skip);
         void manifest();
+        // The index of the names of all symbols (symbols.idx) for "doxybook2 query"
+        void symbolIndex();
         void printIndex(FolderCategory type, const Filter& filter, const Filter& skip);
         void summary(const std::string& inputFile,
             const std::string& outputFile,
             const std::vector<SummarySection>& sections);
 
+        // Pages already recorded in the checkpoint are not rendered again
+        void setCheckpoint(const Checkpoint* checkpoint) {
+            this->checkpoint = checkpoint;
+        }
+
+        // Runs the page pipeline on a scheduler shared with other work,
+        // otherwise each pipeline has threads of its own
+        void setScheduler(Scheduler* scheduler) {
+            this->scheduler = scheduler;
+        }
+
+        // The output the text printers write the images into. The forked workers
+        // (config.renderProcesses) send the hashes of the images they copy back to it.
+        void setHashes(HashingOutput* hashes) {
+            this->hashes = hashes;
+        }
+
+        // Accumulated statistics of the page pipeline of all print and json calls
+        const PipelineStats& getStats() const {
+            return stats;
+        }
+
+        // All of the pages that went over the render limits so far
+        const std::vector<RenderViolation>& getRenderViolations() const {
+            return renderViolations;
+        }
+
     private:
-        void printRecursively(const Node& parent, const Filter& filter, const Filter& skip);
+        // A single page travelling through the pipeline
+        struct Page {
+            const Node* node{nullptr};
+            std::string path;
+            // Empty template name means the page is a JSON dump
+            std::string templateName;
+            nlohmann::json data;
+            std::string contents;
+            // Source code of the file, with config.sourceListing == SourceListing::FILE
+            std::string listing;
+            std::string listingPath;
+            // Went over the render limits and has no placeholder
+            bool skip{false};
+        };
+
+        void run(const std::function<void(std::vector<Page>&)>& producer);
+        // Convert, render and write stages on threads connected by queues
+        PipelineStats runPipeline(std::vector<Page>& pages, Progress& progress);
+        // Convert and render in forked processes (config.renderProcesses), write here
+        PipelineStats runForked(std::vector<Page>& pages, Progress& progress);
+        void convertPage(Page& page) const;
+        void renderPage(Page& page);
+        void writePage(const Page& page);
+        // Moves the source code out of the page data into its own file next to the page
+        void extractListing(Page& page) const;
+        void printRecursively(std::vector<Page>& pages, const Node& parent, const Filter& filter, const Filter& skip);
         nlohmann::json manifestRecursively(const Node& node);
-        void jsonRecursively(const Node& parent, const Filter& filter, const Filter& skip);
+        void jsonRecursively(std::vector<Page>& pages, const Node& parent, const Filter& filter, const Filter& skip);
         std::string kindToTemplateName(Kind kind);
         nlohmann::json buildIndexRecursively(const Node& node, const Filter& filter, const Filter& skip);
         void summaryRecursive(std::stringstream& ss,
@@ -42,10 +111,21 @@ namespace Doxybook2 {
             const Filter& filter,
             const Filter& skip);
         bool shouldInclude(const Node& node);
+        // Records the violation and returns the placeholder contents, empty if the page is skipped
+        std::string renderLimitExceeded(const std::string& refid,
+            const std::string& title,
+            const RenderLimitException& e);
 
         const Config& config;
         const Doxygen& doxygen;
         const JsonConverter& jsonConverter;
+        Output& output;
         Renderer renderer;
+        const Checkpoint* checkpoint{nullptr};
+        Scheduler* scheduler{nullptr};
+        HashingOutput* hashes{nullptr};
+        PipelineStats stats;
+        std::mutex renderViolationsMutex;
+        std::vector<RenderViolation> renderViolations;
     };
 } // namespace Doxybook2
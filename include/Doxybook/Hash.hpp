@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace Doxybook2 {
+    // 64-bit FNV-1a, good enough to detect changed content between two runs
+    class Hash {
+    public:
+        typedef uint64_t Value;
+
+        Hash& update(const char* data, size_t length) {
+            for (size_t i = 0; i < length; i++) {
+                value ^= static_cast<unsigned char>(data[i]);
+                value *= PRIME;
+            }
+            return *this;
+        }
+
+        Hash& update(const std::string& str) {
+            // Include the length so that "ab" + "c" differs from "a" + "bc"
+            update(static_cast<Value>(str.size()));
+            return update(str.data(), str.size());
+        }
+
+        Hash& update(const Value v) {
+            char bytes[sizeof(Value)];
+            for (size_t i = 0; i < sizeof(Value); i++) {
+                bytes[i] = static_cast<char>(v >> (i * 8));
+            }
+            return update(bytes, sizeof(Value));
+        }
+
+        Value get() const {
+            return value;
+        }
+
+        static Value of(const std::string& str) {
+            return Hash().update(str).get();
+        }
+
+        static std::string toHex(Value value);
+
+        // The name with the hash in front of the extension, logo.png => logo.<hash>.png
+        static std::string fileName(const std::string& name, Value value);
+
+    private:
+        static constexpr Value OFFSET = 0xcbf29ce484222325ULL;
+        static constexpr Value PRIME = 0x100000001b3ULL;
+
+        Value value{OFFSET};
+    };
+} // namespace Doxybook2
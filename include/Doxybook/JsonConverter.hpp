@@ -3,6 +3,10 @@
 #include "TextPrinter.hpp"
 #include "Node.hpp"
 #include "Config.hpp"
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 namespace Doxybook2 {
     class JsonConverter {
@@ -23,9 +27,20 @@ namespace Doxybook2 {
         nlohmann::json convert(const Node& node, const Node::Data& data) const;
         nlohmann::json getAsJson(const Node& node) const;
     private:
+        // Converted members (with their data) by refid
+        typedef std::unordered_map<std::string, nlohmann::json> MembersJson;
+
+        nlohmann::json convertMember(const Node& child, const Node::ChildrenData& childrenData) const;
+        // The members of a base class, shared by the pages of all of the derived classes
+        std::shared_ptr<const MembersJson> getMembersJson(const Node& node) const;
+
         const Config& config;
         const Doxygen& doxygen;
         const TextPrinter& plainPrinter;
         const TextPrinter& markdownPrinter;
+
+        // The most recently used first, at most config.inheritedCacheSize
+        mutable std::mutex membersMutex;
+        mutable std::list<std::pair<const Node*, std::shared_ptr<const MembersJson>>> membersCache;
     };
 }
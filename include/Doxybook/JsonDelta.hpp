@@ -0,0 +1,58 @@
+#pragma once
+#include "Hash.hpp"
+#include "Output.hpp"
+#include <map>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+namespace Doxybook2 {
+    // Compares every JSON file written into the output with the same file of the previous
+    // run and writes the changes (delta.json), so that the consumers of the JSON output
+    // do not have to load all of it again:
+    //
+    //   added    - files the previous run did not have
+    //   removed  - files of the previous run that have not been written this time
+    //   modified - changed files, each with an RFC 6902 patch from the previous contents,
+    //              or a null patch if the file has to be loaded again as a whole
+    //
+    // The previous run is known from its hashes.json (config.contentHashes). Unchanged files
+    // are recognized by the hash and are not read, only the changed ones are read from
+    // the output folder before they are overwritten.
+    class JsonDeltaOutput : public Output {
+    public:
+        JsonDeltaOutput(Output& output, std::string previousDir);
+
+        void write(const std::string& path, const std::string& data) override;
+
+        // A file written by the run being resumed, its previous contents are gone.
+        // If it has changed, it is listed as modified without a patch.
+        void add(const std::string& path, Hash::Value hash);
+
+        // False if the previous run has no hashes.json, then everything is added
+        bool hasPrevious() const {
+            return foundPrevious;
+        }
+
+        // Writes the changes (delta.json) into the output
+        void writeDelta();
+
+    private:
+        // The JSON files except for hashes.json and delta.json
+        static bool isCompared(const std::string& path);
+        void changed(const std::string& path, Hash::Value hash, const std::string* data);
+
+        Output& output;
+        std::string previousDir;
+        std::unordered_map<std::string, Hash::Value> previous;
+        bool foundPrevious{false};
+
+        std::mutex mutex;
+        std::set<std::string> written;
+        std::set<std::string> added;
+        // A null patch means the file has to be loaded again as a whole
+        std::map<std::string, nlohmann::json> modified;
+    };
+} // namespace Doxybook2
@@ -0,0 +1,41 @@
+#pragma once
+#include "Config.hpp"
+#include "Enums.hpp"
+#include "Xml.hpp"
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace Doxybook2 {
+    // Decides which entities are loaded at all (config.loadVisibility, config.loadUndocumented,
+    // config.loadExclude, config.loadLanguages). A filtered entity never becomes a node,
+    // so it is not finalized, converted, or rendered, and the links to it are printed as plain text.
+    class LoadFilter {
+    public:
+        explicit LoadFilter(const Config& config);
+
+        // False if nothing is ever filtered out
+        bool isEnabled() const {
+            return enabled;
+        }
+
+        // Classes, namespaces, files, groups, ...
+        bool acceptCompound(const Xml::Element& compounddef, Kind kind, const std::string& name) const;
+
+        // Functions, variables, enums, ... of the compound with the given name
+        bool acceptMember(const Xml::Element& memberdef, Kind parentKind, const std::string& parentName) const;
+
+        // Matches the name and all of its enclosing scopes against the exclude patterns,
+        // so that excluding "*::detail" also excludes "foo::detail::Bar"
+        bool isExcluded(const std::string& qualifiedName) const;
+
+    private:
+        bool acceptVisibility(const Xml::Element& element) const;
+
+        bool enabled{false};
+        int maxVisibility{0};
+        bool undocumented{true};
+        std::vector<std::string> exclude;
+        std::unordered_set<std::string> languages;
+    };
+} // namespace Doxybook2
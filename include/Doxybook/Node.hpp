@@ -1,5 +1,7 @@
 #pragma once
 #include "Enums.hpp"
+#include "Hash.hpp"
+#include "TextStore.hpp"
 #include "Xml.hpp"
 #include <list>
 #include <memory>
@@ -10,6 +12,9 @@
 namespace Doxybook2 {
     class TextPrinter;
     class Node;
+    class NodeCache;
+    class LoadFilter;
+    class XmlSource;
     struct Config;
 
     typedef std::shared_ptr<Node> NodePtr;
@@ -107,11 +112,28 @@ namespace Doxybook2 {
 
         typedef std::unordered_map<std::string, Data> ChildrenData;
 
-        // Parse root xml objects (classes, structs, etc)
-        static NodePtr
-        parse(NodeCacheMap& cache, const std::string& inputDir, const std::string& refid, bool isGroupOrFile);
+        // Members a class inherits from one of its bases, those overridden or hidden
+        // by a class further down the hierarchy are already left out.
+        struct InheritedMembers {
+            const Node* base{nullptr};
+            std::vector<const Node*> members;
+        };
+
+        typedef std::vector<InheritedMembers> Inherited;
+
+        // Parse root xml objects (classes, structs, etc).
+        // Returns nullptr if the compound is filtered out by the filter.
+        static NodePtr parse(NodeCache& cache,
+            const XmlSource& source,
+            const LoadFilter& filter,
+            const std::string& refid,
+            bool isGroupOrFile);
 
-        static NodePtr parse(NodeCacheMap& cache, const std::string& inputDir, const NodePtr& ptr, bool isGroupOrFile);
+        static NodePtr parse(NodeCache& cache,
+            const XmlSource& source,
+            const LoadFilter& filter,
+            const NodePtr& ptr,
+            bool isGroupOrFile);
 
         // Parse member xml objects (functions, enums, etc)
         static NodePtr parse(Xml::Element& memberdef, const std::string& refid);
@@ -139,8 +161,8 @@ namespace Doxybook2 {
             return kind;
         }
 
-        std::string getLanguage() const {
-            return language;
+        const std::string& getLanguage() const {
+            return *language;
         }
 
         Type getType() const {
@@ -168,23 +190,23 @@ namespace Doxybook2 {
         }
 
         const Children& getChildren() const {
-            return children;
+            return compound ? compound->children : noChildren;
         }
 
         const std::string& getXmlPath() const {
-            return xmlPath;
+            return compound ? compound->xmlPath : noString;
         }
 
-        const std::string& getBrief() const {
-            return brief;
+        std::string getBrief() const {
+            return texts ? texts->get(brief) : noString;
         }
 
-        const std::string& getSummary() const {
-            return summary;
+        std::string getSummary() const {
+            return texts ? texts->get(summary) : noString;
         }
 
         const std::string& getTitle() const {
-            return title;
+            return compound ? compound->title : name;
         }
 
         Visibility getVisibility() const {
@@ -196,11 +218,16 @@ namespace Doxybook2 {
         }
 
         const ClassReferences& getBaseClasses() const {
-            return baseClasses;
+            return compound ? compound->baseClasses : noClassReferences;
         }
 
         const ClassReferences& getDerivedClasses() const {
-            return derivedClasses;
+            return compound ? compound->derivedClasses : noClassReferences;
+        }
+
+        // Computed once by Doxygen::finalize(), ordered from the nearest base
+        const Inherited& getInheritedMembers() const {
+            return compound ? compound->inherited : noInherited;
         }
 
         const std::string& getUrl() const {
@@ -211,10 +238,22 @@ namespace Doxybook2 {
             return anchor;
         }
 
+        // Hash of the normalized documentation of this node only
+        Hash::Value getContentHash() const {
+            return contentHash;
+        }
+
+        // Hash of this node combined with the hashes of all children (Merkle tree).
+        // If it did not change between two runs, nothing below this node changed.
+        Hash::Value getHash() const {
+            return hash;
+        }
+
         void finalize(const Config& config,
             const TextPrinter& plainPrinter,
             const TextPrinter& markdownPrinter,
-            const NodeCacheMap& cache);
+            const NodeCacheMap& cache,
+            TextStore& texts);
         typedef std::tuple<Data, ChildrenData> LoadDataResult;
         LoadDataResult loadData(const Config& config,
             const TextPrinter& plainPrinter,
@@ -225,6 +264,34 @@ namespace Doxybook2 {
 
       private:
         class Temp;
+
+        // Fields only used by compounds (classes, files, groups, ...) and enums.
+        // Kept out of line so that the far more numerous members stay small.
+        struct Compound {
+            Children children;
+            std::string title;
+            std::string xmlPath;
+            // Where the xml is loaded from again by loadData()
+            const XmlSource* source{nullptr};
+            ClassReferences baseClasses;
+            ClassReferences derivedClasses;
+            Inherited inherited;
+        };
+
+        static const Children noChildren;
+        static const ClassReferences noClassReferences;
+        static const Inherited noInherited;
+        static const std::string noString;
+
+        // Returns the compound fields, allocating them on the first use
+        Compound& getCompound();
+        // Returns a shared copy of the language string, there are only a handful of them
+        static const std::string* internLanguage(const std::string& language);
+        // Frees the parsed brief kept until finalize(), for nodes restored already finalized
+        void releaseTemp();
+        // Refids of the members this member overrides, only known until finalize()
+        const std::vector<std::string>& getReimplements() const;
+
         Data loadData(const Config& config,
             const TextPrinter& plainPrinter,
             const TextPrinter& markdownPrinter,
@@ -235,28 +302,27 @@ namespace Doxybook2 {
         std::unique_ptr<Temp> temp;
         Kind kind{Kind::INDEX};
         Type type{Type::NONE};
-        std::string language;
+        const std::string* language{&noString};
         std::string refid;
         std::string name;
-        std::string brief;
-        std::string summary;
-        std::string title;
+        // Where the brief and the summary are kept, owned by Doxygen
+        const TextStore* texts{nullptr};
+        TextStore::Id brief{TextStore::EMPTY};
+        TextStore::Id summary{TextStore::EMPTY};
         Node* parent{nullptr};
         Node* group{nullptr};
-        Children children;
+        std::unique_ptr<Compound> compound;
         bool empty{true};
-        std::string xmlPath;
-        ClassReferences baseClasses;
-        ClassReferences derivedClasses;
         Visibility visibility{Visibility::PUBLIC};
         Virtual virt{Virtual::NON_VIRTUAL};
         std::string url;
         std::string anchor;
+        Hash::Value contentHash{0};
+        Hash::Value hash{0};
 
         void parseBaseInfo(const Xml::Element& element);
         void parseInheritanceInfo(const Xml::Element& element);
         NodePtr findRecursively(const std::string& refid) const;
         static Xml::Element assertChild(const Xml::Element& xml, const std::string& name);
-        static Xml::Element assertChild(const Xml& xml, const std::string& name);
     };
 } // namespace Doxybook2
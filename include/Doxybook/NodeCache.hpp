@@ -0,0 +1,47 @@
+#pragma once
+#include "Node.hpp"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+namespace Doxybook2 {
+    // Thread safe refid -> node map used while the XML files are loaded.
+    // The refids are spread over shards, each shard has its own lock,
+    // so the workers parsing different compounds rarely wait for each other.
+    class NodeCache {
+    public:
+        explicit NodeCache(size_t numOfShards = 64);
+
+        NodePtr find(const std::string& refid) const;
+
+        // Inserts the node only if the refid is not in the cache yet.
+        // Returns the node stored in the cache afterwards. If two workers
+        // race to create the same node, both get the same winner.
+        NodePtr insert(const NodePtr& node);
+
+        size_t size() const;
+
+        // Remembers the compounds filtered out by the LoadFilter, so that
+        // the other compounds referring to them do not load them again
+        void reject(const std::string& refid);
+        bool isRejected(const std::string& refid) const;
+
+        // Moves all of the nodes into a map tuned for read-only lookups,
+        // the cache is empty afterwards.
+        NodeCacheMap freeze();
+
+    private:
+        struct Shard {
+            mutable std::mutex mutex;
+            NodeCacheMap map;
+        };
+
+        Shard& getShard(const std::string& refid) const;
+
+        size_t numOfShards;
+        std::unique_ptr<Shard[]> shards;
+        mutable std::mutex rejectedMutex;
+        std::unordered_set<std::string> rejected;
+    };
+} // namespace Doxybook2
@@ -0,0 +1,101 @@
+#pragma once
+#include "Hash.hpp"
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace Doxybook2 {
+    // Destination of all generated files (pages, JSON, manifest, images).
+    // Paths are always relative to the output root.
+    class Output {
+    public:
+        virtual ~Output() = default;
+
+        virtual void write(const std::string& path, const std::string& data) = 0;
+    };
+
+    // Writes the files into a folder on the disk.
+    // Subfolders (such as the folder shards) are created on the first write into them.
+    class FileOutput : public Output {
+    public:
+        explicit FileOutput(std::string outputDir);
+
+        void write(const std::string& path, const std::string& data) override;
+
+        const std::string& getOutputDir() const {
+            return outputDir;
+        }
+
+    private:
+        void createParentDirectory(const std::string& path);
+
+        std::string outputDir;
+        std::mutex mutex;
+        // Subfolders known to exist, so that each is checked only once
+        std::unordered_set<std::string> directories;
+    };
+
+    // Keeps all of the files in memory, nothing touches the disk
+    class MemoryOutput : public Output {
+    public:
+        typedef std::map<std::string, std::string> Files;
+
+        void write(const std::string& path, const std::string& data) override;
+
+        const Files& getFiles() const {
+            return files;
+        }
+
+        const std::string& get(const std::string& path) const;
+
+        bool contains(const std::string& path) const;
+
+    private:
+        mutable std::mutex mutex;
+        Files files;
+    };
+
+    // Hands over each file to the user, for example to put it into an archive
+    class CallbackOutput : public Output {
+    public:
+        typedef std::function<void(const std::string& path, const std::string& data)> Callback;
+
+        explicit CallbackOutput(Callback callback);
+
+        void write(const std::string& path, const std::string& data) override;
+
+    private:
+        Callback callback;
+    };
+
+    // Hashes every file on its way into the output, so that the hashes of the contents
+    // can be published (hashes.json) and the unchanged files stay cached by a CDN
+    class HashingOutput : public Output {
+    public:
+        typedef std::pair<std::string, Hash::Value> Entry;
+
+        explicit HashingOutput(Output& output);
+
+        void write(const std::string& path, const std::string& data) override;
+
+        // A file written somewhere else, by a forked worker or by the run being resumed
+        void add(const std::string& path, Hash::Value hash);
+
+        // Number of files hashed so far, to get the ones hashed after it with getSince()
+        size_t getCount() const;
+
+        std::vector<Entry> getSince(size_t count) const;
+
+        // Writes the path and the hash of every file (not itself) sorted by the path
+        void writeHashes(const std::string& path = "hashes.json");
+
+    private:
+        Output& output;
+        mutable std::mutex mutex;
+        // In the order they are written, a file written twice keeps the last hash
+        std::vector<Entry> entries;
+    };
+} // namespace Doxybook2
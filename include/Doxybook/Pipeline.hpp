@@ -0,0 +1,247 @@
+#pragma once
+#include "Scheduler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Doxybook2 {
+    struct PipelineStageStats {
+        std::string name;
+        // The most items processed by this stage at once
+        size_t threads{0};
+        // How many items went through this stage
+        size_t processed{0};
+        // The highest number of items waiting in front of this stage.
+        // A stage that keeps its queue full is the bottleneck.
+        size_t maxQueueDepth{0};
+        // Time spent inside of the stage callback, summed over all threads
+        double busySeconds{0.0};
+    };
+
+    typedef std::vector<PipelineStageStats> PipelineStats;
+
+    // Chain of stages connected by bounded queues, running as tasks of a Scheduler.
+    // Each stage processes up to `threads` items at once, so the I/O bound and
+    // the CPU bound stages overlap. If the queue in front of a stage is full,
+    // the previous stage stops taking items (without blocking a scheduler thread)
+    // and the producer calling push waits.
+    //
+    // The first exception thrown by any stage cancels the whole pipeline
+    // and is rethrown by push() or finish().
+    template <typename T> class Pipeline {
+    public:
+        typedef std::function<void(T&)> Callback;
+
+        // Without a scheduler, the pipeline creates its own one with as many
+        // threads as all of the stages together
+        explicit Pipeline(const size_t queueSize, Scheduler* scheduler = nullptr)
+            : queueSize(std::max<size_t>(queueSize, 1)), scheduler(scheduler) {
+        }
+
+        ~Pipeline() {
+            cancel();
+            waitTasks();
+        }
+
+        Pipeline(const Pipeline& other) = delete;
+        Pipeline& operator=(const Pipeline& other) = delete;
+
+        // Stages must be added before the first push
+        void addStage(std::string name,
+            const size_t threads,
+            Callback callback,
+            const Scheduler::Priority priority = Scheduler::Priority::NORMAL) {
+            stages.push_back(std::make_unique<Stage>());
+            auto& stage = *stages.back();
+            stage.stats.name = std::move(name);
+            stage.stats.threads = std::max<size_t>(threads, 1);
+            stage.callback = std::move(callback);
+            stage.priority = priority;
+        }
+
+        void push(T item) {
+            start();
+            std::unique_lock<std::mutex> lock(mutex);
+            notFull.wait(lock, [&] { return cancelled || stages.front()->queue.size() < queueSize; });
+            if (cancelled) {
+                lock.unlock();
+                rethrow();
+                return;
+            }
+            inFlight++;
+            enqueue(0, std::move(item));
+        }
+
+        // Waits until all of the pushed items went through all of the stages
+        PipelineStats finish() {
+            start();
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                finished.wait(lock, [&] { return cancelled || inFlight == 0; });
+            }
+            waitTasks();
+            rethrow();
+
+            PipelineStats stats;
+            for (const auto& stage : stages) {
+                stats.push_back(stage->stats);
+            }
+            return stats;
+        }
+
+    private:
+        struct Stage {
+            PipelineStageStats stats;
+            Callback callback;
+            Scheduler::Priority priority{Scheduler::Priority::NORMAL};
+            Scheduler::GroupPtr group;
+            std::deque<T> queue;
+            // Slots of the queue taken by the items the previous stage is processing
+            size_t reserved{0};
+            // Tasks that found the queue of the next stage full, resumed once it has room
+            size_t stalled{0};
+        };
+
+        void start() {
+            if (started) {
+                return;
+            }
+            started = true;
+            if (scheduler == nullptr) {
+                size_t threads = 0;
+                for (const auto& stage : stages) {
+                    threads += stage->stats.threads;
+                }
+                ownScheduler = std::make_unique<Scheduler>(threads);
+                scheduler = ownScheduler.get();
+            }
+            for (auto& stage : stages) {
+                stage->group = scheduler->createGroup(stage->stats.name, stage->stats.threads, stage->priority);
+            }
+        }
+
+        // Called with the mutex locked, one task per item
+        void enqueue(const size_t index, T&& item) {
+            auto& stage = *stages[index];
+            stage.queue.push_back(std::move(item));
+            stage.stats.maxQueueDepth = std::max(stage.stats.maxQueueDepth, stage.queue.size());
+            submit(index);
+        }
+
+        void submit(const size_t index) {
+            scheduler->submit(stages[index]->group, [this, index]() { process(index); });
+        }
+
+        void process(const size_t index) {
+            auto& stage = *stages[index];
+            const auto last = index + 1 == stages.size();
+
+            std::unique_lock<std::mutex> lock(mutex);
+            if (cancelled || stage.queue.empty()) {
+                return;
+            }
+            if (!last) {
+                auto& next = *stages[index + 1];
+                if (next.queue.size() + next.reserved >= queueSize) {
+                    stage.stalled++;
+                    return;
+                }
+                next.reserved++;
+            }
+            auto item = std::move(stage.queue.front());
+            stage.queue.pop_front();
+
+            // There is room in front of this stage now
+            if (index == 0) {
+                notFull.notify_one();
+            } else if (stages[index - 1]->stalled > 0) {
+                stages[index - 1]->stalled--;
+                submit(index - 1);
+            }
+            lock.unlock();
+
+            const auto t0 = std::chrono::steady_clock::now();
+            try {
+                stage.callback(item);
+            } catch (...) {
+                fail(std::current_exception());
+                return;
+            }
+            const std::chrono::duration<double> busy = std::chrono::steady_clock::now() - t0;
+
+            lock.lock();
+            stage.stats.processed++;
+            stage.stats.busySeconds += busy.count();
+            if (!last) {
+                stages[index + 1]->reserved--;
+                enqueue(index + 1, std::move(item));
+            } else if (--inFlight == 0) {
+                finished.notify_all();
+            }
+        }
+
+        void fail(std::exception_ptr e) {
+            {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) {
+                    error = std::move(e);
+                }
+            }
+            cancel();
+        }
+
+        void cancel() {
+            {
+                // Locked so that no waiting thread misses the notification
+                std::lock_guard<std::mutex> lock(mutex);
+                cancelled = true;
+            }
+            notFull.notify_all();
+            finished.notify_all();
+            for (auto& stage : stages) {
+                if (stage->group) {
+                    scheduler->cancel(stage->group);
+                }
+            }
+        }
+
+        // The tasks refer to this pipeline, none of them may outlive it
+        void waitTasks() {
+            for (auto& stage : stages) {
+                if (stage->group) {
+                    scheduler->wait(stage->group);
+                }
+            }
+        }
+
+        void rethrow() {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        const size_t queueSize;
+        Scheduler* scheduler;
+        std::unique_ptr<Scheduler> ownScheduler;
+        std::vector<std::unique_ptr<Stage>> stages;
+        bool started{false};
+
+        std::mutex mutex;
+        std::condition_variable notFull;
+        std::condition_variable finished;
+        bool cancelled{false};
+        // Pushed and not through the last stage yet
+        size_t inFlight{0};
+
+        std::mutex errorMutex;
+        std::exception_ptr error;
+    };
+} // namespace Doxybook2
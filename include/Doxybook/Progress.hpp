@@ -0,0 +1,56 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+namespace Doxybook2 {
+    // Counts the items processed by one phase (load, finalize, render) and
+    // reports them at most once per second as a single aggregated line with
+    // the rate and the estimated time left, instead of a line per file.
+    //
+    // Safe to use from multiple threads.
+    class Progress {
+      public:
+        // The total may be zero if it is not known yet, see addTotal()
+        explicit Progress(std::string phase, size_t total = 0);
+        ~Progress();
+
+        Progress(const Progress& other) = delete;
+        Progress& operator=(const Progress& other) = delete;
+
+        void addTotal(size_t count);
+        void increment(size_t count = 1);
+        // Sets the number of processed items, for phases that count them elsewhere
+        void set(size_t done);
+        // Reports the final numbers, called by the destructor if not called before
+        void finish();
+
+        size_t getDone() const {
+            return done;
+        }
+
+        size_t getTotal() const {
+            return total;
+        }
+
+        // Where to write the machine readable progress events, one json object per line.
+        // Disabled if null (the default).
+        static void setJsonStream(std::ostream* stream);
+
+      private:
+        enum class Event { START, PROGRESS, DONE };
+
+        void maybeReport();
+        void report(Event event);
+
+        std::string phase;
+        std::atomic<size_t> total;
+        std::atomic<size_t> done{0};
+        std::chrono::steady_clock::time_point start;
+        // Nanoseconds since the start of the last report
+        std::atomic<long long> lastReport{0};
+        std::atomic<bool> finished{false};
+    };
+} // namespace Doxybook2
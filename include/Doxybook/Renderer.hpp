@@ -2,6 +2,8 @@
 #include "Config.hpp"
 #include "JsonConverter.hpp"
 #include "Doxygen.hpp"
+#include "Exception.hpp"
+#include "Output.hpp"
 #include <memory>
 #include <nlohmann/json.hpp>
 #include <optional>
@@ -14,9 +16,34 @@ namespace inja {
 } // namespace inja
 
 namespace Doxybook2 {
+    // Thrown when a page goes over the config.renderTimeLimit or config.renderSizeLimit
+    class RenderLimitException : public Exception {
+    public:
+        RenderLimitException(std::string templateName, std::string reason)
+            : Exception("Template '" + templateName + "' " + reason), templateName(std::move(templateName)),
+              reason(std::move(reason)) {
+        }
+
+        const std::string& getTemplateName() const {
+            return templateName;
+        }
+
+        const std::string& getReason() const {
+            return reason;
+        }
+
+    private:
+        std::string templateName;
+        std::string reason;
+    };
+
     class Renderer {
     public:
-        explicit Renderer(const Config& config, const Doxygen& doxygen, const JsonConverter& jsonConverter, const std::optional<std::string>& templatesPath = std::nullopt);
+        explicit Renderer(const Config& config,
+            const Doxygen& doxygen,
+            const JsonConverter& jsonConverter,
+            Output& output,
+            const std::optional<std::string>& templatesPath = std::nullopt);
         ~Renderer();
 
         void render(const std::string& name, const std::string& path, const nlohmann::json& data) const;
@@ -26,6 +53,7 @@ namespace Doxybook2 {
         const Config& config;
         const Doxygen& doxygen;
         const JsonConverter& jsonConverter;
+        Output& output;
 
         std::unique_ptr<inja::Environment> env;
         std::unordered_map<std::string, std::unique_ptr<inja::Template>> templates;
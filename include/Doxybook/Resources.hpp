@@ -0,0 +1,37 @@
+#pragma once
+#include "Config.hpp"
+#include <cstdint>
+#include <string>
+
+namespace Doxybook2 {
+    // The CPU and memory limits of the cgroup (v2) this process runs in. Inside of a container
+    // the number of cores of the machine oversubscribes the CPU quota, and the default caches
+    // can get the process killed once it reaches the memory limit.
+    class Resources {
+    public:
+        struct Limits {
+            // How many CPUs the quota is worth, 0 => no limit
+            double cpus{0.0};
+            // In bytes, 0 => no limit
+            uint64_t memory{0};
+        };
+
+        // Reads the limits of the cgroup of this process (/proc/self/cgroup)
+        static Limits read();
+
+        // Reads the limits of the cgroup at the path relative to the root of the cgroup2 hierarchy,
+        // the lowest of the cgroup and all of its parents
+        static Limits read(const std::string& root, const std::string& cgroup);
+
+        // Parses the contents of cpu.max ("max 100000" or "<quota> <period>")
+        // and memory.max ("max" or the bytes)
+        static Limits parse(const std::string& cpuMax, const std::string& memoryMax);
+
+        // Changes the defaults of the worker threads, the cache sizes, and the low memory mode
+        // to fit the limits. Call it before the config is loaded, so the config takes precedence.
+        static void tune(Config& config, const Limits& limits);
+
+        // For the log, "1.5 CPUs, 512 MiB of memory"
+        static std::string describe(const Limits& limits);
+    };
+} // namespace Doxybook2
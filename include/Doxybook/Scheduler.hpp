@@ -0,0 +1,119 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Doxybook2 {
+    // Runs the tasks of all of the stages (converting, rendering, writing, ...)
+    // on one set of threads, so that the stages together do not use more
+    // threads than there are cores.
+    //
+    // Each thread has its own deques of tasks, one per priority. A task submitted
+    // by a task goes to the deque of its thread and is taken from the back,
+    // while its data is still in the cache. Idle threads steal from the front
+    // of the deques of the others. Tasks submitted from the outside go to a
+    // shared queue. A task of a higher priority is always taken first.
+    //
+    // Every task belongs to a group. The group caps how many of its tasks run
+    // at once, and is cancelled by the first exception thrown by one of its
+    // tasks: the tasks that have not started yet are dropped, and wait()
+    // rethrows the exception.
+    class Scheduler {
+    public:
+        enum class Priority { HIGH = 0, NORMAL = 1, LOW = 2 };
+
+        typedef std::function<void()> Task;
+
+        class Group;
+        typedef std::shared_ptr<Group> GroupPtr;
+
+        // Zero threads means one per core.
+        // With pinThreads, each thread stays on one core (Linux only).
+        explicit Scheduler(size_t threads = 0, bool pinThreads = false);
+        // Runs the tasks already submitted, then stops the threads
+        ~Scheduler();
+
+        Scheduler(const Scheduler& other) = delete;
+        Scheduler& operator=(const Scheduler& other) = delete;
+
+        // Zero maxConcurrency means no limit
+        GroupPtr createGroup(std::string name, size_t maxConcurrency = 0, Priority priority = Priority::NORMAL);
+
+        void submit(const GroupPtr& group, Task task);
+
+        // Waits until all of the tasks of the group are done or dropped, and rethrows
+        // the first exception thrown by them. Called from a task, it runs other tasks
+        // in the meantime instead of blocking the thread.
+        void wait(const GroupPtr& group);
+
+        // Drops the tasks of the group that have not started yet
+        void cancel(const GroupPtr& group);
+
+        size_t getThreads() const {
+            return workers.size();
+        }
+
+    private:
+        struct Entry {
+            GroupPtr group;
+            Task task;
+        };
+
+        static constexpr size_t PRIORITIES = 3;
+
+        struct Worker {
+            std::mutex mutex;
+            std::deque<Entry> queues[PRIORITIES];
+            std::thread thread;
+        };
+
+        void workerMain(size_t index, bool pin);
+        // Takes the next task: own deque, then the shared queue, then the other threads
+        bool take(size_t index, Entry& entry);
+        void execute(Entry& entry);
+        void push(Entry entry);
+        // Index of the worker of this scheduler running on the calling thread, or -1
+        size_t currentWorker() const;
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        std::mutex sharedMutex;
+        std::deque<Entry> shared[PRIORITIES];
+
+        // Queued tasks, may be off by one for a moment while a task is being pushed
+        std::atomic<long> queued{0};
+        std::mutex sleepMutex;
+        std::condition_variable wake;
+        bool stopping{false};
+    };
+
+    class Scheduler::Group {
+    public:
+        const std::string& getName() const {
+            return name;
+        }
+
+    private:
+        friend class Scheduler;
+
+        std::string name;
+        size_t maxConcurrency{0};
+        Priority priority{Priority::NORMAL};
+
+        std::mutex mutex;
+        std::condition_variable done;
+        // Submitted and not finished yet, including the deferred ones
+        size_t pending{0};
+        size_t running{0};
+        // Taken while the group was at its limit, put back once one of its tasks finishes
+        std::deque<Task> deferred;
+        bool cancelled{false};
+        std::exception_ptr error;
+    };
+} // namespace Doxybook2
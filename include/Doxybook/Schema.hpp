@@ -0,0 +1,266 @@
+#pragma once
+#include "Node.hpp"
+#include <cstdint>
+#include <functional>
+#include <nlohmann/json.hpp>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace Doxybook2 {
+    // Compile-time description of the fields of the Node structures.
+    // Every output format (JSON, streaming JSON, CBOR) is generated by
+    // visiting the same table, so a new field is added only once.
+    namespace Schema {
+        // Presence policies, decide whether a field is written at all
+        struct Always {
+            template <typename T> constexpr bool operator()(const T&) const {
+                return true;
+            }
+        };
+
+        struct NotEmpty {
+            template <typename T> bool operator()(const T& value) const {
+                return !value.empty();
+            }
+        };
+
+        struct Positive {
+            template <typename T> bool operator()(const T& value) const {
+                return value > 0;
+            }
+        };
+
+        // The accessor is either a pointer to a data member, a pointer
+        // to a const member function, or a callable taking the object.
+        template <typename Accessor, typename Presence> struct Field {
+            const char* name;
+            Accessor accessor;
+            Presence present;
+        };
+
+        template <typename Accessor, typename Presence = Always>
+        constexpr Field<Accessor, Presence> field(const char* name, Accessor accessor, Presence presence = Presence{}) {
+            return {name, accessor, presence};
+        }
+
+        // Specialized below for each described type, holds a tuple of fields as "value"
+        template <typename T> struct Fields {};
+
+        template <typename T, typename = void> struct HasFields : std::false_type {};
+        template <typename T> struct HasFields<T, std::void_t<decltype(Fields<T>::value)>> : std::true_type {};
+
+        template <typename T> struct IsVector : std::false_type {};
+        template <typename T, typename A> struct IsVector<std::vector<T, A>> : std::true_type {};
+
+        // Calls visitor(name, value) for every present field of the object
+        template <typename T, typename Visitor> void visit(const T& object, Visitor&& visitor) {
+            std::apply(
+                [&](const auto&... fields) {
+                    (
+                        [&](const auto& field) {
+                            const auto& value = std::invoke(field.accessor, object);
+                            if (field.present(value)) {
+                                visitor(field.name, value);
+                            }
+                        }(fields),
+                        ...);
+                },
+                Fields<T>::value);
+        }
+
+        template <typename T> nlohmann::json toJson(const T& value) {
+            if constexpr (HasFields<T>::value) {
+                nlohmann::json json = nlohmann::json::object();
+                visit(value, [&](const char* name, const auto& v) { json[name] = toJson(v); });
+                return json;
+            } else if constexpr (IsVector<T>::value) {
+                nlohmann::json json = nlohmann::json::array();
+                for (const auto& item : value) {
+                    json.push_back(toJson(item));
+                }
+                return json;
+            } else if constexpr (std::is_enum_v<T>) {
+                return toStr(value);
+            } else {
+                return value;
+            }
+        }
+
+        // Drives a writer with beginObject, key, endObject, beginArray, endArray
+        // and value(string/bool/int) functions
+        template <typename Writer, typename T> void write(Writer& writer, const T& value) {
+            if constexpr (HasFields<T>::value) {
+                writer.beginObject();
+                visit(value, [&](const char* name, const auto& v) {
+                    writer.key(name);
+                    write(writer, v);
+                });
+                writer.endObject();
+            } else if constexpr (IsVector<T>::value) {
+                writer.beginArray();
+                for (const auto& item : value) {
+                    write(writer, item);
+                }
+                writer.endArray();
+            } else if constexpr (std::is_enum_v<T>) {
+                writer.value(toStr(value));
+            } else {
+                writer.value(value);
+            }
+        }
+
+        // Writes JSON text directly into a stream without building nlohmann::json first
+        class StreamWriter {
+        public:
+            explicit StreamWriter(std::ostream& out);
+
+            void beginObject();
+            void endObject();
+            void beginArray();
+            void endArray();
+            void key(const std::string& name);
+            void value(const std::string& str);
+            void value(bool b);
+            void value(int i);
+
+        private:
+            void separator();
+            void string(const std::string& str);
+
+            std::ostream& out;
+            std::vector<bool> first;
+            bool afterKey{false};
+        };
+
+        // Writes CBOR (RFC 7049) into a byte buffer, containers use indefinite length
+        class CborWriter {
+        public:
+            explicit CborWriter(std::string& out);
+
+            void beginObject();
+            void endObject();
+            void beginArray();
+            void endArray();
+            void key(const std::string& name);
+            void value(const std::string& str);
+            void value(bool b);
+            void value(int i);
+
+        private:
+            void head(uint8_t major, uint64_t length);
+
+            std::string& out;
+        };
+
+        template <> struct Fields<Node::Location> {
+            static inline const auto value = std::make_tuple(field("file", &Node::Location::file),
+                field("line", &Node::Location::line),
+                field("column", &Node::Location::column),
+                field("bodyStart", &Node::Location::bodyStart, Positive{}),
+                field("bodyEnd", &Node::Location::bodyEnd, Positive{}),
+                field("bodyFile", &Node::Location::bodyFile, NotEmpty{}));
+        };
+
+        template <> struct Fields<Node::Param> {
+            static inline const auto value = std::make_tuple(field("type", &Node::Param::type),
+                field("typePlain", &Node::Param::typePlain),
+                field("name", &Node::Param::name),
+                field("defval", &Node::Param::defval, NotEmpty{}),
+                field("defvalPlain", &Node::Param::defvalPlain, NotEmpty{}));
+        };
+
+        template <> struct Fields<Node::ParameterListItem> {
+            static inline const auto value = std::make_tuple(
+                field("name", &Node::ParameterListItem::name), field("text", &Node::ParameterListItem::text));
+        };
+
+        template <> struct Fields<Node::ClassReference> {
+            static inline const auto value = std::make_tuple(field("refid", &Node::ClassReference::refid, NotEmpty{}),
+                field("name", &Node::ClassReference::name),
+                field("visibility", &Node::ClassReference::prot),
+                field("virtual", &Node::ClassReference::virt),
+                field("external", [](const Node::ClassReference& klass) { return klass.ptr == nullptr; }),
+                field(
+                    "url",
+                    [](const Node::ClassReference& klass) { return klass.ptr ? klass.ptr->getUrl() : std::string(); },
+                    NotEmpty{}));
+        };
+
+        // Only the fields that do not depend on the context,
+        // the JsonConverter adds the rest (fullname, function specific fields, etc.)
+        template <> struct Fields<Node> {
+            static inline const auto value = std::make_tuple(field("refid", &Node::getRefid),
+                field("name", &Node::getName),
+                field("title", &Node::getTitle),
+                field("brief", &Node::getBrief, NotEmpty{}),
+                field("summary", &Node::getSummary, NotEmpty{}),
+                field("url", &Node::getUrl),
+                field("anchor", &Node::getAnchor),
+                field("visibility", &Node::getVisibility),
+                field("kind", &Node::getKind),
+                field("language", &Node::getLanguage),
+                field("category", &Node::getType),
+                field("baseClasses", &Node::getBaseClasses, NotEmpty{}),
+                field("derivedClasses", &Node::getDerivedClasses, NotEmpty{}));
+        };
+
+        template <> struct Fields<Node::Data> {
+            static bool hasDetails(const Node::Data& data) {
+                return !data.details.empty() || !data.templateParams.empty() || !data.inbody.empty() ||
+                       !data.returnsList.empty() || !data.exceptionsList.empty() || !data.templateParamsList.empty() ||
+                       !data.paramList.empty() || !data.see.empty() || !data.returns.empty() || !data.bugs.empty() ||
+                       !data.tests.empty() || !data.todos.empty() || !data.authors.empty() || !data.version.empty() ||
+                       !data.since.empty() || !data.date.empty() || !data.note.empty() || !data.warning.empty() ||
+                       !data.pre.empty() || !data.post.empty() || !data.copyright.empty() ||
+                       !data.invariant.empty() || !data.remark.empty() || !data.attention.empty() ||
+                       !data.par.empty() || !data.rcs.empty() || !data.deprecated.empty();
+            }
+
+            static inline const auto value = std::make_tuple(field("details", &Node::Data::details, NotEmpty{}),
+                field("inbody", &Node::Data::inbody, NotEmpty{}),
+                field("includes", &Node::Data::includes, NotEmpty{}),
+                field("type", &Node::Data::type, NotEmpty{}),
+                field("definition", &Node::Data::definition),
+                field("initializer", &Node::Data::initializer, NotEmpty{}),
+                field("typePlain", &Node::Data::typePlain, NotEmpty{}),
+                field("see", &Node::Data::see, NotEmpty{}),
+                field("returns", &Node::Data::returns, NotEmpty{}),
+                field("authors", &Node::Data::authors, NotEmpty{}),
+                field("version", &Node::Data::version, NotEmpty{}),
+                field("since", &Node::Data::since, NotEmpty{}),
+                field("date", &Node::Data::date, NotEmpty{}),
+                field("note", &Node::Data::note, NotEmpty{}),
+                field("warning", &Node::Data::warning, NotEmpty{}),
+                field("pre", &Node::Data::pre, NotEmpty{}),
+                field("post", &Node::Data::post, NotEmpty{}),
+                field("copyright", &Node::Data::copyright, NotEmpty{}),
+                field("invariant", &Node::Data::invariant, NotEmpty{}),
+                field("remark", &Node::Data::remark, NotEmpty{}),
+                field("attention", &Node::Data::attention, NotEmpty{}),
+                field("par", &Node::Data::par, NotEmpty{}),
+                field("rcs", &Node::Data::rcs, NotEmpty{}),
+                field("todos", &Node::Data::todos, NotEmpty{}),
+                field("bugs", &Node::Data::bugs, NotEmpty{}),
+                field("tests", &Node::Data::tests, NotEmpty{}),
+                field("deprecated", &Node::Data::deprecated, NotEmpty{}),
+                field("static", &Node::Data::isStatic),
+                field("abstract", &Node::Data::isAbstract),
+                field("const", &Node::Data::isConst),
+                field("explicit", &Node::Data::isExplicit),
+                field("strong", &Node::Data::isStrong),
+                field("inline", &Node::Data::isInline),
+                field("override", &Node::Data::isOverride),
+                field("templateParams", &Node::Data::templateParams, NotEmpty{}),
+                field("programlisting", &Node::Data::programlisting, NotEmpty{}),
+                field("location", &Node::Data::location, [](const Node::Location& l) { return !l.file.empty(); }),
+                field("returnsList", &Node::Data::returnsList, NotEmpty{}),
+                field("exceptionsList", &Node::Data::exceptionsList, NotEmpty{}),
+                field("templateParamsList", &Node::Data::templateParamsList, NotEmpty{}),
+                field("paramList", &Node::Data::paramList, NotEmpty{}),
+                field("hasDetails", &Fields<Node::Data>::hasDetails));
+        };
+    } // namespace Schema
+} // namespace Doxybook2
@@ -0,0 +1,85 @@
+#pragma once
+#include "Node.hpp"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Doxybook2 {
+    // Compact index of the names of all nodes (symbols.idx), written along with the pages
+    // (config.symbolIndex) and searched by "doxybook2 query" without loading the model.
+    // The file is mapped into memory and searched in place, so opening it takes the same
+    // time no matter how large the project is. It consists of:
+    //
+    //   header   - magic, the number of items and the offset of each table below
+    //   symbols  - fixed size records, the strings as offsets, the parent, and the children
+    //   keys     - the full name, the name and the title of every symbol, sorted
+    //   trigrams - sorted trigrams of the lowercase full names, each with its symbols
+    //   strings  - all of the strings, each stored only once
+    //
+    // Written in the byte order of the machine, an index from another one is rejected.
+    class SymbolIndex {
+    public:
+        typedef uint32_t Id;
+        static constexpr Id NONE = 0xffffffff;
+
+        struct Symbol {
+            Id id{NONE};
+            // Qualified by the class or the namespace, for example ns::Foo::bar
+            std::string_view fullname;
+            std::string_view name;
+            std::string_view title;
+            std::string_view kind;
+            std::string_view refid;
+            std::string_view url;
+            std::string_view brief;
+            Id parent{NONE};
+        };
+
+        struct Match {
+            Symbol symbol;
+            // Share of the trigrams of the query and the full name that are common to both
+            double score{1.0};
+        };
+
+        // Serializes the nodes below the index, leaving out those the filter returns false for
+        static std::string build(const Node& index, const std::function<bool(const Node&)>& filter = nullptr);
+
+        explicit SymbolIndex(const std::string& path);
+        ~SymbolIndex();
+        SymbolIndex(const SymbolIndex& other) = delete;
+        SymbolIndex& operator=(const SymbolIndex& other) = delete;
+
+        size_t size() const;
+
+        Symbol get(Id id) const;
+
+        // For example the members of a group or a class
+        std::vector<Symbol> getChildren(Id id) const;
+
+        // The symbols whose full name, name, or title is equal to the name
+        std::vector<Symbol> findExact(const std::string& name) const;
+
+        // The symbols whose full name, name, or title starts with the prefix, sorted by it. 0 => no limit.
+        std::vector<Symbol> findPrefix(const std::string& prefix, size_t limit) const;
+
+        // The symbols whose full name is similar to the query, the most similar first. 0 => no limit.
+        std::vector<Match> findFuzzy(const std::string& query, size_t limit, double minScore = 0.3) const;
+
+    private:
+        // The symbols by the sorted keys equal to or starting with the prefix
+        std::vector<Symbol> findKeys(const std::string& prefix, bool exact, size_t limit) const;
+        bool isValid() const;
+        void release();
+        template <typename T> const T* table(uint32_t offset) const {
+            return reinterpret_cast<const T*>(data + offset);
+        }
+
+        const char* data{nullptr};
+        size_t length{0};
+        // The file read into memory where it can not be mapped (Windows)
+        std::string buffer;
+        void* mapped{nullptr};
+    };
+} // namespace Doxybook2
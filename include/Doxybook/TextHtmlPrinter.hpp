@@ -0,0 +1,46 @@
+#pragma once
+#include "Output.hpp"
+#include "TextPrinter.hpp"
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+namespace Doxybook2 {
+    // Prints the Doxygen text as HTML, used instead of the TextMarkdownPrinter
+    // when the config.outputFormat is html, so the generated pages need no Markdown stage.
+    class TextHtmlPrinter : public TextPrinter {
+      public:
+        explicit TextHtmlPrinter(
+            const Config& config, std::string inputDir, const Doxygen& doxygen, Output* output = nullptr)
+            : TextPrinter(config, doxygen), inputDir(std::move(inputDir)), output(output) {
+        }
+
+        std::string print(const XmlTextParser::Node& node, const std::string& language) const override;
+
+      private:
+        struct PrintData {
+            std::stringstream ss;
+            // Each open list, true if it is a variable list (<dl>)
+            std::vector<bool> lists;
+            bool tableHeader{false};
+            bool validLink{false};
+        };
+
+        void print(PrintData& data,
+            const XmlTextParser::Node* parent,
+            const XmlTextParser::Node* node,
+            const std::string& language) const;
+
+        void programlisting(PrintData& data, const XmlTextParser::Node& node) const;
+        // Returns the name of the copied image, with the hash with config.hashImageNames
+        std::string copyImage(const std::string& name) const;
+
+        std::string inputDir;
+        // Where to copy the images into, if not set the images are copied into config.outputDir
+        Output* output;
+
+        mutable std::mutex imagesMutex;
+        // Name of each image in the input => name of the copied image
+        mutable std::unordered_map<std::string, std::string> copiedImages;
+    };
+} // namespace Doxybook2
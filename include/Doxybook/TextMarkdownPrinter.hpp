@@ -1,12 +1,14 @@
 #pragma once
+#include "Output.hpp"
 #include "TextPrinter.hpp"
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 namespace Doxybook2 {
     class TextMarkdownPrinter : public TextPrinter {
       public:
-        explicit TextMarkdownPrinter(const Config& config, std::string inputDir, const Doxygen& doxygen)
-            : TextPrinter(config, doxygen), inputDir(std::move(inputDir)) {
-        }
+        explicit TextMarkdownPrinter(
+            const Config& config, std::string inputDir, const Doxygen& doxygen, Output* output = nullptr);
 
         std::string print(const XmlTextParser::Node& node, const std::string& language) const override;
 
@@ -20,13 +22,15 @@ namespace Doxybook2 {
             std::stringstream ss;
             int indent{0};
             std::list<ListData> lists;
-            bool quote{false};
             bool eol{false};
             bool tableHeader{false};
-            bool inComputerOutput{false};
             bool validLink{false};
         };
 
+        // The Policy decides how the links, the inline code, and the text are written
+        // (see the policies in TextMarkdownPrinter.cpp), Quote is true inside of a blockquote.
+        // Both are resolved at compile time, so printing a node does not check the config.
+        template <typename Policy, bool Quote>
         void print(PrintData& data,
             const XmlTextParser::Node* parent,
             const XmlTextParser::Node* node,
@@ -34,8 +38,25 @@ namespace Doxybook2 {
             const XmlTextParser::Node* next,
             const std::string& language) const;
 
-        void programlisting(PrintData& data, const XmlTextParser::Node& node) const;
+        template <bool Quote> void programlisting(PrintData& data, const XmlTextParser::Node& node) const;
+        // Returns the name of the copied image, with the hash with config.hashImageNames
+        std::string copyImage(const std::string& name) const;
 
+        typedef void (TextMarkdownPrinter::*PrintFunc)(PrintData& data,
+            const XmlTextParser::Node* parent,
+            const XmlTextParser::Node* node,
+            const XmlTextParser::Node* previous,
+            const XmlTextParser::Node* next,
+            const std::string& language) const;
+
+        // The instantiation of print for the config, selected once in the constructor
+        PrintFunc printFunc;
         std::string inputDir;
+        // Where to copy the images into, if not set the images are copied into config.outputDir
+        Output* output;
+
+        mutable std::mutex imagesMutex;
+        // Name of each image in the input => name of the copied image
+        mutable std::unordered_map<std::string, std::string> copiedImages;
     };
 } // namespace Doxybook2
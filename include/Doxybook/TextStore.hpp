@@ -0,0 +1,73 @@
+#pragma once
+#include "Hash.hpp"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Doxybook2 {
+    // Holds the brief and the summary of all nodes. The same text is stored
+    // only once and the nodes refer to it by a 32-bit id.
+    //
+    // Once the model is loaded, compress() can build a dictionary from the text
+    // of the project itself (the most common words) and compress every text
+    // against it with a small LZ77 coder. The text is then decompressed on
+    // every access, trading CPU for memory in processes that keep the model
+    // loaded for a long time.
+    //
+    // Adding text is not thread safe. Reading is, as long as nothing is added.
+    class TextStore {
+    public:
+        typedef uint32_t Id;
+
+        // The empty string, always present
+        static constexpr Id EMPTY = 0;
+
+        TextStore();
+
+        Id add(const std::string& text);
+
+        std::string get(Id id) const;
+
+        // Compresses all texts that are at least minLength bytes long, with a
+        // dictionary of at most dictionarySize bytes. The texts added later are
+        // compressed with the same dictionary, but are no longer deduplicated.
+        void compress(size_t minLength, size_t dictionarySize = 32 * 1024);
+
+        bool isCompressed() const {
+            return compressed;
+        }
+
+        size_t getCount() const {
+            return entries.size();
+        }
+
+        // Bytes used by the texts (and the dictionary), without the bookkeeping
+        size_t getResidentSize() const {
+            return data.size() + dictionary.size();
+        }
+
+    private:
+        struct Entry {
+            uint32_t offset;
+            uint32_t length;
+            // Length before compression, 0 if stored as is
+            uint32_t rawLength;
+        };
+
+        Id append(const std::string& text);
+        std::string encode(const std::string& text) const;
+        std::string decode(const Entry& entry) const;
+        void train(size_t dictionarySize);
+
+        std::vector<Entry> entries;
+        std::string data;
+        std::unordered_multimap<Hash::Value, Id> index;
+        bool compressed{false};
+        size_t minLength{0};
+        std::string dictionary;
+        // Hash chains over the dictionary, used by the encoder
+        std::vector<int32_t> dictionaryHead;
+        std::vector<int32_t> dictionaryPrev;
+    };
+} // namespace Doxybook2
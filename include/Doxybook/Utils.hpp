@@ -43,6 +43,7 @@ namespace Doxybook2 {
         }
 
         extern std::string escape(std::string str);
+        extern std::string escapeHtml(const std::string& str);
         extern std::string title(std::string str);
         extern std::string toLower(std::string str);
         extern std::string safeAnchorId(std::string str);
@@ -15,6 +15,7 @@ namespace Doxybook2 {
         class Element;
 
         typedef std::function<void(Element&)> ElementCallback;
+        typedef std::function<void(const std::string& name, const std::string& value)> AttributeCallback;
 
         class Node {
         public:
@@ -46,6 +47,7 @@ namespace Doxybook2 {
             ~Element() = default;
 
             void allChildElements(const std::string& name, const ElementCallback& callback) const;
+            void allAttributes(const AttributeCallback& callback) const;
             Node asNode() const;
             Element nextSiblingElement() const;
             Node nextSibling() const;
@@ -72,6 +74,8 @@ namespace Doxybook2 {
         };
 
         explicit Xml(const std::string& path);
+        // Parses the xml from the memory, the path is only used to report errors
+        Xml(const std::string& path, const std::string& data);
         ~Xml();
 
         Element firstChildElement(const std::string& name) const;
@@ -0,0 +1,65 @@
+#pragma once
+#include "Xml.hpp"
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Doxybook2 {
+    // Where the xml of the compounds comes from. Either the Doxygen xml folder
+    // with the index.xml and one file per compound, or a single combined file
+    // created by Doxygen's combine.xslt (all.xml).
+    //
+    // The combined file is streamed through once to find the byte range of each
+    // <compounddef>, the compounds are then parsed one at a time by seeking
+    // straight to their range, the whole document is never held in memory.
+    class XmlSource {
+      public:
+        typedef std::function<void(const std::string& kind, const std::string& refid)> CompoundCallback;
+
+        explicit XmlSource(const std::string& input);
+        ~XmlSource();
+
+        // Returns true if the input is a path to a file and not a folder
+        static bool isCombined(const std::string& input);
+
+        // Returns the folder the images and other files are relative to
+        static std::string getInputDir(const std::string& input);
+
+        bool isCombined() const {
+            return combined;
+        }
+
+        // Lists the kind and refid of all compounds, in the order they appear
+        // in the index.xml or the combined file
+        void allCompounds(const CompoundCallback& callback) const;
+
+        // Returns the file the compound is located in
+        std::string getPath(const std::string& refid) const;
+
+        // Loads the compound, the <compounddef> is found via getCompounddef()
+        std::unique_ptr<Xml> load(const std::string& refid) const;
+
+        // Returns the <compounddef> element of the document returned by load()
+        static Xml::Element getCompounddef(const Xml& xml);
+
+      private:
+        struct Range {
+            size_t offset{0};
+            size_t length{0};
+        };
+
+        void scan();
+
+        std::string input;
+        bool combined{false};
+        std::vector<std::pair<std::string, std::string>> compounds;
+        std::unordered_map<std::string, Range> ranges;
+
+        mutable std::mutex mutex;
+        mutable std::ifstream file;
+    };
+} // namespace Doxybook2
@@ -0,0 +1,131 @@
+#include "ExceptionUtils.hpp"
+#include <Doxybook/Checkpoint.hpp>
+#include <Doxybook/Exception.hpp>
+#include <Doxybook/Path.hpp>
+#include <Doxybook/XmlSource.hpp>
+#include <filesystem>
+#include <spdlog/spdlog.h>
+
+static const std::string KEY_FILE = "key";
+static const std::string SNAPSHOT_FILE = "model.cbor";
+static const std::string SNAPSHOT_DONE_FILE = "model.done";
+static const std::string JOURNAL_FILE = "journal";
+
+Doxybook2::Checkpoint::Checkpoint(std::string dir) : dir(std::move(dir)) {
+}
+
+std::string Doxybook2::Checkpoint::makeKey(const std::string& input, const std::string& configData) {
+    // Doxygen writes the index (or the combined file) again on every run,
+    // the time and the size are enough to tell whether the input has changed.
+    const auto path = XmlSource::isCombined(input) ? input : Path::join(input, "index.xml");
+    std::error_code ec;
+    const auto time = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+    const auto size = std::filesystem::file_size(path, ec);
+
+    Hash hash;
+    hash.update(std::filesystem::absolute(path).string());
+    hash.update(static_cast<Hash::Value>(time));
+    hash.update(static_cast<Hash::Value>(size));
+    hash.update(configData);
+    return Hash::toHex(hash.get());
+}
+
+bool Doxybook2::Checkpoint::open(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::string existing;
+    {
+        std::ifstream file(Path::join(dir, KEY_FILE));
+        std::getline(file, existing);
+    }
+
+    const auto resumed = !existing.empty() && existing == key;
+    if (resumed) {
+        std::ifstream file(Path::join(dir, JOURNAL_FILE), std::ios::binary);
+        std::string line;
+        // getline also returns the last line without the newline, that one
+        // has been cut short and is ignored by checking for eof.
+        while (std::getline(file, line) && !file.eof()) {
+            const auto found = line.find(' ');
+            if (found == std::string::npos) {
+                continue;
+            }
+            done[line.substr(found + 1)] = std::stoull(line.substr(0, found), nullptr, 16);
+        }
+        snapshot = std::filesystem::exists(Path::join(dir, SNAPSHOT_DONE_FILE));
+    } else {
+        if (!existing.empty()) {
+            spdlog::warn("Checkpoint in {} belongs to a different input or config, starting over", dir);
+        }
+        std::error_code ec;
+        std::filesystem::remove_all(dir, ec);
+        std::filesystem::create_directories(dir, ec);
+        if (ec) {
+            throw EXCEPTION("Failed to create checkpoint directory {} error {}", dir, ec.message());
+        }
+        std::ofstream file(Path::join(dir, KEY_FILE));
+        file << key << "\n";
+    }
+
+    journal.open(Path::join(dir, JOURNAL_FILE), std::ios::binary | std::ios::app);
+    if (!journal) {
+        throw EXCEPTION("Failed to open checkpoint journal {}", Path::join(dir, JOURNAL_FILE));
+    }
+    return resumed;
+}
+
+void Doxybook2::Checkpoint::remove() {
+    std::lock_guard<std::mutex> lock(mutex);
+    journal.close();
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+}
+
+bool Doxybook2::Checkpoint::isDone(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return done.find(path) != done.end();
+}
+
+void Doxybook2::Checkpoint::record(const std::string& path, const std::string& data) {
+    const auto hash = Hash::of(data);
+    std::lock_guard<std::mutex> lock(mutex);
+    done[path] = hash;
+    if (journal.is_open()) {
+        journal << Hash::toHex(hash) << " " << path << "\n";
+        journal.flush();
+    }
+}
+
+size_t Doxybook2::Checkpoint::getDoneCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return done.size();
+}
+
+std::unordered_map<std::string, Doxybook2::Hash::Value> Doxybook2::Checkpoint::getDone() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return done;
+}
+
+std::string Doxybook2::Checkpoint::getSnapshotPath() const {
+    return Path::join(dir, SNAPSHOT_FILE);
+}
+
+bool Doxybook2::Checkpoint::hasSnapshot() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return snapshot;
+}
+
+void Doxybook2::Checkpoint::snapshotSaved() {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::ofstream(Path::join(dir, SNAPSHOT_DONE_FILE)) << "\n";
+    snapshot = true;
+}
+
+Doxybook2::CheckpointOutput::CheckpointOutput(Output& output, Checkpoint& checkpoint)
+    : output(output), checkpoint(checkpoint) {
+}
+
+void Doxybook2::CheckpointOutput::write(const std::string& path, const std::string& data) {
+    output.write(path, data);
+    checkpoint.record(path, data);
+}
@@ -32,10 +32,21 @@ static const std::vector<ConfigArg> CONFIG_ARGS = {
     ConfigArg(&Doxybook2::Config::linkSuffix, "linkSuffix"),
     ConfigArg(&Doxybook2::Config::linkLowercase, "linkLowercase"),
     ConfigArg(&Doxybook2::Config::linkAndInlineCodeAsHTML, "linkAndInlineCodeAsHTML"),
+    ConfigArg(&Doxybook2::Config::outputFormat, "outputFormat"),
+    ConfigArg(&Doxybook2::Config::htmlFragments, "htmlFragments"),
     ConfigArg(&Doxybook2::Config::copyImages, "copyImages"),
+    ConfigArg(&Doxybook2::Config::sourceListing, "sourceListing"),
+    ConfigArg(&Doxybook2::Config::loadVisibility, "loadVisibility"),
+    ConfigArg(&Doxybook2::Config::loadUndocumented, "loadUndocumented"),
+    ConfigArg(&Doxybook2::Config::loadExclude, "loadExclude"),
+    ConfigArg(&Doxybook2::Config::loadLanguages, "loadLanguages"),
     ConfigArg(&Doxybook2::Config::sort, "sort"),
     ConfigArg(&Doxybook2::Config::useFolders, "useFolders"),
+    ConfigArg(&Doxybook2::Config::folderShardLength, "folderShardLength"),
     ConfigArg(&Doxybook2::Config::imagesFolder, "imagesFolder"),
+    ConfigArg(&Doxybook2::Config::hashImageNames, "hashImageNames"),
+    ConfigArg(&Doxybook2::Config::contentHashes, "contentHashes"),
+    ConfigArg(&Doxybook2::Config::symbolIndex, "symbolIndex"),
     ConfigArg(&Doxybook2::Config::mainPageName, "mainPageName"),
     ConfigArg(&Doxybook2::Config::mainPageInRoot, "mainPageInRoot"),
     ConfigArg(&Doxybook2::Config::folderClassesName, "folderClassesName"),
@@ -79,6 +90,20 @@ static const std::vector<ConfigArg> CONFIG_ARGS = {
     ConfigArg(&Doxybook2::Config::formulaInlineEnd, "formulaInlineEnd"),
     ConfigArg(&Doxybook2::Config::formulaBlockStart, "formulaBlockStart"),
     ConfigArg(&Doxybook2::Config::formulaBlockEnd, "formulaBlockEnd"),
+    ConfigArg(&Doxybook2::Config::pipelineConvertThreads, "pipelineConvertThreads"),
+    ConfigArg(&Doxybook2::Config::pipelineRenderThreads, "pipelineRenderThreads"),
+    ConfigArg(&Doxybook2::Config::pipelineWriteThreads, "pipelineWriteThreads"),
+    ConfigArg(&Doxybook2::Config::pipelineQueueSize, "pipelineQueueSize"),
+    ConfigArg(&Doxybook2::Config::schedulerThreads, "schedulerThreads"),
+    ConfigArg(&Doxybook2::Config::schedulerPinThreads, "schedulerPinThreads"),
+    ConfigArg(&Doxybook2::Config::renderProcesses, "renderProcesses"),
+    ConfigArg(&Doxybook2::Config::renderProcessBatchSize, "renderProcessBatchSize"),
+    ConfigArg(&Doxybook2::Config::renderTimeLimit, "renderTimeLimit"),
+    ConfigArg(&Doxybook2::Config::renderSizeLimit, "renderSizeLimit"),
+    ConfigArg(&Doxybook2::Config::renderLimitPlaceholder, "renderLimitPlaceholder"),
+    ConfigArg(&Doxybook2::Config::compressText, "compressText"),
+    ConfigArg(&Doxybook2::Config::compressTextMinLength, "compressTextMinLength"),
+    ConfigArg(&Doxybook2::Config::inheritedCacheSize, "inheritedCacheSize"),
 };
 
 void Doxybook2::loadConfig(Config& config, const std::string& path) {
@@ -118,10 +143,13 @@ void Doxybook2::saveConfig(Config& config, const std::string& path) {
         throw EXCEPTION("Failed to open file {} for writing", path);
     }
 
+    file << saveConfigData(config);
+}
+
+std::string Doxybook2::saveConfigData(const Config& config) {
     nlohmann::json json;
     for (const auto& arg : CONFIG_ARGS) {
         arg.saveFunc(arg, config, json);
     }
-
-    file << json.dump(2);
+    return json.dump(2);
 }
@@ -0,0 +1,543 @@
+#include <Doxybook/DefaultTemplates.hpp>
+#include <Doxybook/Utils.hpp>
+#include <sstream>
+
+// The HTML counterparts of the Markdown templates from DefaultTemplates.cpp.
+// The names and the dependencies are the same, so the custom templates
+// and the template config options work the same way for both formats.
+//
+// All of the text printed by the TextHtmlPrinter (brief, details, type, etc.)
+// is already HTML, the plain text (name, title, typePlain, etc.) is escaped here.
+
+// clang-format off
+static const std::vector<std::string> ALL_VISIBILITIES = {
+    "public", "protected"
+};
+// clang-format on
+
+static const std::string TEMPLATE_META = R"()";
+
+static const std::string TEMPLATE_HEADER =
+    R"(<!DOCTYPE html>
+<html>
+<head>
+<meta charset="utf-8"/>
+{% if exists("title") -%}
+<title>{{escapeHtml(title)}}</title>
+{% else if exists("name") -%}
+<title>{{escapeHtml(name)}}</title>
+{% endif -%}
+{% if exists("summary") -%}
+<meta name="description" content="{{escapeHtml(summary)}}"/>
+{% endif -%}
+{% include "meta" %}
+</head>
+<body>
+{% if exists("title") -%}
+<h1>{{escapeHtml(title)}}</h1>
+{% else if exists("kind") and kind != "page" -%}
+<h1>{{escapeHtml(name)}} {{title(kind)}} Reference</h1>
+{% endif %}
+)";
+
+static const std::string TEMPLATE_FRAGMENT_HEADER =
+    R"({% if exists("title") -%}
+<h1>{{escapeHtml(title)}}</h1>
+{% else if exists("kind") and kind != "page" -%}
+<h1>{{escapeHtml(name)}} {{title(kind)}} Reference</h1>
+{% endif %}
+)";
+
+static const std::string TEMPLATE_BREADCRUMBS = R"({% if exists("moduleBreadcrumbs") -%}
+<p><strong>Module:</strong> {%- for module in moduleBreadcrumbs -%}
+ <a href="{{module.url}}">{{escapeHtml(module.title)}}</a>{% if not loop.is_last %} / {% endif -%}
+{% endfor %}</p>
+
+{% endif -%})";
+
+static const std::string TEMPLATE_FOOTER =
+    R"(<hr/>
+<p>Updated on {{date("%F at %H:%M:%S %z")}}</p>
+</body>
+</html>
+)";
+
+static const std::string TEMPLATE_FRAGMENT_FOOTER = R"()";
+
+static std::string createDetailsParamList(const std::string& title, const std::string& key) {
+    std::stringstream ss;
+    ss << "{% if exists(\"" << key << "\") %}\n";
+    ss << "<p><strong>" << title << "</strong>:</p>\n<ul>\n";
+    ss << "{% for param in " << key << " %}<li><strong>{{param.name}}</strong> {{param.text}}</li>\n";
+    ss << "{% endfor %}</ul>\n";
+    ss << "{% endif -%}\n";
+    return ss.str();
+}
+
+static std::string createDetailsList(const std::string& title, const std::string& key) {
+    std::stringstream ss;
+    ss << "{% if exists(\"" << key << "\") %}\n";
+    ss << "<p><strong>" << title << "</strong>: {% if length(" << key << ") == 1 %}{{first(" << key
+       << ")}}</p>\n{% else %}</p>\n<ul>\n";
+    ss << "{% for item in " << key << " %}<li>{{item}}</li>\n";
+    ss << "{% endfor %}</ul>\n{% endif %}";
+    ss << "{% endif -%}\n";
+    return ss.str();
+}
+
+static std::string createDetails() {
+    std::stringstream ss;
+    ss << "{% if exists(\"brief\") %}<p>{{brief}}</p>\n{% endif -%}\n";
+    ss << createDetailsParamList("Parameters", "paramList");
+    ss << createDetailsParamList("Returns", "returnsList");
+    ss << createDetailsParamList("Exceptions", "exceptionsList");
+    ss << createDetailsParamList("Template Parameters", "templateParamsList");
+    ss << "{% if exists(\"deprecated\") %}\n<p><strong>Deprecated</strong>: {{deprecated}}</p>\n{% endif -%}\n";
+    ss << createDetailsList("See", "see");
+    ss << createDetailsList("Return", "returns");
+    ss << createDetailsList("Author", "authors");
+    ss << createDetailsList("Version", "version");
+    ss << createDetailsList("Since", "since");
+    ss << createDetailsList("Date", "date");
+    ss << createDetailsList("Note", "note");
+    ss << createDetailsList("Bug", "bugs");
+    ss << createDetailsList("Test", "tests");
+    ss << createDetailsList("Todo", "todos");
+    ss << createDetailsList("Warning", "warning");
+    ss << createDetailsList("Precondition", "pre");
+    ss << createDetailsList("Postcondition", "post");
+    ss << createDetailsList("Copyright", "copyright");
+    ss << createDetailsList("Invariant", "invariant");
+    ss << createDetailsList("Remark", "remark");
+    ss << createDetailsList("Attention", "attention");
+    ss << createDetailsList("Par", "par");
+    ss << createDetailsList("Rcs", "rcs");
+    ss << R"({% if exists("reimplements") %}
+<p><strong>Reimplements</strong>: <a href="{{reimplements.url}}">{{escapeHtml(reimplements.fullname)}}</a></p>
+{% endif -%}
+{% if exists("reimplementedBy") %}
+<p><strong>Reimplemented by</strong>: {% for impl in reimplementedBy %}<a href="{{impl.url}}">{{escapeHtml(impl.fullname)}}</a>{% if not loop.is_last %}, {% endif %}{% endfor %}</p>
+{% endif -%}
+{% if exists("details") %}
+{{details}}
+{% endif -%}
+{% if exists("inbody") %}
+{{inbody}}
+{% endif -%})";
+    return ss.str();
+}
+
+static const std::string TEMPLATE_DETAILS = createDetails();
+
+// The first cell of a member table row, i.e. "template <typename T> virtual int"
+static const std::string CELL_TEMPLATE_PARAMS =
+    R"({% if existsIn(child, "templateParams") -%}
+template &lt;{% for param in child.templateParams %}{{escapeHtml(param.typePlain)}} {{param.name}}{% if existsIn(param, "defvalPlain") %} ={{escapeHtml(param.defvalPlain)}}{% endif %}{% if not loop.is_last %}, {% endif %}{% endfor %}&gt;<br/>
+{%- endif -%})";
+
+static const std::string CELL_PARAMS =
+    R"(({% for param in child.params %}{{param.type}} {{param.name}}{% if existsIn(param, "defval") %} ={{param.defval}}{% endif %}{% if not loop.is_last %}, {% endif %}{% endfor %}))";
+
+static const std::string CELL_BRIEF = R"({% if existsIn(child, "brief") %}<br/>{{child.brief}}{% endif %})";
+
+static std::string createTableHead(const std::string& title, const std::string& key, const bool inherited) {
+    std::stringstream ss;
+    if (inherited) {
+        ss << "{%- if existsIn(base, \"" << key << "\") -%}\n";
+        ss << "<p><strong>" << title
+           << " inherited from <a href=\"{{base.url}}\">{{escapeHtml(base.name)}}</a></strong></p>\n";
+    } else {
+        ss << "{%- if exists(\"" << key << "\") %}";
+        ss << "<h2>" << title << "</h2>\n";
+    }
+    ss << "<table>\n";
+    ss << "{% for child in " << (inherited ? "base." : "") << key << " -%}\n";
+    return ss.str();
+}
+
+static std::string createTableTail() {
+    return "{% endfor %}</table>\n{% endif -%}\n";
+}
+
+static std::string createTableForNamespaceLike(const std::string& title, const std::string& key, const bool inherited) {
+    std::stringstream ss;
+    ss << createTableHead(title, key, inherited);
+    ss << "<tr><td><strong><a href=\"{{child.url}}\">{{escapeHtml(child.name)}}</a></strong>";
+    ss << CELL_BRIEF << "</td></tr>\n";
+    ss << createTableTail();
+    return ss.str();
+}
+
+static std::string createTableForClassLike(const std::string& title, const std::string& key, const bool inherited) {
+    std::stringstream ss;
+    ss << createTableHead(title, key, inherited);
+    ss << "<tr><td>{{child.kind}}</td><td><strong><a href=\"{{child.url}}\">";
+    ss << "{{escapeHtml(last(stripNamespace(child.name)))}}</a></strong>";
+    ss << CELL_BRIEF << "</td></tr>\n";
+    ss << createTableTail();
+    return ss.str();
+}
+
+static std::string createTableForTypeLike(const std::string& title, const std::string& key, const bool inherited) {
+    std::stringstream ss;
+    ss << createTableHead(title, key, inherited);
+    ss << "<tr><td>" << CELL_TEMPLATE_PARAMS;
+    ss << "{{child.kind}}{% if child.kind == \"enum\" and child.strong %} class{% endif %}";
+    ss << "{% if existsIn(child, \"type\") %} {{child.type}}{% endif %}</td>";
+    ss << "<td><strong><a href=\"{{child.url}}\">{{escapeHtml(child.name)}}</a></strong>";
+    ss << "{% if child.kind == \"enum\" %} { {% for enumvalue in child.enumvalues %}{{escapeHtml(enumvalue.name)}}";
+    ss << "{% if existsIn(enumvalue, \"initializer\") %} {{escapeHtml(enumvalue.initializer)}}{% endif %}";
+    ss << "{% if not loop.is_last %}, {% endif %}{% endfor %} }{% endif %}";
+    ss << CELL_BRIEF << "</td></tr>\n";
+    ss << createTableTail();
+    return ss.str();
+}
+
+static std::string createTableForFunctionLike(const std::string& title, const std::string& key, const bool inherited) {
+    std::stringstream ss;
+    ss << createTableHead(title, key, inherited);
+    ss << "<tr><td>" << CELL_TEMPLATE_PARAMS;
+    ss << "{% if child.virtual %}virtual {% endif %}{% if existsIn(child, \"type\") %}{{child.type}}{% endif %}</td>";
+    ss << "<td><strong><a href=\"{{child.url}}\">{{escapeHtml(child.name)}}</a></strong>" << CELL_PARAMS;
+    ss << "{% if child.const %} const{% endif %}{% if child.override %} override{% endif %}";
+    ss << "{% if child.default %} =default{% endif %}{% if child.deleted %} =delete{% endif %}";
+    ss << "{% if child.pureVirtual %} =0{% endif %}";
+    ss << CELL_BRIEF << "</td></tr>\n";
+    ss << createTableTail();
+    return ss.str();
+}
+
+static std::string createTableForAttributeLike(const std::string& title, const std::string& key, const bool inherited) {
+    std::stringstream ss;
+    ss << createTableHead(title, key, inherited);
+    ss << "<tr><td>{% if existsIn(child, \"type\") %}{{child.type}}{% endif %}</td>";
+    ss << "<td><strong><a href=\"{{child.url}}\">{{escapeHtml(child.name)}}</a></strong>";
+    ss << CELL_BRIEF << "</td></tr>\n";
+    ss << createTableTail();
+    return ss.str();
+}
+
+static std::string createTableForFriendLike(const std::string& title, const std::string& key, const bool inherited) {
+    std::stringstream ss;
+    ss << createTableHead(title, key, inherited);
+    ss << "<tr><td>{% if existsIn(child, \"type\") %}{{child.type}}{% endif %}</td>";
+    ss << "<td><strong><a href=\"{{child.url}}\">{{escapeHtml(child.name)}}</a></strong>";
+    ss << "{% if child.type != \"class\" and child.type != \"struct\" %}" << CELL_PARAMS;
+    ss << "{% if child.const %} const{% endif %}{% endif %}";
+    ss << CELL_BRIEF << "</td></tr>\n";
+    ss << createTableTail();
+    return ss.str();
+}
+
+static std::string createTableForDefineLike(const std::string& title, const std::string& key, const bool inherited) {
+    std::stringstream ss;
+    ss << createTableHead(title, key, inherited);
+    ss << "<tr><td>{% if existsIn(child, \"type\") %}{{child.type}}{% endif %}</td>";
+    ss << "<td><strong><a href=\"{{child.url}}\">{{escapeHtml(child.name)}}</a></strong>";
+    ss << "{% if existsIn(child, \"params\") %}({% for param in child.params %}{{param.name}}";
+    ss << "{% if not loop.is_last %}, {% endif %}{% endfor %}){% endif %}";
+    ss << CELL_BRIEF << "</td></tr>\n";
+    ss << createTableTail();
+    return ss.str();
+}
+
+template <typename Fn>
+static std::string createForVisibilities(Fn& fn, const std::string& title, const std::string& key, const bool inherited) {
+    std::stringstream ss;
+    for (const auto& visibility : ALL_VISIBILITIES) {
+        ss << fn(Doxybook2::Utils::title(visibility) + " " + title, visibility + Doxybook2::Utils::title(key), inherited);
+    }
+    return ss.str();
+}
+
+static std::string createMemberTable(const bool inherited) {
+    std::stringstream ss;
+    ss << createForVisibilities(createTableForClassLike, "Classes", "classes", inherited);
+    ss << createForVisibilities(createTableForTypeLike, "Types", "types", inherited);
+    ss << createForVisibilities(createTableForFunctionLike, "Slots", "slots", inherited);
+    ss << createForVisibilities(createTableForFunctionLike, "Signals", "signals", inherited);
+    ss << createForVisibilities(createTableForFunctionLike, "Events", "events", inherited);
+    ss << createForVisibilities(createTableForFunctionLike, "Functions", "functions", inherited);
+    ss << createForVisibilities(createTableForAttributeLike, "Properties", "properties", inherited);
+    ss << createForVisibilities(createTableForAttributeLike, "Attributes", "attributes", inherited);
+    ss << createTableForFriendLike("Friends", "friends", inherited);
+    return ss.str();
+}
+
+static std::string createBaseTable() {
+    return "{% for base in baseClasses -%}\n" + createMemberTable(true) + "{% endfor -%}";
+}
+
+static std::string createNonMemberTable() {
+    std::stringstream ss;
+    for (const auto& pair : {std::make_pair("Modules", "groups"),
+             std::make_pair("Directories", "dirs"),
+             std::make_pair("Files", "files")}) {
+        ss << "{% if exists(\"" << pair.second << "\") %}<h2>" << pair.first << "</h2>\n<table>\n";
+        ss << "{% for child in " << pair.second << " -%}\n";
+        ss << "<tr><td><strong><a href=\"{{child.url}}\">{{escapeHtml(child.title)}}</a></strong>";
+        ss << CELL_BRIEF << "</td></tr>\n";
+        ss << createTableTail() << "\n";
+    }
+    ss << createTableForNamespaceLike("Namespaces", "namespaces", false);
+    ss << createTableForClassLike("Classes", "publicClasses", false);
+    ss << createTableForTypeLike("Types", "publicTypes", false);
+    ss << createTableForFunctionLike("Slots", "publicSlots", false);
+    ss << createTableForFunctionLike("Signals", "publicSignals", false);
+    ss << createTableForFunctionLike("Functions", "publicFunctions", false);
+    ss << createTableForAttributeLike("Attributes", "publicAttributes", false);
+    ss << createTableForDefineLike("Defines", "defines", false);
+    return ss.str();
+}
+
+static const std::string TEMPLATE_CLASS_MEMBERS_INHERITED_TABLES = createBaseTable();
+static const std::string TEMPLATE_CLASS_MEMBERS_TABLES = createMemberTable(false);
+static const std::string TEMPLATE_NONCLASS_MEMBERS_TABLES = createNonMemberTable();
+
+static const std::string TEMPLATE_MEMBER_DETAILS =
+    R"({% if kind in ["function", "slot", "signal", "event"] -%}
+<pre><code class="language-{{language}}">{% if exists("templateParams") -%}
+template &lt;{% for param in templateParams %}{{escapeHtml(param.typePlain)}} {{param.name}}{% if existsIn(param, "defvalPlain") %} ={{escapeHtml(param.defvalPlain)}}{% endif %}{% if not loop.is_last %},
+{% endif %}{% endfor %}&gt;
+{% endif -%}
+{% if static %}static {% endif -%}
+{% if inline and language != "csharp" %}inline {% endif -%}
+{% if explicit %}explicit {% endif -%}
+{% if virtual %}virtual {% endif -%}
+{% if exists("typePlain") %}{{escapeHtml(typePlain)}} {% endif %}{{escapeHtml(name)}}({% for param in params %}
+    {{escapeHtml(param.typePlain)}} {{param.name}}{% if existsIn(param, "defvalPlain") %} ={{escapeHtml(param.defvalPlain)}}{% endif %}{% if not loop.is_last %},{% else %}
+{% endif %}{% endfor %})
+{%- if const %} const{% endif -%}
+{% if override %} override{% endif -%}
+{% if default %} =default{% endif -%}
+{% if deleted %} =delete{% endif -%}
+{% if pureVirtual %} =0{% endif %}</code></pre>
+{% endif -%}
+
+{% if kind == "enum" -%}
+<table>
+<tr><th>Enumerator</th><th>Value</th><th>Description</th></tr>
+{% for enumvalue in enumvalues %}<tr><td>{{escapeHtml(enumvalue.name)}}</td><td>{% if existsIn(enumvalue, "initializer") %}{{escapeHtml(replace(enumvalue.initializer, "= ", ""))}}{% endif %}</td><td>{% if existsIn(enumvalue, "brief") %}{{enumvalue.brief}}{% endif %} {% if existsIn(enumvalue, "details") %}{{enumvalue.details}}{% endif %}</td></tr>
+{% endfor %}</table>
+{% endif -%}
+
+{% if kind in ["variable", "property"] -%}
+<pre><code class="language-{{language}}">{% if static %}static {% endif -%}
+{% if exists("typePlain") %}{{escapeHtml(typePlain)}} {% endif %}{{escapeHtml(name)}}{% if exists("initializer") %} {{escapeHtml(initializer)}}{% endif %};</code></pre>
+{% endif -%}
+
+{% if kind in ["typedef", "using"] -%}
+<pre><code class="language-{{language}}">{% if exists("templateParams") -%}
+template &lt;{% for param in templateParams %}{{escapeHtml(param.typePlain)}} {{param.name}}{% if existsIn(param, "defvalPlain") %} ={{escapeHtml(param.defvalPlain)}}{% endif %}{% if not loop.is_last %},
+{% endif %}{% endfor %}&gt;
+{% endif -%}
+{{escapeHtml(definition)}};</code></pre>
+{% endif -%}
+
+{% if kind == "friend" -%}
+<pre><code class="language-{{language}}">friend {% if exists("typePlain") %}{{escapeHtml(typePlain)}} {% endif %}{{escapeHtml(name)}}
+{%- if typePlain != "class" and typePlain != "struct" %}({% for param in params %}{{escapeHtml(param.typePlain)}} {{param.name}}{% if not loop.is_last %}, {% endif %}{% endfor %}){% endif %};</code></pre>
+{% endif -%}
+
+{% if kind == "define" -%}
+<pre><code class="language-{{language}}">#define {{escapeHtml(name)}}{% if exists("params") %}({% for param in params %}{{param.name}}{% if not loop.is_last %}, {% endif %}{% endfor %}){% endif %} {% if exists("initializer") %}{{escapeHtml(initializer)}}{% endif %}</code></pre>
+{% endif %}
+
+{% include "details" -%})";
+
+static std::string createMembersDetails(const std::vector<std::pair<std::string, std::string>>& sections) {
+    std::stringstream ss;
+    for (const auto& pair : sections) {
+        ss << "{% if exists(\"" << pair.second << "\") %}<h2>" << pair.first << "</h2>\n\n";
+        ss << "{% for child in " << pair.second << " %}";
+        ss << "<h3 id=\"{{replace(child.anchor, \"#\", \"\")}}\">{{child.kind}} {{escapeHtml(child.name)}}</h3>\n\n";
+        ss << "{{ render(\"member_details\", child) }}\n";
+        ss << "{% endfor %}{% endif -%}\n";
+    }
+    return ss.str();
+}
+
+static const std::string TEMPLATE_NONCLASS_MEMBERS_DETAILS =
+    createMembersDetails({{"Types Documentation", "publicTypes"},
+        {"Functions Documentation", "publicFunctions"},
+        {"Attributes Documentation", "publicAttributes"},
+        {"Macros Documentation", "defines"}});
+
+static const std::string TEMPLATE_CLASS_MEMBERS_DETAILS =
+    createMembersDetails({{"Public Types Documentation", "publicTypes"},
+        {"Protected Types Documentation", "protectedTypes"},
+        {"Public Slots Documentation", "publicSlots"},
+        {"Protected Slots Documentation", "protectedSlots"},
+        {"Public Signals Documentation", "publicSignals"},
+        {"Protected Signals Documentation", "protectedSignals"},
+        {"Public Events Documentation", "publicEvents"},
+        {"Protected Events Documentation", "protectedEvents"},
+        {"Public Functions Documentation", "publicFunctions"},
+        {"Protected Functions Documentation", "protectedFunctions"},
+        {"Public Property Documentation", "publicProperties"},
+        {"Protected Property Documentation", "protectedProperties"},
+        {"Public Attributes Documentation", "publicAttributes"},
+        {"Protected Attributes Documentation", "protectedAttributes"},
+        {"Friends", "friends"}});
+
+static const std::string TEMPLATE_KIND_NONCLASS =
+    R"({% include "header" -%}
+
+{% include "breadcrumbs" -%}
+
+<p>{% if exists("brief") %}{{brief}}{% endif %}{% if hasDetails %} <a href="#detailed-description">More...</a>{% endif %}</p>
+
+{% include "nonclass_members_tables" -%}
+
+{% if hasDetails %}<h2 id="detailed-description">Detailed Description</h2>
+
+{% include "details" %}{% endif -%}
+
+{% include "nonclass_members_details" %}
+
+{% include "footer" %})";
+
+static const std::string TEMPLATE_KIND_CLASS =
+    R"({% include "header" -%}
+
+{% include "breadcrumbs" %}
+
+<p>{% if exists("brief") %}{{brief}}{% endif %}{% if hasDetails %} <a href="#detailed-description">More...</a>{% endif %}</p>
+
+{% if exists("includes") %}
+<p><code>#include {{escapeHtml(includes)}}</code></p>
+
+{% endif -%}
+
+{%- if exists("baseClasses") %}<p>Inherits from {% for child in baseClasses %}{% if existsIn(child, "url") %}<a href="{{child.url}}">{{escapeHtml(child.name)}}</a>{% else %}{{escapeHtml(child.name)}}{% endif %}{% if not loop.is_last %}, {% endif %}{% endfor %}</p>
+
+{% endif -%}
+{%- if exists("derivedClasses") %}<p>Inherited by {% for child in derivedClasses %}{% if existsIn(child, "url") %}<a href="{{child.url}}">{{escapeHtml(child.name)}}</a>{% else %}{{escapeHtml(child.name)}}{% endif %}{% if not loop.is_last %}, {% endif %}{% endfor %}</p>
+
+{% endif -%}
+
+{%- include "class_members_tables" -%}
+
+{% if hasAdditionalMembers %}<h2>Additional inherited members</h2>
+
+{% include "class_members_inherited_tables" %}
+{% endif -%}
+
+{% if hasDetails %}<h2 id="detailed-description">Detailed Description</h2>
+
+<pre><code class="language-{{language}}">{% if exists("templateParams") %}template &lt;{% for param in templateParams %}{{escapeHtml(param.typePlain)}} {{param.name}}{% if existsIn(param, "defvalPlain") %} ={{escapeHtml(param.defvalPlain)}}{% endif %}{% if not loop.is_last %},
+{% endif %}{% endfor %}&gt;
+{% endif %}{% if kind == "interface" %}class{% else %}{{kind}}{% endif %} {{escapeHtml(name)}};</code></pre>
+
+{% include "details" %}{% endif -%}
+
+{% include "class_members_details" -%}
+
+{% include "footer" %})";
+
+static const std::string TEMPLATE_KIND_FILE =
+    R"({% include "header" -%}
+
+<p>{% if exists("brief") %}{{brief}}{% endif %}{% if hasDetails %} <a href="#detailed-description">More...</a>{% endif %}</p>
+
+{% include "nonclass_members_tables" -%}
+
+{% if hasDetails %}<h2 id="detailed-description">Detailed Description</h2>
+
+{% include "details" %}{% endif -%}
+
+{% include "nonclass_members_details" -%}
+
+{% if exists("programlisting")%}<h2>Source code</h2>
+
+<pre><code class="language-{{language}}">{{escapeHtml(programlisting)}}</code></pre>
+{% endif -%}
+{% if exists("programlistingFile")%}<h2>Source code</h2>
+
+<p><a href="{{programlistingFile}}">{{escapeHtml(name)}}</a></p>
+{% endif %}
+
+{% include "footer" %}
+)";
+
+static const std::string TEMPLATE_KIND_PAGE =
+    R"({% include "header" %}
+
+{% if exists("details") %}{{details}}{% endif %}
+
+{% include "footer" %}
+)";
+
+static std::string createIndex(const int depth) {
+    std::stringstream ss;
+    for (auto i = 0; i < depth; i++) {
+        const auto child = "child" + std::to_string(i);
+        const auto parent = i == 0 ? std::string("") : "child" + std::to_string(i - 1) + ".";
+        if (i == 0) {
+            ss << "{% if exists(\"children\") %}";
+        } else {
+            ss << "{% if existsIn(child" << i - 1 << ", \"children\") %}";
+        }
+        ss << "<ul>\n{% for " << child << " in " << parent << "children %}<li><strong>{{" << child
+           << ".kind}} <a href=\"{{" << child << ".url}}\">";
+        if (i == 0) {
+            ss << "{{escapeHtml(" << child << ".title)}}";
+        } else {
+            ss << "{{escapeHtml(last(stripNamespace(" << child << ".title)))}}";
+        }
+        ss << "</a></strong>{% if existsIn(" << child << ", \"brief\") %}<br/>{{" << child << ".brief}}{% endif %}";
+    }
+    for (auto i = 0; i < depth; i++) {
+        ss << "</li>\n{% endfor %}</ul>\n{% endif %}";
+    }
+    return ss.str();
+}
+
+static const std::string TEMPLATE_INDEX = createIndex(8);
+
+static const std::string TEMPLATE_INDEX_PAGE =
+    R"({% include "header" %}
+
+{% include "index" %}
+
+{% include "footer" %}
+)";
+
+static Doxybook2::DefaultTemplates createHtmlTemplates(const bool fragments) {
+    // clang-format off
+    return {
+        {"meta", {TEMPLATE_META, {}}},
+        {"header", {fragments ? TEMPLATE_FRAGMENT_HEADER : TEMPLATE_HEADER, {"meta"}}},
+        {"footer", {fragments ? TEMPLATE_FRAGMENT_FOOTER : TEMPLATE_FOOTER, {}}},
+        {"details", {TEMPLATE_DETAILS, {}}},
+        {"breadcrumbs", {TEMPLATE_BREADCRUMBS, {}}},
+        {"member_details", {TEMPLATE_MEMBER_DETAILS, {"details"}}},
+        {"class_members_tables", {TEMPLATE_CLASS_MEMBERS_TABLES, {}}},
+        {"class_members_inherited_tables", {TEMPLATE_CLASS_MEMBERS_INHERITED_TABLES, {}}},
+        {"class_members_details", {TEMPLATE_CLASS_MEMBERS_DETAILS, {"member_details"}}},
+        {"nonclass_members_tables", {TEMPLATE_NONCLASS_MEMBERS_TABLES, {}}},
+        {"nonclass_members_details", {TEMPLATE_NONCLASS_MEMBERS_DETAILS, {"member_details"}}},
+        {"index", {TEMPLATE_INDEX, {}}},
+        {"kind_nonclass", {TEMPLATE_KIND_NONCLASS,
+            {"header", "breadcrumbs", "nonclass_members_tables", "nonclass_members_details", "footer"}}},
+        {"kind_class", {TEMPLATE_KIND_CLASS,
+            {"header", "breadcrumbs", "class_members_tables", "class_members_inherited_tables",
+             "class_members_details", "footer"}}},
+        {"kind_group", {TEMPLATE_KIND_NONCLASS,
+            {"header", "breadcrumbs", "nonclass_members_tables", "nonclass_members_details", "footer"}}},
+        {"kind_file", {TEMPLATE_KIND_FILE,
+            {"header", "nonclass_members_tables", "nonclass_members_details", "footer"}}},
+        {"kind_page", {TEMPLATE_KIND_PAGE, {"header", "footer"}}},
+        {"kind_example", {TEMPLATE_KIND_PAGE, {"header", "footer"}}},
+        {"index_classes", {TEMPLATE_INDEX_PAGE, {"header", "index", "footer"}}},
+        {"index_namespaces", {TEMPLATE_INDEX_PAGE, {"header", "index", "footer"}}},
+        {"index_groups", {TEMPLATE_INDEX_PAGE, {"header", "index", "footer"}}},
+        {"index_files", {TEMPLATE_INDEX_PAGE, {"header", "index", "footer"}}},
+        {"index_pages", {TEMPLATE_INDEX_PAGE, {"header", "index", "footer"}}},
+        {"index_examples", {TEMPLATE_INDEX_PAGE, {"header", "index", "footer"}}}
+    };
+    // clang-format on
+}
+
+Doxybook2::DefaultTemplates Doxybook2::defaultHtmlTemplates = createHtmlTemplates(false);
+Doxybook2::DefaultTemplates Doxybook2::defaultHtmlFragmentTemplates = createHtmlTemplates(true);
@@ -898,6 +898,10 @@ static const std::string TEMPLATE_KIND_FILE =
 ```{{language}}
 {{programlisting}}
 ```
+{% endif -%}
+{% if exists("programlistingFile")%}## Source code
+
+[{{name}}]({{programlistingFile}})
 {% endif %}
 
 {% include "footer" %}
@@ -981,7 +985,7 @@ static const std::string TEMPLATE_INDEX_EXAMPLES =
 )";
 
 // clang-format off
-std::unordered_map<std::string, Doxybook2::DefaultTemplate> Doxybook2::defaultTemplates = {
+Doxybook2::DefaultTemplates Doxybook2::defaultTemplates = {
     {"meta", {
         TEMPLATE_META,
         {}
@@ -1105,8 +1109,15 @@ std::unordered_map<std::string, Doxybook2::DefaultTemplate> Doxybook2::defaultTe
 };
 // clang-format on
 
-void Doxybook2::saveDefaultTemplates(const std::string& path) {
-    for (const auto& tmpl : defaultTemplates) {
+const Doxybook2::DefaultTemplates& Doxybook2::getDefaultTemplates(const Config& config) {
+    if (config.outputFormat == OutputFormat::HTML) {
+        return config.htmlFragments ? defaultHtmlFragmentTemplates : defaultHtmlTemplates;
+    }
+    return defaultTemplates;
+}
+
+void Doxybook2::saveDefaultTemplates(const std::string& path, const DefaultTemplates& templates) {
+    for (const auto& tmpl : templates) {
         const auto tmplPath = Utils::join(path, tmpl.first + ".tmpl");
         spdlog::info("Creating default template {}", tmplPath);
         std::ofstream file(tmplPath);
@@ -3,10 +3,16 @@
 #include <Doxybook/Config.hpp>
 #include <Doxybook/Doxygen.hpp>
 #include <Doxybook/Exception.hpp>
+#include <Doxybook/LoadFilter.hpp>
 #include <Doxybook/Node.hpp>
+#include <Doxybook/NodeCache.hpp>
 #include <Doxybook/Path.hpp>
+#include <Doxybook/Progress.hpp>
 #include <Doxybook/Xml.hpp>
+#include <algorithm>
 #include <cassert>
+#include <fstream>
+#include <nlohmann/json.hpp>
 #include <set>
 #include <spdlog/spdlog.h>
 
@@ -43,16 +49,23 @@ static bool isKindAllowedExamples(const std::string& kind) {
     return kind == "example";
 }
 
-Doxybook2::Doxygen::Doxygen(const Config& config) : config(config), index(std::make_shared<Node>("index")) {
+static bool isKindAllowed(const std::string& kind) {
+    return isKindAllowedLanguage(kind) || isKindAllowedGroup(kind) || isKindAllowedDirs(kind) ||
+           isKindAllowedPages(kind) || isKindAllowedExamples(kind);
 }
 
-void Doxybook2::Doxygen::load(const std::string& inputDir) {
+Doxybook2::Doxygen::Doxygen(const Config& config)
+    : config(config), texts(std::make_unique<TextStore>()), index(std::make_shared<Node>("index")) {
+}
+
+void Doxybook2::Doxygen::load(const std::string& input) {
     // Remove entires from index which parent has been updated
     const auto cleanup = [](const NodePtr& node) {
-        auto it = node->children.begin();
-        while (it != node->children.end()) {
+        auto& children = node->getCompound().children;
+        auto it = children.begin();
+        while (it != children.end()) {
             if (it->get()->parent != node.get()) {
-                node->children.erase(it++);
+                children.erase(it++);
             } else {
                 ++it;
             }
@@ -62,17 +75,30 @@ void Doxybook2::Doxygen::load(const std::string& inputDir) {
     // Load basic information about all nodes.
     // This includes refid, brief, and list of members.
     // This won't load detailed documentation or other data! (we will do that later)
-    const auto kindRefidMap = getIndexKinds(inputDir);
+    source = std::make_unique<XmlSource>(input);
+    const auto kindRefidMap = getIndexKinds();
+
+    Progress progress("load",
+        std::count_if(kindRefidMap.begin(), kindRefidMap.end(), [](const KindRefidMap::value_type& pair) {
+            return isKindAllowed(pair.first);
+        }));
+
+    // The compounds created while loading, becomes the cache once loaded
+    NodeCache nodes;
+    const LoadFilter filter(config);
 
     // Then load basic information from all other nodes.
     for (const auto& pair : kindRefidMap) {
         if (!isKindAllowedLanguage(pair.first))
             continue;
+        progress.increment();
         try {
-            auto found = cache.find(pair.second);
-            if (found == cache.end()) {
-                index->children.push_back(Node::parse(cache, inputDir, pair.second, false));
-                auto child = index->children.back();
+            if (!nodes.find(pair.second) && !nodes.isRejected(pair.second)) {
+                auto child = Node::parse(nodes, *source, filter, pair.second, false);
+                if (!child) {
+                    continue;
+                }
+                index->getCompound().children.push_back(child);
                 if (child->parent == nullptr) {
                     child->parent = index.get();
                 }
@@ -87,11 +113,14 @@ void Doxybook2::Doxygen::load(const std::string& inputDir) {
     for (const auto& pair : kindRefidMap) {
         if (!isKindAllowedGroup(pair.first))
             continue;
+        progress.increment();
         try {
-            auto found = cache.find(pair.second);
-            if (found == cache.end()) {
-                index->children.push_back(Node::parse(cache, inputDir, pair.second, true));
-                auto child = index->children.back();
+            if (!nodes.find(pair.second) && !nodes.isRejected(pair.second)) {
+                auto child = Node::parse(nodes, *source, filter, pair.second, true);
+                if (!child) {
+                    continue;
+                }
+                index->getCompound().children.push_back(child);
                 if (child->parent == nullptr) {
                     child->parent = index.get();
                 }
@@ -106,11 +135,14 @@ void Doxybook2::Doxygen::load(const std::string& inputDir) {
     for (const auto& pair : kindRefidMap) {
         if (!isKindAllowedDirs(pair.first))
             continue;
+        progress.increment();
         try {
-            auto found = cache.find(pair.second);
-            if (found == cache.end()) {
-                index->children.push_back(Node::parse(cache, inputDir, pair.second, true));
-                auto child = index->children.back();
+            if (!nodes.find(pair.second) && !nodes.isRejected(pair.second)) {
+                auto child = Node::parse(nodes, *source, filter, pair.second, true);
+                if (!child) {
+                    continue;
+                }
+                index->getCompound().children.push_back(child);
                 if (child->parent == nullptr) {
                     child->parent = index.get();
                 }
@@ -125,11 +157,14 @@ void Doxybook2::Doxygen::load(const std::string& inputDir) {
     for (const auto& pair : kindRefidMap) {
         if (!isKindAllowedPages(pair.first))
             continue;
+        progress.increment();
         try {
-            auto found = cache.find(pair.second);
-            if (found == cache.end()) {
-                index->children.push_back(Node::parse(cache, inputDir, pair.second, true));
-                auto child = index->children.back();
+            if (!nodes.find(pair.second) && !nodes.isRejected(pair.second)) {
+                auto child = Node::parse(nodes, *source, filter, pair.second, true);
+                if (!child) {
+                    continue;
+                }
+                index->getCompound().children.push_back(child);
                 if (child->parent == nullptr) {
                     child->parent = index.get();
                 }
@@ -147,11 +182,14 @@ void Doxybook2::Doxygen::load(const std::string& inputDir) {
     for (const auto& pair : kindRefidMap) {
         if (!isKindAllowedExamples(pair.first))
             continue;
+        progress.increment();
         try {
-            auto found = cache.find(pair.second);
-            if (found == cache.end()) {
-                index->children.push_back(Node::parse(cache, inputDir, pair.second, true));
-                auto child = index->children.back();
+            if (!nodes.find(pair.second) && !nodes.isRejected(pair.second)) {
+                auto child = Node::parse(nodes, *source, filter, pair.second, true);
+                if (!child) {
+                    continue;
+                }
+                index->getCompound().children.push_back(child);
                 if (child->parent == nullptr) {
                     child->parent = index.get();
                 }
@@ -161,71 +199,161 @@ void Doxybook2::Doxygen::load(const std::string& inputDir) {
         }
     }
 
+    progress.finish();
+
+    cache = nodes.freeze();
     getIndexCache(cache, index);
 
     // Update group pointers
     updateGroupPointers(index);
+
+    // Combine the content hashes into the tree hashes
+    std::unordered_set<const Node*> visited;
+    hashRecursively(index, visited);
+}
+
+Doxybook2::Hash::Value Doxybook2::Doxygen::hashRecursively(const NodePtr& node,
+    std::unordered_set<const Node*>& visited) {
+    // The same node can be a child of multiple parents (class and group),
+    // compute the hash only once.
+    if (!visited.insert(node.get()).second) {
+        return node->hash;
+    }
+
+    Hash hash;
+    hash.update(node->contentHash);
+    for (const auto& child : node->getChildren()) {
+        hash.update(hashRecursively(child, visited));
+    }
+    node->hash = hash.get();
+    return node->hash;
 }
 
 void Doxybook2::Doxygen::updateGroupPointers(const NodePtr& node) {
     if (node->kind == Kind::MODULE) {
-        for (const auto& child : node->children) {
+        for (const auto& child : node->getChildren()) {
             child->group = node.get();
         }
     }
 
-    for (const auto& child : node->children) {
+    for (const auto& child : node->getChildren()) {
         if (child->kind == Kind::MODULE) {
             updateGroupPointers(child);
         }
     }
 }
 
-void Doxybook2::Doxygen::finalize(const TextPrinter& plainPrinter, const TextPrinter& markdownPrinter) {
-    finalizeRecursively(plainPrinter, markdownPrinter, index);
-}
+const Doxybook2::Node::Inherited& Doxybook2::Doxygen::inheritRecursively(Node& node,
+    std::unordered_set<const Node*>& visited) {
 
-void Doxybook2::Doxygen::finalizeRecursively(const TextPrinter& plainPrinter,
-    const TextPrinter& markdownPrinter,
-    const NodePtr& node) {
+    // Already done, or a cycle in the inheritance (broken xml), which ends here
+    if (!visited.insert(&node).second) {
+        return node.getInheritedMembers();
+    }
+
+    // The members of this class hide the base members with the same name
+    // and the ones they override
+    std::unordered_set<std::string> names;
+    std::unordered_set<std::string> overridden;
+    for (const auto& child : node.getChildren()) {
+        names.insert(child->name);
+        const auto& reimplements = child->getReimplements();
+        overridden.insert(reimplements.begin(), reimplements.end());
+    }
+
+    Node::Inherited inherited;
+    const auto add = [&](const Node* base, const std::vector<const Node*>& members) {
+        // The same base reached through multiple paths (diamond) is listed only once
+        for (const auto& existing : inherited) {
+            if (existing.base == base) {
+                return;
+            }
+        }
+        Node::InheritedMembers entry;
+        entry.base = base;
+        for (const auto* member : members) {
+            if (names.find(member->name) == names.end() && overridden.find(member->refid) == overridden.end()) {
+                entry.members.push_back(member);
+            }
+        }
+        if (!entry.members.empty()) {
+            inherited.push_back(std::move(entry));
+        }
+    };
+
+    // Only the direct bases, the rest comes from their own (memoized) tables
+    for (const auto& reference : node.getBaseClasses()) {
+        const auto it = cache.find(reference.refid);
+        if (it == cache.end() || it->second.get() == &node) {
+            continue;
+        }
+        auto& base = *it->second;
+        std::vector<const Node*> members;
+        for (const auto& child : base.getChildren()) {
+            members.push_back(child.get());
+        }
+        add(&base, members);
+        for (const auto& entry : inheritRecursively(base, visited)) {
+            add(entry.base, entry.members);
+        }
+    }
 
-    for (const auto& child : node->children) {
-        child->finalize(config, plainPrinter, markdownPrinter, cache);
-        finalizeRecursively(plainPrinter, markdownPrinter, child);
+    if (!inherited.empty()) {
+        node.getCompound().inherited = std::move(inherited);
     }
+    return node.getInheritedMembers();
 }
 
-Doxybook2::Doxygen::KindRefidMap Doxybook2::Doxygen::getIndexKinds(const std::string& inputDir) const {
-    const auto indexPath = Path::join(inputDir, "index.xml");
-    Xml xml(indexPath);
+void Doxybook2::Doxygen::finalize(const TextPrinter& plainPrinter, const TextPrinter& markdownPrinter) {
+    // Before the nodes are finalized, it needs the direct bases and the overrides parsed while loading
+    std::unordered_set<const Node*> visited;
+    for (const auto& pair : cache) {
+        if (pair.second->isStructured() && !pair.second->getBaseClasses().empty()) {
+            inheritRecursively(*pair.second, visited);
+        }
+    }
 
-    std::unordered_multimap<std::string, std::string> map;
+    Progress progress("finalize", cache.size());
+    finalizeRecursively(plainPrinter, markdownPrinter, index, progress);
+    progress.finish();
+    compressTexts();
+}
 
-    auto root = xml.firstChildElement("doxygenindex");
-    if (!root)
-        throw EXCEPTION("Unable to find root element in file {}", indexPath);
+void Doxybook2::Doxygen::compressTexts() {
+    if (!config.compressText) {
+        return;
+    }
+    const auto before = texts->getResidentSize();
+    texts->compress(static_cast<size_t>(std::max(config.compressTextMinLength, 0)));
+    spdlog::info("Compressed {} texts from {} to {} bytes", texts->getCount(), before, texts->getResidentSize());
+}
 
-    auto compound = root.firstChildElement("compound");
-    if (!compound)
-        throw EXCEPTION("No <compound> element in file {}", indexPath);
-    while (compound) {
-        try {
-            const auto kind = compound.getAttr("kind");
-            const auto refid = compound.getAttr("refid");
-            assert(!refid.empty());
-            map.insert(std::make_pair(kind, refid));
+void Doxybook2::Doxygen::finalizeRecursively(const TextPrinter& plainPrinter,
+    const TextPrinter& markdownPrinter,
+    const NodePtr& node,
+    Progress& progress) {
 
-        } catch (std::exception& e) {
-            spdlog::warn("compound error {}", e.what());
+    for (const auto& child : node->getChildren()) {
+        // The same node can be visited through multiple parents, count it only once
+        if (child->temp) {
+            progress.increment();
         }
-        compound = compound.nextSiblingElement("compound");
+        child->finalize(config, plainPrinter, markdownPrinter, cache, *texts);
+        finalizeRecursively(plainPrinter, markdownPrinter, child, progress);
     }
+}
 
+Doxybook2::Doxygen::KindRefidMap Doxybook2::Doxygen::getIndexKinds() const {
+    std::unordered_multimap<std::string, std::string> map;
+    source->allCompounds([&](const std::string& kind, const std::string& refid) {
+        assert(!refid.empty());
+        map.insert(std::make_pair(kind, refid));
+    });
     return map;
 }
 
 void Doxybook2::Doxygen::getIndexCache(NodeCacheMap& cache, const NodePtr& parent) const {
-    for (const auto& child : parent->children) {
+    for (const auto& child : parent->getChildren()) {
         cache.insert(std::make_pair(child->refid, child));
         getIndexCache(cache, child);
     }
@@ -239,3 +367,204 @@ Doxybook2::NodePtr Doxybook2::Doxygen::find(const std::string& refid) const {
         throw EXCEPTION("Failed to find node from cache by refid {}", refid);
     }
 }
+
+static nlohmann::json classReferencesToSnapshot(const Doxybook2::Node::ClassReferences& references,
+    const std::unordered_map<const Doxybook2::Node*, int64_t>& indexes) {
+    auto json = nlohmann::json::array();
+    for (const auto& reference : references) {
+        const auto it = indexes.find(reference.ptr);
+        json.push_back({
+            {"name", reference.name},
+            {"refid", reference.refid},
+            {"prot", static_cast<int>(reference.prot)},
+            {"virt", static_cast<int>(reference.virt)},
+            {"ptr", it != indexes.end() ? it->second : int64_t(-1)},
+        });
+    }
+    return json;
+}
+
+static Doxybook2::Node::ClassReferences classReferencesFromSnapshot(const nlohmann::json& json,
+    const std::vector<Doxybook2::NodePtr>& nodes) {
+    Doxybook2::Node::ClassReferences references;
+    for (const auto& item : json) {
+        Doxybook2::Node::ClassReference reference;
+        reference.name = item.at("name").get<std::string>();
+        reference.refid = item.at("refid").get<std::string>();
+        reference.prot = static_cast<Doxybook2::Visibility>(item.at("prot").get<int>());
+        reference.virt = static_cast<Doxybook2::Virtual>(item.at("virt").get<int>());
+        const auto ptr = item.at("ptr").get<int64_t>();
+        reference.ptr = ptr >= 0 ? nodes.at(ptr).get() : nullptr;
+        references.push_back(std::move(reference));
+    }
+    return references;
+}
+
+void Doxybook2::Doxygen::saveSnapshot(const std::string& path) const {
+    // Each node is stored once, the tree, the cache and the pointers refer to the position of the node
+    std::unordered_map<const Node*, int64_t> indexes;
+    std::vector<const Node*> nodes;
+    const auto add = [&](const Node* node) {
+        if (node != nullptr && indexes.emplace(node, static_cast<int64_t>(nodes.size())).second) {
+            nodes.push_back(node);
+        }
+    };
+    add(index.get());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        for (const auto& child : nodes[i]->getChildren()) {
+            add(child.get());
+        }
+    }
+    for (const auto& pair : cache) {
+        add(pair.second.get());
+    }
+
+    const auto indexOf = [&](const Node* node) -> int64_t {
+        const auto it = indexes.find(node);
+        return it != indexes.end() ? it->second : -1;
+    };
+
+    auto array = nlohmann::json::array();
+    for (const auto* node : nodes) {
+        nlohmann::json json = {
+            {"refid", node->refid},
+            {"kind", static_cast<int>(node->kind)},
+            {"type", static_cast<int>(node->type)},
+            {"language", *node->language},
+            {"name", node->name},
+            {"brief", node->getBrief()},
+            {"summary", node->getSummary()},
+            {"parent", indexOf(node->parent)},
+            {"group", indexOf(node->group)},
+            {"empty", node->empty},
+            {"visibility", static_cast<int>(node->visibility)},
+            {"virt", static_cast<int>(node->virt)},
+            {"url", node->url},
+            {"anchor", node->anchor},
+            {"contentHash", node->contentHash},
+            {"hash", node->hash},
+        };
+        if (node->compound) {
+            auto children = nlohmann::json::array();
+            for (const auto& child : node->compound->children) {
+                children.push_back(indexOf(child.get()));
+            }
+            json["compound"] = {
+                {"children", std::move(children)},
+                {"title", node->compound->title},
+                {"xmlPath", node->compound->xmlPath},
+                {"source", node->compound->source != nullptr},
+                {"baseClasses", classReferencesToSnapshot(node->compound->baseClasses, indexes)},
+                {"derivedClasses", classReferencesToSnapshot(node->compound->derivedClasses, indexes)},
+            };
+            if (!node->compound->inherited.empty()) {
+                auto inherited = nlohmann::json::array();
+                for (const auto& entry : node->compound->inherited) {
+                    auto members = nlohmann::json::array();
+                    for (const auto* member : entry.members) {
+                        members.push_back(indexOf(member));
+                    }
+                    inherited.push_back({{"base", indexOf(entry.base)}, {"members", std::move(members)}});
+                }
+                json["compound"]["inherited"] = std::move(inherited);
+            }
+        }
+        array.push_back(std::move(json));
+    }
+
+    nlohmann::json cacheJson = nlohmann::json::object();
+    for (const auto& pair : cache) {
+        cacheJson[pair.first] = indexOf(pair.second.get());
+    }
+
+    const auto bytes = nlohmann::json::to_cbor({{"nodes", std::move(array)}, {"cache", std::move(cacheJson)}});
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        throw EXCEPTION("Failed to open file {} for writing", path);
+    }
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+void Doxybook2::Doxygen::loadSnapshot(const std::string& input, const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw EXCEPTION("Failed to open file {} for reading", path);
+    }
+    const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    nlohmann::json json;
+    try {
+        json = nlohmann::json::from_cbor(bytes);
+    } catch (std::exception& e) {
+        throw EXCEPTION("Failed to parse snapshot {} error {}", path, e.what());
+    }
+
+    source = std::make_unique<XmlSource>(input);
+    texts = std::make_unique<TextStore>();
+
+    const auto& array = json.at("nodes");
+    std::vector<NodePtr> nodes;
+    nodes.reserve(array.size());
+    for (const auto& item : array) {
+        nodes.push_back(std::make_shared<Node>(item.at("refid").get<std::string>()));
+        // Already finalized
+        nodes.back()->releaseTemp();
+    }
+
+    const auto nodeAt = [&](const nlohmann::json& value) -> Node* {
+        const auto i = value.get<int64_t>();
+        return i >= 0 ? nodes.at(i).get() : nullptr;
+    };
+
+    for (size_t i = 0; i < nodes.size(); i++) {
+        const auto& item = array[i];
+        auto& node = *nodes[i];
+        node.kind = static_cast<Kind>(item.at("kind").get<int>());
+        node.type = static_cast<Type>(item.at("type").get<int>());
+        node.language = Node::internLanguage(item.at("language").get<std::string>());
+        node.name = item.at("name").get<std::string>();
+        node.texts = texts.get();
+        node.brief = texts->add(item.at("brief").get<std::string>());
+        node.summary = texts->add(item.at("summary").get<std::string>());
+        node.parent = nodeAt(item.at("parent"));
+        node.group = nodeAt(item.at("group"));
+        node.empty = item.at("empty").get<bool>();
+        node.visibility = static_cast<Visibility>(item.at("visibility").get<int>());
+        node.virt = static_cast<Virtual>(item.at("virt").get<int>());
+        node.url = item.at("url").get<std::string>();
+        node.anchor = item.at("anchor").get<std::string>();
+        node.contentHash = item.at("contentHash").get<Hash::Value>();
+        node.hash = item.at("hash").get<Hash::Value>();
+
+        if (item.contains("compound")) {
+            const auto& compound = item.at("compound");
+            node.compound = std::make_unique<Node::Compound>();
+            for (const auto& child : compound.at("children")) {
+                node.compound->children.push_back(nodes.at(child.get<int64_t>()));
+            }
+            node.compound->title = compound.at("title").get<std::string>();
+            node.compound->xmlPath = compound.at("xmlPath").get<std::string>();
+            node.compound->source = compound.at("source").get<bool>() ? source.get() : nullptr;
+            node.compound->baseClasses = classReferencesFromSnapshot(compound.at("baseClasses"), nodes);
+            node.compound->derivedClasses = classReferencesFromSnapshot(compound.at("derivedClasses"), nodes);
+            if (compound.contains("inherited")) {
+                for (const auto& entry : compound.at("inherited")) {
+                    Node::InheritedMembers inherited;
+                    inherited.base = nodeAt(entry.at("base"));
+                    for (const auto& member : entry.at("members")) {
+                        inherited.members.push_back(nodeAt(member));
+                    }
+                    node.compound->inherited.push_back(std::move(inherited));
+                }
+            }
+        }
+    }
+
+    index = nodes.at(0);
+    cache.clear();
+    for (const auto& pair : json.at("cache").items()) {
+        cache.insert(std::make_pair(pair.key(), nodes.at(pair.value().get<int64_t>())));
+    }
+
+    compressTexts();
+}
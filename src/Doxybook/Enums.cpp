@@ -1,6 +1,7 @@
 #include "ExceptionUtils.hpp"
 #include <Doxybook/Config.hpp>
 #include <Doxybook/Enums.hpp>
+#include <Doxybook/Hash.hpp>
 #include <unordered_map>
 
 using KindStrPair = std::pair<std::string, Doxybook2::Kind>;
@@ -8,6 +9,8 @@ using TypeStrPair = std::pair<std::string, Doxybook2::Type>;
 using VirtualStrPair = std::pair<std::string, Doxybook2::Virtual>;
 using VisibilityStrPair = std::pair<std::string, Doxybook2::Visibility>;
 using FolderCategoryStrPair = std::pair<std::string, Doxybook2::FolderCategory>;
+using OutputFormatStrPair = std::pair<std::string, Doxybook2::OutputFormat>;
+using SourceListingStrPair = std::pair<std::string, Doxybook2::SourceListing>;
 
 // clang-format off
 static const std::vector<KindStrPair> KIND_STRS = {
@@ -76,6 +79,17 @@ static const std::vector<FolderCategoryStrPair> FOLDER_CATEGORY_STRS = {
     {"classes", Doxybook2::FolderCategory::CLASSES},
     {"pages", Doxybook2::FolderCategory::PAGES}
 };
+
+static const std::vector<OutputFormatStrPair> OUTPUT_FORMAT_STRS = {
+    {"markdown", Doxybook2::OutputFormat::MARKDOWN},
+    {"html", Doxybook2::OutputFormat::HTML}
+};
+
+static const std::vector<SourceListingStrPair> SOURCE_LISTING_STRS = {
+    {"inline", Doxybook2::SourceListing::INLINE},
+    {"none", Doxybook2::SourceListing::NONE},
+    {"file", Doxybook2::SourceListing::FILE}
+};
 // clang-format on
 
 template <typename Enum> struct EnumName { static inline const auto name = "unknown"; };
@@ -85,6 +99,8 @@ template <> struct EnumName<Doxybook2::Type> { static inline const auto name = "
 template <> struct EnumName<Doxybook2::Virtual> { static inline const auto name = "Virtual"; };
 template <> struct EnumName<Doxybook2::Visibility> { static inline const auto name = "Visibility"; };
 template <> struct EnumName<Doxybook2::FolderCategory> { static inline const auto name = "FolderCategory"; };
+template <> struct EnumName<Doxybook2::OutputFormat> { static inline const auto name = "OutputFormat"; };
+template <> struct EnumName<Doxybook2::SourceListing> { static inline const auto name = "SourceListing"; };
 
 template <typename Enum>
 static Enum toEnum(const std::vector<std::pair<std::string, Enum>>& pairs, const std::string& str) {
@@ -151,6 +167,22 @@ std::string Doxybook2::toStr(const FolderCategory value) {
     return fromEnum<FolderCategory>(FOLDER_CATEGORY_STRS, value);
 }
 
+Doxybook2::OutputFormat Doxybook2::toEnumOutputFormat(const std::string& str) {
+    return toEnum<OutputFormat>(OUTPUT_FORMAT_STRS, str);
+}
+
+std::string Doxybook2::toStr(const OutputFormat value) {
+    return fromEnum<OutputFormat>(OUTPUT_FORMAT_STRS, value);
+}
+
+Doxybook2::SourceListing Doxybook2::toEnumSourceListing(const std::string& str) {
+    return toEnum<SourceListing>(SOURCE_LISTING_STRS, str);
+}
+
+std::string Doxybook2::toStr(const SourceListing value) {
+    return fromEnum<SourceListing>(SOURCE_LISTING_STRS, value);
+}
+
 Doxybook2::Type Doxybook2::kindToType(const Doxybook2::Kind kind) {
     switch (kind) {
         case Kind::DEFINE: {
@@ -326,6 +358,19 @@ std::string Doxybook2::typeToFolderName(const Config& config, const Type type) {
     }
 }
 
+std::string Doxybook2::shardFolderName(const Config& config, const std::string& name) {
+    if (!config.useFolders || config.folderShardLength <= 0)
+        return "";
+
+    const auto length = std::min<size_t>(config.folderShardLength, sizeof(Hash::Value) * 2);
+    return Hash::toHex(Hash::of(name)).substr(0, length);
+}
+
+std::string Doxybook2::shardPath(const Config& config, const std::string& name) {
+    const auto shard = shardFolderName(config, name);
+    return shard.empty() ? name : shard + "/" + name;
+}
+
 std::string Doxybook2::typeToIndexName(const Config& config, const FolderCategory type) {
     switch (type) {
         case FolderCategory::MODULES: {
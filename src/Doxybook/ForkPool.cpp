@@ -0,0 +1,360 @@
+#include "ExceptionUtils.hpp"
+#include <Doxybook/Exception.hpp>
+#include <Doxybook/ForkPool.hpp>
+#include <algorithm>
+#include <spdlog/spdlog.h>
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+Doxybook2::ForkPool::ForkPool(const size_t workers, const size_t batchSize)
+    : workers(std::max<size_t>(workers, 1)), batchSize(std::max<size_t>(batchSize, 1)) {
+}
+
+#ifdef _WIN32
+
+bool Doxybook2::ForkPool::isSupported() {
+    return false;
+}
+
+std::vector<size_t> Doxybook2::ForkPool::run(const size_t count, const Worker& worker, const Callback& callback) {
+    throw EXCEPTION("Running jobs in forked processes is not supported on this platform");
+}
+
+#else
+
+// A result frame: job number and length (uint64_t each), status (uint8_t), then the result itself
+static const size_t FRAME_HEADER_SIZE = sizeof(uint64_t) * 2 + 1;
+static const uint8_t STATUS_OK = 0;
+static const uint8_t STATUS_ERROR = 1;
+
+namespace {
+    struct Process {
+        pid_t pid{-1};
+        // Write end, the batches are sent as the count followed by the job numbers (uint64_t each)
+        int jobs{-1};
+        // Read end, the frames with the results
+        int results{-1};
+        std::vector<size_t> batch;
+        size_t received{0};
+        std::string buffer;
+    };
+} // namespace
+
+static bool writeAll(const int fd, const void* data, size_t size) {
+    const auto* ptr = static_cast<const char*>(data);
+    while (size > 0) {
+        const auto n = ::write(fd, ptr, size);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        ptr += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+static bool readAll(const int fd, void* data, size_t size) {
+    auto* ptr = static_cast<char*>(data);
+    while (size > 0) {
+        const auto n = ::read(fd, ptr, size);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        if (n == 0) {
+            return false;
+        }
+        ptr += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+[[noreturn]] static void workerMain(const int jobs, const int results, const Doxybook2::ForkPool::Worker& worker) {
+    // Until the parent sends an empty batch or goes away
+    for (;;) {
+        uint64_t count = 0;
+        if (!readAll(jobs, &count, sizeof(count)) || count == 0) {
+            break;
+        }
+        std::vector<uint64_t> batch(count);
+        if (!readAll(jobs, batch.data(), batch.size() * sizeof(uint64_t))) {
+            break;
+        }
+
+        for (const auto job : batch) {
+            auto status = STATUS_OK;
+            std::string result;
+            try {
+                result = worker(static_cast<size_t>(job));
+            } catch (std::exception& e) {
+                status = STATUS_ERROR;
+                result = e.what();
+            }
+
+            const uint64_t header[2] = {job, result.size()};
+            if (!writeAll(results, header, sizeof(header)) || !writeAll(results, &status, sizeof(status)) ||
+                !writeAll(results, result.data(), result.size())) {
+                ::_exit(1);
+            }
+        }
+    }
+    // Skips the destructors and the atexit handlers, those belong to the parent
+    ::_exit(0);
+}
+
+static Process spawn(const std::vector<Process>& others, const Doxybook2::ForkPool::Worker& worker) {
+    int jobs[2];
+    int results[2];
+    if (::pipe(jobs) != 0) {
+        throw EXCEPTION("Failed to create a pipe error {}", std::strerror(errno));
+    }
+    if (::pipe(results) != 0) {
+        const auto error = errno;
+        ::close(jobs[0]);
+        ::close(jobs[1]);
+        throw EXCEPTION("Failed to create a pipe error {}", std::strerror(error));
+    }
+
+    const auto pid = ::fork();
+    if (pid < 0) {
+        const auto error = errno;
+        for (const auto fd : {jobs[0], jobs[1], results[0], results[1]}) {
+            ::close(fd);
+        }
+        throw EXCEPTION("Failed to fork a worker process error {}", std::strerror(error));
+    }
+
+    if (pid == 0) {
+        // A crash ends the worker right away, the handlers installed by the parent are not for it
+        for (const auto sig : {SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL}) {
+            std::signal(sig, SIG_DFL);
+        }
+        ::close(jobs[1]);
+        ::close(results[0]);
+        // Otherwise the other workers would not see their pipes closed by the parent
+        for (const auto& other : others) {
+            if (other.pid > 0) {
+                ::close(other.jobs);
+                ::close(other.results);
+            }
+        }
+        workerMain(jobs[0], results[1], worker);
+    }
+
+    ::close(jobs[0]);
+    ::close(results[1]);
+    Process process;
+    process.pid = pid;
+    process.jobs = jobs[1];
+    process.results = results[0];
+    return process;
+}
+
+// Closes the pipes and waits for the worker, returns its wait status
+static int stop(Process& process) {
+    ::close(process.jobs);
+    ::close(process.results);
+    int status = 0;
+    while (::waitpid(process.pid, &status, 0) < 0 && errno == EINTR) {
+    }
+    process.pid = -1;
+    return status;
+}
+
+bool Doxybook2::ForkPool::isSupported() {
+    return true;
+}
+
+std::vector<size_t> Doxybook2::ForkPool::run(const size_t count, const Worker& worker, const Callback& callback) {
+    std::deque<std::vector<size_t>> batches;
+    for (size_t i = 0; i < count; i += batchSize) {
+        std::vector<size_t> batch;
+        for (size_t job = i; job < std::min(i + batchSize, count); job++) {
+            batch.push_back(job);
+        }
+        batches.push_back(std::move(batch));
+    }
+
+    std::vector<uint8_t> attempts(count, 0);
+    std::vector<size_t> lost;
+    std::string error;
+
+    const auto assign = [&](Process& process) {
+        process.batch.clear();
+        process.received = 0;
+        if (batches.empty() || !error.empty()) {
+            return;
+        }
+        process.batch = std::move(batches.front());
+        batches.pop_front();
+
+        std::vector<uint64_t> message;
+        message.push_back(process.batch.size());
+        for (const auto job : process.batch) {
+            message.push_back(job);
+            attempts[job]++;
+        }
+        // If the worker is gone, it shows up as the end of its results
+        writeAll(process.jobs, message.data(), message.size() * sizeof(uint64_t));
+    };
+
+    // Handles the results received so far, returns false if the worker is gone
+    const auto receive = [&](Process& process) -> bool {
+        char chunk[64 * 1024];
+        const auto n = ::read(process.results, chunk, sizeof(chunk));
+        if (n < 0) {
+            return errno == EINTR || errno == EAGAIN;
+        }
+        if (n == 0) {
+            return false;
+        }
+        process.buffer.append(chunk, static_cast<size_t>(n));
+
+        size_t offset = 0;
+        while (process.buffer.size() - offset >= FRAME_HEADER_SIZE) {
+            uint64_t header[2];
+            uint8_t status;
+            std::memcpy(header, process.buffer.data() + offset, sizeof(header));
+            std::memcpy(&status, process.buffer.data() + offset + sizeof(header), sizeof(status));
+            if (process.buffer.size() - offset - FRAME_HEADER_SIZE < header[1]) {
+                break;
+            }
+            auto result = process.buffer.substr(offset + FRAME_HEADER_SIZE, header[1]);
+            offset += FRAME_HEADER_SIZE + header[1];
+            process.received++;
+
+            if (status != STATUS_OK) {
+                if (error.empty()) {
+                    error = std::move(result);
+                }
+            } else {
+                callback(static_cast<size_t>(header[0]), std::move(result));
+            }
+        }
+        process.buffer.erase(0, offset);
+
+        if (process.received == process.batch.size()) {
+            assign(process);
+        }
+        return true;
+    };
+
+    // A crashed worker closes its end of the pipe, writing to it must not kill this process
+    const auto previous = std::signal(SIGPIPE, SIG_IGN);
+    std::vector<Process> processes;
+
+    try {
+        const auto total = std::min(workers, batches.size());
+        processes.reserve(total);
+        for (size_t i = 0; i < total; i++) {
+            processes.push_back(spawn(processes, worker));
+            assign(processes.back());
+        }
+
+        for (;;) {
+            std::vector<pollfd> fds;
+            std::vector<Process*> busy;
+            for (auto& process : processes) {
+                if (process.pid > 0 && !process.batch.empty()) {
+                    fds.push_back({process.results, POLLIN, 0});
+                    busy.push_back(&process);
+                }
+            }
+            if (fds.empty()) {
+                break;
+            }
+
+            if (::poll(fds.data(), fds.size(), -1) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw EXCEPTION("Failed to wait for the worker processes error {}", std::strerror(errno));
+            }
+
+            for (size_t i = 0; i < fds.size(); i++) {
+                if (fds[i].revents == 0) {
+                    continue;
+                }
+                auto& process = *busy[i];
+                if (receive(process)) {
+                    continue;
+                }
+
+                // Gone before finishing the batch
+                const auto pid = process.pid;
+                const auto status = stop(process);
+                const auto remaining = process.batch.size() - process.received;
+                if (WIFSIGNALED(status)) {
+                    spdlog::error("Worker process {} killed by signal {} ({}), {} jobs unfinished",
+                        pid,
+                        WTERMSIG(status),
+                        ::strsignal(WTERMSIG(status)),
+                        remaining);
+                } else {
+                    spdlog::error("Worker process {} exited with status {}, {} jobs unfinished",
+                        pid,
+                        WEXITSTATUS(status),
+                        remaining);
+                }
+
+                // Tried once more alone, so that a second crash points at the job itself
+                for (auto j = process.received; j < process.batch.size(); j++) {
+                    const auto job = process.batch[j];
+                    if (attempts[job] < 2) {
+                        batches.push_back({job});
+                    } else {
+                        lost.push_back(job);
+                    }
+                }
+                process.batch.clear();
+                process.buffer.clear();
+
+                // Forked again from this process, the model here is still intact
+                if (!batches.empty() && error.empty()) {
+                    process = spawn(processes, worker);
+                    assign(process);
+                }
+            }
+        }
+    } catch (...) {
+        for (auto& process : processes) {
+            if (process.pid > 0) {
+                ::kill(process.pid, SIGKILL);
+                stop(process);
+            }
+        }
+        std::signal(SIGPIPE, previous);
+        throw;
+    }
+
+    for (auto& process : processes) {
+        if (process.pid > 0) {
+            const uint64_t quit = 0;
+            writeAll(process.jobs, &quit, sizeof(quit));
+            stop(process);
+        }
+    }
+    std::signal(SIGPIPE, previous);
+
+    if (!error.empty()) {
+        throw Exception(error);
+    }
+    std::sort(lost.begin(), lost.end());
+    return lost;
+}
+
+#endif
@@ -1,11 +1,15 @@
 #include "ExceptionUtils.hpp"
 #include <Doxybook/Doxygen.hpp>
 #include <Doxybook/Exception.hpp>
+#include <Doxybook/ForkPool.hpp>
 #include <Doxybook/Generator.hpp>
 #include <Doxybook/Path.hpp>
 #include <Doxybook/Renderer.hpp>
+#include <Doxybook/SymbolIndex.hpp>
 #include <Doxybook/Utils.hpp>
 #include <inja/inja.hpp>
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <spdlog/spdlog.h>
@@ -42,9 +46,13 @@ std::string Doxybook2::Generator::kindToTemplateName(const Kind kind) {
 Doxybook2::Generator::Generator(const Config& config,
     const Doxygen& doxygen,
     const JsonConverter& jsonConverter,
+    Output& output,
     const std::optional<std::string>& templatesPath)
-    : config(config), doxygen(doxygen), jsonConverter(jsonConverter),
-      renderer(config, doxygen, jsonConverter, templatesPath) {
+    : config(config), doxygen(doxygen), jsonConverter(jsonConverter), output(output),
+      renderer(config, doxygen, jsonConverter, output, templatesPath) {
+    if (config.renderProcesses > 0 && !ForkPool::isSupported()) {
+        spdlog::warn("Rendering in multiple processes is not supported on this platform, using the pipeline");
+    }
 }
 
 void Doxybook2::Generator::summary(const std::string& inputFile,
@@ -116,74 +124,288 @@ void Doxybook2::Generator::summaryRecursive(std::stringstream& ss,
         if (filter.find(child->getKind()) != filter.end()) {
             if (skip.find(child->getKind()) == skip.end() && shouldInclude(*child)) {
                 ss << std::string(indent, ' ') << "* [" << child->getName() << "](" << folderName << "/"
-                   << child->getRefid() << ".md)\n";
+                   << shardPath(config, child->getRefid()) << ".md)\n";
             }
             summaryRecursive(ss, indent, folderName, *child, filter, skip);
         }
     }
 }
 
-void Doxybook2::Generator::printRecursively(const Node& parent, const Filter& filter, const Filter& skip) {
+void Doxybook2::Generator::run(const std::function<void(std::vector<Page>&)>& producer) {
+    // Collect the pages first, so that the progress knows the total
+    std::vector<Page> pages;
+    producer(pages);
+
+    // Written by the run that has been interrupted
+    if (checkpoint != nullptr) {
+        const auto total = pages.size();
+        pages.erase(std::remove_if(pages.begin(),
+                        pages.end(),
+                        [&](const Page& page) { return checkpoint->isDone(page.path); }),
+            pages.end());
+        if (pages.size() != total) {
+            spdlog::info("Skipping {} pages found in the checkpoint", total - pages.size());
+        }
+    }
+
+    // The model is loaded and finalized by now, the workers share it copy-on-write
+    const auto forked = config.renderProcesses > 0 && ForkPool::isSupported();
+    Progress progress("render", pages.size());
+    const auto result = forked ? runForked(pages, progress) : runPipeline(pages, progress);
+    progress.finish();
+
+    if (stats.empty()) {
+        stats = result;
+        return;
+    }
+    for (size_t i = 0; i < stats.size(); i++) {
+        stats[i].processed += result[i].processed;
+        stats[i].maxQueueDepth = std::max(stats[i].maxQueueDepth, result[i].maxQueueDepth);
+        stats[i].busySeconds += result[i].busySeconds;
+    }
+}
+
+Doxybook2::PipelineStats Doxybook2::Generator::runPipeline(std::vector<Page>& pages, Progress& progress) {
+    Pipeline<Page> pipeline(config.pipelineQueueSize, scheduler);
+    pipeline.addStage("convert", config.pipelineConvertThreads, [this](Page& page) { convertPage(page); });
+    pipeline.addStage("render", config.pipelineRenderThreads, [this](Page& page) { renderPage(page); });
+    // Finished pages go first, they hold the most memory
+    pipeline.addStage(
+        "write",
+        config.pipelineWriteThreads,
+        [this, &progress](Page& page) {
+            writePage(page);
+            progress.increment();
+        },
+        Scheduler::Priority::HIGH);
+
+    for (auto& page : pages) {
+        pipeline.push(std::move(page));
+    }
+    return pipeline.finish();
+}
+
+Doxybook2::PipelineStats Doxybook2::Generator::runForked(std::vector<Page>& pages, Progress& progress) {
+    typedef std::chrono::duration<double> Seconds;
+    const auto workers = static_cast<size_t>(config.renderProcesses);
+    PipelineStats result(3);
+    result[0].name = "convert";
+    result[0].threads = workers;
+    result[1].name = "render";
+    result[1].threads = workers;
+    result[2].name = "write";
+    result[2].threads = 1;
+
+    // Runs in the worker, on its own copy of the pages
+    const auto worker = [&](const size_t job) -> std::string {
+        auto& page = pages[job];
+        const auto violations = renderViolations.size();
+        const auto hashed = hashes ? hashes->getCount() : 0;
+        const auto start = std::chrono::steady_clock::now();
+        convertPage(page);
+        const auto converted = std::chrono::steady_clock::now();
+        renderPage(page);
+        const auto rendered = std::chrono::steady_clock::now();
+
+        nlohmann::json json = {
+            {"contents", std::move(page.contents)},
+            {"listing", std::move(page.listing)},
+            {"listingPath", std::move(page.listingPath)},
+            {"skip", page.skip},
+            {"convertSeconds", Seconds(converted - start).count()},
+            {"renderSeconds", Seconds(rendered - converted).count()},
+        };
+        if (config.debugTemplateJson && !page.templateName.empty()) {
+            json["data"] = std::move(page.data);
+        }
+        auto violationsJson = nlohmann::json::array();
+        for (auto i = violations; i < renderViolations.size(); i++) {
+            const auto& violation = renderViolations[i];
+            violationsJson.push_back({violation.refid, violation.templateName, violation.reason});
+        }
+        json["violations"] = std::move(violationsJson);
+        if (hashes) {
+            // The images copied by the text printers of this process
+            auto hashesJson = nlohmann::json::array();
+            for (const auto& [path, hash] : hashes->getSince(hashed)) {
+                hashesJson.push_back({path, hash});
+            }
+            json["hashes"] = std::move(hashesJson);
+        }
+
+        // The page is done, this copy is not needed anymore
+        page = Page{};
+        const auto bytes = nlohmann::json::to_cbor(json);
+        return std::string(bytes.begin(), bytes.end());
+    };
+
+    // Runs here, in the order the pages are done
+    const auto callback = [&](const size_t job, std::string data) {
+        const auto json = nlohmann::json::from_cbor(data);
+        auto& page = pages[job];
+        page.contents = json.at("contents").get<std::string>();
+        page.listing = json.at("listing").get<std::string>();
+        page.listingPath = json.at("listingPath").get<std::string>();
+        page.skip = json.at("skip").get<bool>();
+        if (json.contains("data")) {
+            page.data = json.at("data");
+        }
+        for (const auto& violation : json.at("violations")) {
+            std::lock_guard<std::mutex> lock(renderViolationsMutex);
+            renderViolations.push_back({violation.at(0).get<std::string>(),
+                violation.at(1).get<std::string>(),
+                violation.at(2).get<std::string>()});
+        }
+        if (hashes && json.contains("hashes")) {
+            for (const auto& entry : json.at("hashes")) {
+                hashes->add(entry.at(0).get<std::string>(), entry.at(1).get<Hash::Value>());
+            }
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        writePage(page);
+        result[2].busySeconds += Seconds(std::chrono::steady_clock::now() - start).count();
+        result[0].busySeconds += json.at("convertSeconds").get<double>();
+        result[1].busySeconds += json.at("renderSeconds").get<double>();
+        for (auto& stage : result) {
+            stage.processed++;
+        }
+        page = Page{};
+        progress.increment();
+    };
+
+    ForkPool pool(workers, static_cast<size_t>(std::max(config.renderProcessBatchSize, 1)));
+    const auto lost = pool.run(pages.size(), worker, callback);
+    if (!lost.empty()) {
+        for (const auto job : lost) {
+            spdlog::error("Page {} crashed the worker process rendering it", pages[job].path);
+        }
+        throw EXCEPTION("Failed to render {} pages, their worker processes crashed", lost.size());
+    }
+    return result;
+}
+
+void Doxybook2::Generator::convertPage(Page& page) const {
+    // Loads the XML of the page and converts it into JSON
+    page.data = jsonConverter.getAsJson(*page.node);
+    if (config.sourceListing == SourceListing::FILE) {
+        extractListing(page);
+    }
+}
+
+void Doxybook2::Generator::renderPage(Page& page) {
+    if (page.templateName.empty()) {
+        page.contents = page.data.dump(2);
+    } else {
+        try {
+            page.contents = renderer.render(page.templateName, page.data);
+        } catch (RenderLimitException& e) {
+            page.contents = renderLimitExceeded(page.node->getRefid(), page.node->getTitle(), e);
+            page.skip = page.contents.empty();
+        }
+    }
+}
+
+void Doxybook2::Generator::writePage(const Page& page) {
+    if (page.skip) {
+        return;
+    }
+    if (config.debugTemplateJson && !page.templateName.empty()) {
+        output.write(page.path + ".json", page.data.dump(2));
+    }
+    spdlog::debug("Rendering {}", Path::join(config.outputDir, page.path));
+    output.write(page.path, page.contents);
+    if (!page.listingPath.empty()) {
+        output.write(page.listingPath, page.listing);
+    }
+}
+
+void Doxybook2::Generator::extractListing(Page& page) const {
+    const auto it = page.data.find("programlisting");
+    if (it == page.data.end()) {
+        return;
+    }
+
+    // Keeps the extension of the source file, "_engine_8hpp.source.hpp"
+    const auto path = std::filesystem::path(page.path);
+    const auto file =
+        path.stem().string() + ".source" + std::filesystem::path(page.node->getName()).extension().string();
+    page.listing = std::move(it->get_ref<std::string&>());
+    page.listingPath = path.has_parent_path() ? Path::join(path.parent_path().string(), file) : file;
+    page.data.erase(it);
+    page.data["programlistingFile"] = file;
+}
+
+void Doxybook2::Generator::printRecursively(std::vector<Page>& pages,
+    const Node& parent,
+    const Filter& filter,
+    const Filter& skip) {
     for (const auto& child : parent.getChildren()) {
         if (filter.find(child->getKind()) != filter.end()) {
             if (skip.find(child->getKind()) == skip.end() && shouldInclude(*child)) {
-                nlohmann::json data = jsonConverter.getAsJson(*child);
-
                 std::string path;
                 if (child->getKind() == Kind::PAGE && child->getRefid() == config.mainPageName) {
                     path = child->getRefid() + "." + config.fileExt;
                 } else if (config.useFolders) {
-                    path = Path::join(
-                        typeToFolderName(config, child->getType()), child->getRefid() + "." + config.fileExt);
+                    const auto folder = typeToFolderName(config, child->getType());
+                    const auto shard = shardFolderName(config, child->getRefid());
+                    const auto file = child->getRefid() + "." + config.fileExt;
+                    path = shard.empty() ? Path::join(folder, file) : Path::join(folder, shard, file);
                 } else {
                     path = child->getRefid() + "." + config.fileExt;
                 }
 
-                renderer.render(kindToTemplateName(child->getKind()), path, data);
+                Page page;
+                page.node = child.get();
+                page.path = std::move(path);
+                page.templateName = kindToTemplateName(child->getKind());
+                pages.push_back(std::move(page));
             }
-            printRecursively(*child, filter, skip);
+            printRecursively(pages, *child, filter, skip);
         }
     }
 }
 
-void Doxybook2::Generator::jsonRecursively(const Node& parent, const Filter& filter, const Filter& skip) {
+void Doxybook2::Generator::jsonRecursively(std::vector<Page>& pages,
+    const Node& parent,
+    const Filter& filter,
+    const Filter& skip) {
     for (const auto& child : parent.getChildren()) {
         if (filter.find(child->getKind()) != filter.end()) {
             if (skip.find(child->getKind()) == skip.end() && shouldInclude(*child)) {
-                nlohmann::json data = jsonConverter.getAsJson(*child);
-
-                const auto path = Path::join(config.outputDir, child->getRefid() + ".json");
-
-                spdlog::info("Rendering {}", path);
-                std::ofstream file(path);
-                if (!file)
-                    throw EXCEPTION("File {} failed to open for writing", path);
-
-                file << data.dump(2);
+                Page page;
+                page.node = child.get();
+                page.path = child->getRefid() + ".json";
+                pages.push_back(std::move(page));
             }
-            jsonRecursively(*child, filter, skip);
+            jsonRecursively(pages, *child, filter, skip);
         }
     }
 }
 
 void Doxybook2::Generator::print(const Filter& filter, const Filter& skip) {
-    printRecursively(doxygen.getIndex(), filter, skip);
+    run([&](std::vector<Page>& pages) { printRecursively(pages, doxygen.getIndex(), filter, skip); });
 }
 
 void Doxybook2::Generator::json(const Filter& filter, const Filter& skip) {
-    jsonRecursively(doxygen.getIndex(), filter, skip);
+    run([&](std::vector<Page>& pages) { jsonRecursively(pages, doxygen.getIndex(), filter, skip); });
 }
 
 void Doxybook2::Generator::manifest() {
     auto data = manifestRecursively(doxygen.getIndex());
-    const auto path = Path::join(config.outputDir, "manifest.json");
+    const auto path = std::string("manifest.json");
+
+    spdlog::info("Rendering {}", Path::join(config.outputDir, path));
+    output.write(path, data.dump(2));
+}
+
+void Doxybook2::Generator::symbolIndex() {
+    const auto path = std::string("symbols.idx");
 
-    spdlog::info("Rendering {}", path);
-    std::ofstream file(path);
-    if (!file)
-        throw EXCEPTION("File {} failed to open for writing", path);
+    const auto data = SymbolIndex::build(doxygen.getIndex(), [this](const Node& node) { return shouldInclude(node); });
 
-    file << data.dump(2);
+    spdlog::info("Rendering {}", Path::join(config.outputDir, path));
+    output.write(path, data);
 }
 
 nlohmann::json Doxybook2::Generator::manifestRecursively(const Node& node) {
@@ -199,6 +421,7 @@ nlohmann::json Doxybook2::Generator::manifestRecursively(const Node& node) {
         if (child->getKind() == Kind::MODULE)
             data["title"] = child->getTitle();
         data["url"] = child->getUrl();
+        data["hash"] = Hash::toHex(child->getHash());
 
         ret.push_back(std::move(data));
 
@@ -219,7 +442,33 @@ void Doxybook2::Generator::printIndex(const FolderCategory type,
     data["children"] = buildIndexRecursively(doxygen.getIndex(), filter, skip);
     data["title"] = typeToIndexTitle(config, type);
     data["name"] = typeToIndexTitle(config, type);
-    renderer.render(typeToIndexTemplate(config, type), path, data);
+    try {
+        renderer.render(typeToIndexTemplate(config, type), path, data);
+    } catch (RenderLimitException& e) {
+        const auto placeholder = renderLimitExceeded(typeToIndexName(config, type), typeToIndexTitle(config, type), e);
+        if (!placeholder.empty()) {
+            output.write(path, placeholder);
+        }
+    }
+}
+
+std::string Doxybook2::Generator::renderLimitExceeded(const std::string& refid,
+    const std::string& title,
+    const RenderLimitException& e) {
+    spdlog::warn("Page {} template '{}' {}", refid, e.getTemplateName(), e.getReason());
+    {
+        std::lock_guard<std::mutex> lock(renderViolationsMutex);
+        renderViolations.push_back({refid, e.getTemplateName(), e.getReason()});
+    }
+
+    if (!config.renderLimitPlaceholder) {
+        return "";
+    }
+    const auto message = "This page was not generated, the template " + e.getReason() + ".";
+    if (config.outputFormat == OutputFormat::HTML) {
+        return "<h1>" + Utils::escapeHtml(title) + "</h1>\n<p>" + Utils::escapeHtml(message) + "</p>\n";
+    }
+    return "# " + title + "\n\n" + message + "\n";
 }
 
 nlohmann::json Doxybook2::Generator::buildIndexRecursively(const Node& node, const Filter& filter, const Filter& skip) {
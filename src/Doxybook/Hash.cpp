@@ -0,0 +1,17 @@
+#include <Doxybook/Hash.hpp>
+#include <fmt/format.h>
+
+std::string Doxybook2::Hash::toHex(const Value value) {
+    return fmt::format("{:016x}", value);
+}
+
+std::string Doxybook2::Hash::fileName(const std::string& name, const Value value) {
+    const auto slash = name.find_last_of("/\\");
+    const auto begin = slash == std::string::npos ? 0 : slash + 1;
+    const auto dot = name.find_last_of('.');
+    // No extension, or a name that starts with the dot such as .hidden
+    if (dot == std::string::npos || dot <= begin) {
+        return name + "." + toHex(value);
+    }
+    return name.substr(0, dot) + "." + toHex(value) + name.substr(dot);
+}
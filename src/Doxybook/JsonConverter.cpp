@@ -2,6 +2,7 @@
 #include <Doxybook/Doxygen.hpp>
 #include <Doxybook/Exception.hpp>
 #include <Doxybook/JsonConverter.hpp>
+#include <Doxybook/Schema.hpp>
 #include <Doxybook/Utils.hpp>
 #include <iostream>
 #include <nlohmann/json.hpp>
@@ -36,65 +37,28 @@ nlohmann::json Doxybook2::JsonConverter::convert(const std::vector<std::string>&
 }
 
 nlohmann::json Doxybook2::JsonConverter::convert(const Node::ClassReference& klass) const {
-    nlohmann::json json;
-    if (!klass.refid.empty())
-        json["refid"] = klass.refid;
-    json["name"] = klass.name;
-    json["visibility"] = toStr(klass.prot);
-    json["virtual"] = toStr(klass.virt);
-    json["external"] = klass.ptr == nullptr;
-    if (klass.ptr)
-        json["url"] = klass.ptr->getUrl();
-    return json;
+    return Schema::toJson(klass);
 }
 
 nlohmann::json Doxybook2::JsonConverter::convert(const Node::ClassReferences& klasses) const {
-    nlohmann::json json = nlohmann::json::array();
-    for (const auto& base : klasses) {
-        json.push_back(convert(base));
-    }
-    return json;
+    return Schema::toJson(klasses);
 }
 
 nlohmann::json Doxybook2::JsonConverter::convert(const Node::Location& location) const {
-    nlohmann::json json;
-    json["file"] = location.file;
-    json["line"] = location.line;
-    json["column"] = location.column;
-    if (location.bodyStart > 0)
-        json["bodyStart"] = location.bodyStart;
-    if (location.bodyEnd > 0)
-        json["bodyEnd"] = location.bodyEnd;
-    if (!location.bodyFile.empty())
-        json["bodyFile"] = location.bodyFile;
-    return json;
+    return Schema::toJson(location);
 }
 
 nlohmann::json Doxybook2::JsonConverter::convert(const Node::Param& param) const {
-    nlohmann::json json;
-    json["type"] = param.type;
-    json["typePlain"] = param.typePlain;
-    json["name"] = param.name;
-    if (!param.defval.empty())
-        json["defval"] = param.defval;
-    if (!param.defvalPlain.empty())
-        json["defvalPlain"] = param.defvalPlain;
-    return json;
+    return Schema::toJson(param);
 }
 
 nlohmann::json Doxybook2::JsonConverter::convert(const Node& node) const {
-    nlohmann::json json;
+    nlohmann::json json = Schema::toJson(node);
     if (node.getKind() == Kind::FILE) {
         if (node.getParent()->getKind() == Kind::DIR) {
             json["name"] = node.getParent()->getName() + "/" + node.getName();
-            json["title"] = json["name"];
-        } else {
-            json["name"] = node.getName();
-            json["title"] = json["name"];
         }
-    } else {
-        json["name"] = node.getName();
-        json["title"] = node.getTitle();
+        json["title"] = json["name"];
     }
     if (!node.isStructured() && node.getKind() != Kind::MODULE && node.getKind() != Kind::DEFINE &&
         node.getKind() != Kind::FILE && node.getKind() != Kind::DIR) {
@@ -103,127 +67,40 @@ nlohmann::json Doxybook2::JsonConverter::convert(const Node& node) const {
     } else {
         json["fullname"] = json["name"];
     }
-    json["refid"] = node.getRefid();
-    json["url"] = node.getUrl();
-    json["anchor"] = node.getAnchor();
-    json["visibility"] = toStr(node.getVisibility());
     if (isFunctionType(node.getType())) {
         json["virtual"] = node.getVirtual() == Virtual::VIRTUAL || node.getVirtual() == Virtual::PURE_VIRTUAL;
         json["pureVirtual"] = node.getVirtual() == Virtual::PURE_VIRTUAL;
     }
     if (!node.getBrief().empty())
         json["brief"] = Utils::replaceNewline(node.getBrief());
-    if (!node.getSummary().empty())
-        json["summary"] = node.getSummary();
-    json["kind"] = toStr(node.getKind());
-    json["language"] = node.getLanguage();
-    json["category"] = toStr(node.getType());
-    if (!node.getBaseClasses().empty())
-        json["baseClasses"] = convert(node.getBaseClasses());
-    if (!node.getDerivedClasses().empty())
-        json["derivedClasses"] = convert(node.getDerivedClasses());
     return json;
 }
 
 nlohmann::json Doxybook2::JsonConverter::convert(const Node::ParameterListItem& parameterItem) const {
-    nlohmann::json json;
-    json["name"] = parameterItem.name;
-    json["text"] = parameterItem.text;
-    return json;
+    return Schema::toJson(parameterItem);
 }
 
 nlohmann::json Doxybook2::JsonConverter::convert(const Node::ParameterList& parameterList) const {
-    nlohmann::json json = nlohmann::json::array();
-    for (const auto& item : parameterList) {
-        json.push_back(convert(item));
-    }
-    return json;
+    return Schema::toJson(parameterList);
 }
 
 nlohmann::json Doxybook2::JsonConverter::convert(const Node& node, const Node::Data& data) const {
-    nlohmann::json json;
-    if (!data.details.empty())
-        json["details"] = data.details;
-    if (!data.inbody.empty())
-        json["inbody"] = data.inbody;
-    if (!data.includes.empty())
-        json["includes"] = data.includes;
-    if (!data.type.empty())
-        json["type"] = data.type;
-    json["definition"] = data.definition;
-    if (!data.initializer.empty())
-        json["initializer"] = data.initializer;
-    if (!data.typePlain.empty())
-        json["typePlain"] = data.typePlain;
-    if (!data.see.empty())
-        json["see"] = convert(data.see);
-    if (!data.returns.empty())
-        json["returns"] = data.returns;
-    if (!data.authors.empty())
-        json["authors"] = convert(data.authors);
-    if (!data.version.empty())
-        json["version"] = data.version;
-    if (!data.since.empty())
-        json["since"] = data.since;
-    if (!data.date.empty())
-        json["date"] = data.date;
-    if (!data.note.empty())
-        json["note"] = data.note;
-    if (!data.warning.empty())
-        json["warning"] = data.warning;
-    if (!data.pre.empty())
-        json["pre"] = data.pre;
-    if (!data.post.empty())
-        json["post"] = data.post;
-    if (!data.copyright.empty())
-        json["copyright"] = data.copyright;
-    if (!data.invariant.empty())
-        json["invariant"] = data.invariant;
-    if (!data.remark.empty())
-        json["remark"] = data.remark;
-    if (!data.attention.empty())
-        json["attention"] = data.attention;
-    if (!data.par.empty())
-        json["par"] = data.par;
-    if (!data.rcs.empty())
-        json["rcs"] = data.rcs;
-    if (!data.todos.empty())
-        json["todos"] = data.todos;
-    if (!data.bugs.empty())
-        json["bugs"] = data.bugs;
-    if (!data.tests.empty())
-        json["tests"] = data.tests;
-    if (!data.deprecated.empty())
-        json["deprecated"] = data.deprecated;
-    if (node.getKind() != Kind::ENUMVALUE) {
-        json["static"] = data.isStatic;
-        json["abstract"] = data.isAbstract;
-        json["const"] = data.isConst;
-        json["explicit"] = data.isExplicit;
-        json["strong"] = data.isStrong;
-        json["inline"] = data.isInline;
-        json["override"] = data.isOverride;
+    // The common fields are described in Schema.hpp,
+    // the ones that depend on the kind of the node are added here.
+    nlohmann::json json = Schema::toJson(data);
+    if (node.getKind() == Kind::ENUMVALUE) {
+        for (const auto& key : {"static", "abstract", "const", "explicit", "strong", "inline", "override"}) {
+            json.erase(key);
+        }
     }
     if (isFunctionType(node.getType())) {
         json["argsString"] = data.argsString;
         json["default"] = data.isDefault;
         json["deleted"] = data.isDeleted;
-        json["params"] = nlohmann::json::array();
-        for (const auto& param : data.params) {
-            json["params"].push_back(convert(param));
-        }
+        json["params"] = Schema::toJson(data.params);
     }
     if (node.getType() == Type::DEFINES && !data.params.empty()) {
-        json["params"] = nlohmann::json::array();
-        for (const auto& param : data.params) {
-            json["params"].push_back(convert(param));
-        }
-    }
-    if (!data.templateParams.empty()) {
-        json["templateParams"] = nlohmann::json::array();
-        for (const auto& param : data.templateParams) {
-            json["templateParams"].push_back(convert(param));
-        }
+        json["params"] = Schema::toJson(data.params);
     }
     if (data.reimplements)
         json["reimplements"] = convert(*data.reimplements);
@@ -234,27 +111,6 @@ nlohmann::json Doxybook2::JsonConverter::convert(const Node& node, const Node::D
         }
         json["reimplementedBy"] = std::move(arr);
     }
-    if (!data.programlisting.empty()) {
-        json["programlisting"] = data.programlisting;
-    }
-    if (!data.location.file.empty())
-        json["location"] = convert(data.location);
-    if (!data.returnsList.empty())
-        json["returnsList"] = convert(data.returnsList);
-    if (!data.exceptionsList.empty())
-        json["exceptionsList"] = convert(data.exceptionsList);
-    if (!data.templateParamsList.empty())
-        json["templateParamsList"] = convert(data.templateParamsList);
-    if (!data.paramList.empty())
-        json["paramList"] = convert(data.paramList);
-    json["hasDetails"] = !data.details.empty() || !data.templateParams.empty() || !data.inbody.empty() ||
-                         !data.returnsList.empty() || !data.exceptionsList.empty() ||
-                         !data.templateParamsList.empty() || !data.paramList.empty() || !data.see.empty() ||
-                         !data.returns.empty() || !data.bugs.empty() || !data.tests.empty() || !data.todos.empty() ||
-                         !data.authors.empty() || !data.version.empty() || !data.since.empty() || !data.date.empty() ||
-                         !data.note.empty() || !data.warning.empty() || !data.pre.empty() || !data.post.empty() ||
-                         !data.copyright.empty() || !data.invariant.empty() || !data.remark.empty() ||
-                         !data.attention.empty() || !data.par.empty() || !data.rcs.empty() || !data.deprecated.empty();
     return json;
 }
 
@@ -392,120 +248,56 @@ nlohmann::json Doxybook2::JsonConverter::getAsJson(const Node& node) const {
         }
     }
 
-    const auto alreadyExists = [&](const std::string& name) -> bool {
-        for (const auto& child : node.getChildren()) {
-            if (child->getName() == name)
-                return true;
-        }
-        return false;
-    };
-
     auto hasAdditionalMembers = false;
-    if (!node.getBaseClasses().empty()) {
-        for (auto& base : json["baseClasses"]) {
-            if (base["refid"].empty())
-                continue;
-
-            try {
-                const auto baseNode = doxygen.getCache().at(base["refid"]);
-                auto [baseData, baseChildrenDataMap] =
-                    baseNode->loadData(config, plainPrinter, markdownPrinter, doxygen.getCache());
-
-                // Get unique types of this base class
-                std::unordered_set<Type> baseUniqueTypes;
-                std::unordered_map<Type, Node::Children> baseChildren;
-                for (const auto& child : baseNode->getChildren()) {
-                    if (alreadyExists(child->getName())) {
-                        continue;
-                    }
-
-                    auto it = baseChildren.find(child->getType());
-                    if (it == baseChildren.end()) {
-                        it = baseChildren.insert(std::make_pair(child->getType(), Node::Children{})).first;
-                    }
+    for (const auto& inherited : node.getInheritedMembers()) {
+        const auto& base = *inherited.base;
+        std::shared_ptr<const MembersJson> members;
+        try {
+            members = getMembersJson(base);
+        } catch (std::exception& e) {
+            throw EXCEPTION("Something went wrong while processing base class {} of {} error {}",
+                base.getRefid(),
+                node.getRefid(),
+                e.what());
+        }
 
-                    it->second.push_back(child);
-                    baseUniqueTypes.insert(child->getType());
+        // The "baseClasses" list all of the bases, including the indirect ones
+        nlohmann::json* baseJson = nullptr;
+        if (json.contains("baseClasses")) {
+            for (auto& item : json["baseClasses"]) {
+                if (item.value("refid", "") == base.getRefid()) {
+                    baseJson = &item;
                 }
+            }
+        }
+        const nlohmann::json inheritedFrom = {
+            {"name", base.getName()}, {"refid", base.getRefid()}, {"url", base.getUrl()}};
 
-                // public, protected, private...
-                for (const auto& visibility : ALL_VISIBILITIES) {
-                    // attributes, functions, classes...
-                    for (const auto& type : baseUniqueTypes) {
-                        const auto key = toStr(visibility) + Utils::title(toStr(type));
-                        auto arr = nlohmann::json::array();
-                        const auto range = baseChildren.find(type);
-                        for (const auto& child : range->second) {
-                            if (alreadyExists(child->getName()))
-                                continue;
-
-                            if (!child->isStructured() && child->getKind() != Kind::MODULE) {
-                                try {
-                                    const auto it = baseChildrenDataMap.find(child.get()->getRefid());
-                                    if (it == baseChildrenDataMap.end()) {
-                                        throw EXCEPTION("Child {} not found in data map", child.get()->getRefid());
-                                    }
-                                    const auto& childData = it->second;
-                                    if (child->getVisibility() == visibility) {
-                                        auto childJson = convert(*child);
-                                        auto childDataJson = convert(*child, childData);
-                                        childJson.insert(childDataJson.begin(), childDataJson.end());
-
-                                        if (child->getKind() == Kind::ENUM) {
-                                            auto enumvalues = nlohmann::json::array();
-                                            for (const auto& enumvalue : child->getChildren()) {
-                                                auto enumvalueJson = convert(*enumvalue);
-                                                const auto eit = baseChildrenDataMap.find(enumvalue.get()->getRefid());
-                                                if (eit == baseChildrenDataMap.end()) {
-                                                    throw EXCEPTION(
-                                                        "Child {} not found in data map", child.get()->getRefid());
-                                                }
-                                                const auto& enumvalueData = it->second;
-                                                auto enumvalueDataJson = convert(*enumvalue, enumvalueData);
-                                                enumvalueJson.insert(
-                                                    enumvalueDataJson.begin(), enumvalueDataJson.end());
-                                                enumvalues.push_back(std::move(enumvalueJson));
-                                            }
-                                            childJson["enumvalues"] = std::move(enumvalues);
-                                        }
+        // public, protected, private...
+        for (const auto& visibility : ALL_VISIBILITIES) {
+            for (const auto* member : inherited.members) {
+                if (member->getVisibility() != visibility) {
+                    continue;
+                }
 
-                                        arr.push_back(std::move(childJson));
-                                    }
-                                } catch (std::out_of_range& e) {
-                                    (void)e;
-                                    throw EXCEPTION("Refid {} this should never happen please contact the author!",
-                                        child->getRefid());
-                                }
-                            } else {
-                                if (child->getVisibility() == visibility) {
-                                    arr.push_back(convert(*child));
-                                }
-                            }
-                        }
+                std::string key;
+                if (member->getType() == Type::FRIENDS) {
+                    key = "friends";
+                } else if (member->getType() == Type::NAMESPACES) {
+                    key = "namespaces";
+                } else if (member->getType() == Type::MODULES) {
+                    key = "groups";
+                } else {
+                    key = toStr(visibility) + Utils::title(toStr(member->getType()));
+                }
 
-                        if (!arr.empty()) {
-                            hasAdditionalMembers = true;
-                            if (type == Type::FRIENDS) {
-                                base["friends"] = std::move(arr);
-                            } else if (type == Type::NAMESPACES) {
-                                base["namespaces"] = std::move(arr);
-                            } else if (type == Type::MODULES) {
-                                base["groups"] = std::move(arr);
-                            } else {
-                                base[key] = std::move(arr);
-                            }
-                        }
-                    }
+                if (baseJson != nullptr) {
+                    (*baseJson)[key].push_back(members->at(member->getRefid()));
                 }
-            } catch (std::out_of_range& e) {
-                (void)e;
-                throw EXCEPTION(
-                    "Refid {} this should never happen please contact the author!", base["refid"].get<std::string>());
-            } catch (std::exception& e) {
-                throw EXCEPTION("Something went wrong while processing base class {} of {} error {}",
-                    base["refid"].get<std::string>(),
-                    node.getRefid(),
-                    e.what());
+                auto memberJson = convert(*member);
+                memberJson["inheritedFrom"] = inheritedFrom;
+                json["inherited" + Utils::title(key)].push_back(std::move(memberJson));
+                hasAdditionalMembers = true;
             }
         }
     }
@@ -513,3 +305,74 @@ nlohmann::json Doxybook2::JsonConverter::getAsJson(const Node& node) const {
 
     return json;
 }
+
+nlohmann::json Doxybook2::JsonConverter::convertMember(const Node& child,
+    const Node::ChildrenData& childrenData) const {
+    if (child.isStructured() || child.getKind() == Kind::MODULE) {
+        return convert(child);
+    }
+
+    const auto it = childrenData.find(child.getRefid());
+    if (it == childrenData.end()) {
+        throw EXCEPTION("Child {} not found in data map", child.getRefid());
+    }
+    auto json = convert(child);
+    auto dataJson = convert(child, it->second);
+    json.insert(dataJson.begin(), dataJson.end());
+
+    if (child.getKind() == Kind::ENUM) {
+        auto enumvalues = nlohmann::json::array();
+        for (const auto& enumvalue : child.getChildren()) {
+            const auto eit = childrenData.find(enumvalue->getRefid());
+            if (eit == childrenData.end()) {
+                throw EXCEPTION("Child {} not found in data map", enumvalue->getRefid());
+            }
+            auto enumvalueJson = convert(*enumvalue);
+            auto enumvalueDataJson = convert(*enumvalue, eit->second);
+            enumvalueJson.insert(enumvalueDataJson.begin(), enumvalueDataJson.end());
+            enumvalues.push_back(std::move(enumvalueJson));
+        }
+        json["enumvalues"] = std::move(enumvalues);
+    }
+    return json;
+}
+
+std::shared_ptr<const Doxybook2::JsonConverter::MembersJson> Doxybook2::JsonConverter::getMembersJson(
+    const Node& node) const {
+    const auto find = [&]() -> std::shared_ptr<const MembersJson> {
+        for (auto it = membersCache.begin(); it != membersCache.end(); ++it) {
+            if (it->first == &node) {
+                membersCache.splice(membersCache.begin(), membersCache, it);
+                return it->second;
+            }
+        }
+        return nullptr;
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(membersMutex);
+        if (auto found = find()) {
+            return found;
+        }
+    }
+
+    // Loaded without the lock, the pages of other classes do not have to wait for it
+    const auto [data, childrenData] = node.loadData(config, plainPrinter, markdownPrinter, doxygen.getCache());
+    auto members = std::make_shared<MembersJson>();
+    for (const auto& child : node.getChildren()) {
+        members->emplace(child->getRefid(), convertMember(*child, childrenData));
+    }
+
+    if (config.inheritedCacheSize > 0) {
+        std::lock_guard<std::mutex> lock(membersMutex);
+        // Another thread may have been faster
+        if (auto found = find()) {
+            return found;
+        }
+        membersCache.emplace_front(&node, members);
+        if (membersCache.size() > static_cast<size_t>(config.inheritedCacheSize)) {
+            membersCache.pop_back();
+        }
+    }
+    return members;
+}
@@ -0,0 +1,124 @@
+#include "ExceptionUtils.hpp"
+#include <Doxybook/JsonDelta.hpp>
+#include <Doxybook/Path.hpp>
+#include <fstream>
+#include <spdlog/spdlog.h>
+
+static const std::string HASHES_FILE = "hashes.json";
+static const std::string DELTA_FILE = "delta.json";
+
+Doxybook2::JsonDeltaOutput::JsonDeltaOutput(Output& output, std::string previousDir)
+    : output(output), previousDir(std::move(previousDir)) {
+
+    std::ifstream file(Path::join(this->previousDir, HASHES_FILE));
+    if (!file) {
+        spdlog::warn("No {} from a previous run in {}, every file is added",
+            HASHES_FILE,
+            this->previousDir);
+        return;
+    }
+
+    try {
+        const auto json = nlohmann::json::parse(file);
+        for (const auto& [path, hash] : json.at("files").items()) {
+            if (isCompared(path)) {
+                previous[path] = std::stoull(hash.get<std::string>(), nullptr, 16);
+            }
+        }
+        foundPrevious = true;
+    } catch (std::exception& e) {
+        previous.clear();
+        spdlog::warn("Failed to read {} of the previous run, every file is added: {}", HASHES_FILE, e.what());
+    }
+}
+
+bool Doxybook2::JsonDeltaOutput::isCompared(const std::string& path) {
+    static const std::string ext = ".json";
+    if (path == HASHES_FILE || path == DELTA_FILE) {
+        return false;
+    }
+    return path.size() > ext.size() && path.compare(path.size() - ext.size(), ext.size(), ext) == 0;
+}
+
+void Doxybook2::JsonDeltaOutput::write(const std::string& path, const std::string& data) {
+    // The previous contents have to be read before they are overwritten
+    if (isCompared(path)) {
+        changed(path, Hash::of(data), &data);
+    }
+    output.write(path, data);
+}
+
+void Doxybook2::JsonDeltaOutput::add(const std::string& path, const Hash::Value hash) {
+    if (isCompared(path)) {
+        changed(path, hash, nullptr);
+    }
+}
+
+void Doxybook2::JsonDeltaOutput::changed(const std::string& path, const Hash::Value hash, const std::string* data) {
+    const auto found = previous.find(path);
+    if (found == previous.end()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        written.insert(path);
+        added.insert(path);
+        return;
+    }
+    if (found->second == hash) {
+        std::lock_guard<std::mutex> lock(mutex);
+        written.insert(path);
+        return;
+    }
+
+    nlohmann::json patch;
+    if (data != nullptr) {
+        std::ifstream file(Path::join(previousDir, path), std::ios::binary);
+        try {
+            if (file) {
+                patch = nlohmann::json::diff(nlohmann::json::parse(file), nlohmann::json::parse(*data));
+            }
+        } catch (nlohmann::json::exception& e) {
+            spdlog::warn("Failed to compare {} with the previous run: {}", path, e.what());
+            patch = nullptr;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    written.insert(path);
+    modified[path] = std::move(patch);
+}
+
+void Doxybook2::JsonDeltaOutput::writeDelta() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto addedJson = nlohmann::json::array();
+    for (const auto& file : added) {
+        addedJson.push_back(file);
+    }
+
+    std::set<std::string> removed;
+    for (const auto& [file, hash] : previous) {
+        if (written.find(file) == written.end()) {
+            removed.insert(file);
+        }
+    }
+    auto removedJson = nlohmann::json::array();
+    for (const auto& file : removed) {
+        removedJson.push_back(file);
+    }
+
+    auto modifiedJson = nlohmann::json::array();
+    for (const auto& [file, patch] : modified) {
+        modifiedJson.push_back({{"path", file}, {"patch", patch}});
+    }
+
+    spdlog::info("Compared with the previous run, {} added {} removed {} modified",
+        added.size(),
+        removed.size(),
+        modified.size());
+
+    nlohmann::json json;
+    json["previous"] = hasPrevious();
+    json["added"] = std::move(addedJson);
+    json["removed"] = std::move(removedJson);
+    json["modified"] = std::move(modifiedJson);
+    output.write(DELTA_FILE, json.dump(2));
+}
@@ -0,0 +1,137 @@
+#include <Doxybook/LoadFilter.hpp>
+#include <Doxybook/Utils.hpp>
+
+// From the most to the least visible
+static int visibilityRank(const Doxybook2::Visibility visibility) {
+    switch (visibility) {
+        case Doxybook2::Visibility::PUBLIC:
+            return 0;
+        case Doxybook2::Visibility::PROTECTED:
+            return 1;
+        case Doxybook2::Visibility::PACKAGE:
+            return 2;
+        default:
+            return 3;
+    }
+}
+
+// Wildcard match, '*' matches any sequence and '?' matches a single character
+static bool wildcardMatch(const std::string& pattern, const std::string& str) {
+    size_t p = 0;
+    size_t s = 0;
+    auto star = std::string::npos;
+    size_t mark = 0;
+    while (s < str.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == str[s])) {
+            p++;
+            s++;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            star = p++;
+            mark = s;
+        } else if (star != std::string::npos) {
+            p = star + 1;
+            s = ++mark;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') {
+        p++;
+    }
+    return p == pattern.size();
+}
+
+// Has the brief or the detailed description any paragraph?
+static bool isDocumented(const Doxybook2::Xml::Element& element) {
+    for (const auto* name : {"briefdescription", "detaileddescription", "inbodydescription"}) {
+        const auto description = element.firstChildElement(name);
+        if (description && description.firstChildElement()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool isKindClass(const Doxybook2::Kind kind) {
+    return kind == Doxybook2::Kind::CLASS || kind == Doxybook2::Kind::STRUCT || kind == Doxybook2::Kind::UNION ||
+           kind == Doxybook2::Kind::INTERFACE;
+}
+
+Doxybook2::LoadFilter::LoadFilter(const Config& config)
+    : maxVisibility(visibilityRank(config.loadVisibility)), undocumented(config.loadUndocumented),
+      exclude(config.loadExclude) {
+    for (const auto& language : config.loadLanguages) {
+        languages.insert(Utils::normalizeLanguage(language));
+    }
+    enabled = maxVisibility < visibilityRank(Visibility::PRIVATE) || !undocumented || !exclude.empty() ||
+              !languages.empty();
+}
+
+bool Doxybook2::LoadFilter::acceptCompound(const Xml::Element& compounddef,
+    const Kind kind,
+    const std::string& name) const {
+    if (!enabled) {
+        return true;
+    }
+    if (!languages.empty()) {
+        const auto language = compounddef.getAttr("language", "");
+        if (!language.empty() && languages.find(Utils::normalizeLanguage(language)) == languages.end()) {
+            return false;
+        }
+    }
+    if (!isKindLanguage(kind)) {
+        return true;
+    }
+    if (!acceptVisibility(compounddef) || isExcluded(name)) {
+        return false;
+    }
+    // Undocumented namespaces are common, only the classes are skipped
+    return undocumented || !isKindClass(kind) || isDocumented(compounddef);
+}
+
+bool Doxybook2::LoadFilter::acceptMember(const Xml::Element& memberdef,
+    const Kind parentKind,
+    const std::string& parentName) const {
+    if (!enabled) {
+        return true;
+    }
+    if (!acceptVisibility(memberdef)) {
+        return false;
+    }
+    if (!undocumented && !isDocumented(memberdef)) {
+        return false;
+    }
+    if (!exclude.empty()) {
+        // Members of files and groups have no scope in their name
+        const auto name = memberdef.firstChildElement("qualifiedname");
+        if (name) {
+            return !isExcluded(name.getText());
+        }
+        const auto memberName = memberdef.firstChildElement("name");
+        const auto shortName = memberName ? memberName.getText() : std::string();
+        return !isExcluded(isKindLanguage(parentKind) ? parentName + "::" + shortName : shortName);
+    }
+    return true;
+}
+
+bool Doxybook2::LoadFilter::isExcluded(const std::string& qualifiedName) const {
+    for (const auto& pattern : exclude) {
+        if (wildcardMatch(pattern, qualifiedName)) {
+            return true;
+        }
+        // The enclosing scopes, "a::b::c" -> "a::b" -> "a"
+        auto end = qualifiedName.rfind("::");
+        while (end != std::string::npos && end > 0) {
+            if (wildcardMatch(pattern, qualifiedName.substr(0, end))) {
+                return true;
+            }
+            end = qualifiedName.rfind("::", end - 1);
+        }
+    }
+    return false;
+}
+
+bool Doxybook2::LoadFilter::acceptVisibility(const Xml::Element& element) const {
+    const auto prot = element.getAttr("prot", "public");
+    return visibilityRank(toEnumVisibility(prot)) <= maxVisibility;
+}
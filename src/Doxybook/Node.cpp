@@ -1,79 +1,211 @@
 #include "ExceptionUtils.hpp"
 #include <Doxybook/Exception.hpp>
+#include <Doxybook/LoadFilter.hpp>
 #include <Doxybook/Node.hpp>
+#include <Doxybook/NodeCache.hpp>
 #include <Doxybook/TextPrinter.hpp>
 #include <Doxybook/Utils.hpp>
+#include <Doxybook/XmlSource.hpp>
 #include <Doxybook/XmlTextParser.hpp>
+#include <algorithm>
 #include <cassert>
 #include <fmt/format.h>
 #include <functional>
 #include <iostream>
+#include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include <spdlog/spdlog.h>
 
 class Doxybook2::Node::Temp {
 public:
     XmlTextParser::Node brief;
+    // Refids of the members this member overrides
+    std::vector<std::string> reimplements;
 };
 
-static Doxybook2::NodePtr findInCache(Doxybook2::NodeCacheMap& cache, const std::string& refid) {
-    const auto found = cache.find(refid);
-    if (found != cache.end()) {
-        return found->second;
-    } else {
-        return nullptr;
+// Elements regenerated by Doxygen when some other file changes, or hashed separately (sectiondef)
+static const std::unordered_set<std::string> HASH_SKIP_ELEMENTS = {
+    "sectiondef",
+    "listofallmembers",
+    "incdepgraph",
+    "invincdepgraph",
+    "inheritancegraph",
+    "collaborationgraph",
+};
+
+// Line numbers move whenever something above them is edited
+static const std::unordered_set<std::string> HASH_SKIP_ATTRIBUTES = {
+    "line",
+    "column",
+    "bodystart",
+    "bodyend",
+    "declline",
+    "declcolumn",
+};
+
+static void hashText(Doxybook2::Hash& hash, const std::string& text) {
+    // Collapse all whitespace into a single space and trim the ends
+    std::string normalized;
+    normalized.reserve(text.size());
+    auto space = false;
+    for (const auto c : text) {
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+            space = !normalized.empty();
+        } else {
+            if (space) {
+                normalized += ' ';
+                space = false;
+            }
+            normalized += c;
+        }
+    }
+    if (!normalized.empty()) {
+        hash.update(normalized);
     }
 }
 
-static Doxybook2::NodePtr findOrCreate(const std::string& inputDir,
-    Doxybook2::NodeCacheMap& cache,
+static void hashElement(Doxybook2::Hash& hash, const Doxybook2::Xml::Element& element) {
+    hash.update(element.getName());
+
+    std::vector<std::pair<std::string, std::string>> attrs;
+    element.allAttributes([&](const std::string& name, const std::string& value) {
+        if (HASH_SKIP_ATTRIBUTES.find(name) == HASH_SKIP_ATTRIBUTES.end()) {
+            attrs.emplace_back(name, value);
+        }
+    });
+    std::sort(attrs.begin(), attrs.end());
+    hash.update(static_cast<Doxybook2::Hash::Value>(attrs.size()));
+    for (const auto& attr : attrs) {
+        hash.update(attr.first).update(attr.second);
+    }
+
+    auto child = element.firstChild();
+    while (child) {
+        if (child.isElement()) {
+            const auto e = child.asElement();
+            if (HASH_SKIP_ELEMENTS.find(e.getName()) == HASH_SKIP_ELEMENTS.end()) {
+                hashElement(hash, e);
+            }
+        } else if (child.hasText()) {
+            hashText(hash, child.getText());
+        }
+        child = child.nextSibling();
+    }
+    // End of element marker, so that siblings and children can not be confused
+    hash.update(Doxybook2::Hash::Value(0));
+}
+
+static Doxybook2::Hash::Value hashElement(const Doxybook2::Xml::Element& element) {
+    Doxybook2::Hash hash;
+    hashElement(hash, element);
+    return hash.get();
+}
+
+static void printListing(std::string& out, const Doxybook2::Xml::Node& node) {
+    if (!node.isElement()) {
+        if (node.hasText()) {
+            out += node.getText();
+        }
+        return;
+    }
+    const auto element = node.asElement();
+    for (auto child = element.firstChild(); child; child = child.nextSibling()) {
+        printListing(out, child);
+    }
+    const auto name = element.getName();
+    if (name == "codeline") {
+        out += '\n';
+    } else if (name == "sp") {
+        out += ' ';
+    }
+}
+
+// Prints the source listing of a file as plain text straight from the xml.
+// Same as printing XmlTextParser::parseParas() with the plain printer,
+// but without building the whole tree of the source file first.
+static std::string printListing(const Doxybook2::Xml::Element& programlisting) {
+    std::string out;
+    for (auto codeline = programlisting.firstChildElement(); codeline; codeline = codeline.nextSiblingElement()) {
+        printListing(out, codeline.asNode());
+    }
+    while (!out.empty() && out.back() == '\n') {
+        out.pop_back();
+    }
+    return out;
+}
+
+static Doxybook2::NodePtr findOrCreate(const Doxybook2::XmlSource& source,
+    const Doxybook2::LoadFilter& filter,
+    Doxybook2::NodeCache& cache,
     const std::string& refid,
     const bool isGroupOrFile) {
-    auto found = findInCache(cache, refid);
+    auto found = cache.find(refid);
     if (found) {
         if (found->isEmpty()) {
-            return Doxybook2::Node::parse(cache, inputDir, found, isGroupOrFile);
+            return Doxybook2::Node::parse(cache, source, filter, found, isGroupOrFile);
         } else {
             return found;
         }
+    } else if (cache.isRejected(refid)) {
+        return nullptr;
     } else {
-        return Doxybook2::Node::parse(cache, inputDir, refid, isGroupOrFile);
+        return Doxybook2::Node::parse(cache, source, filter, refid, isGroupOrFile);
     }
 }
 
-Doxybook2::NodePtr Doxybook2::Node::parse(NodeCacheMap& cache,
-    const std::string& inputDir,
+Doxybook2::NodePtr Doxybook2::Node::parse(NodeCache& cache,
+    const XmlSource& source,
+    const LoadFilter& filter,
     const std::string& refid,
     const bool isGroupOrFile) {
     assert(!refid.empty());
     const auto ptr = std::make_shared<Node>(refid);
-    return parse(cache, inputDir, ptr, isGroupOrFile);
+    return parse(cache, source, filter, ptr, isGroupOrFile);
 }
 
-Doxybook2::NodePtr
-Doxybook2::Node::parse(NodeCacheMap& cache, const std::string& inputDir, const NodePtr& ptr, const bool isGroupOrFile) {
-    const auto refidPath = Utils::join(inputDir, ptr->refid + ".xml");
-    spdlog::info("Loading {}", refidPath);
-    Xml xml(refidPath);
-
-    auto root = assertChild(xml, "doxygen");
-    auto compounddef = assertChild(root, "compounddef");
+Doxybook2::NodePtr Doxybook2::Node::parse(NodeCache& cache,
+    const XmlSource& source,
+    const LoadFilter& filter,
+    const NodePtr& ptr,
+    const bool isGroupOrFile) {
+    const auto refidPath = source.getPath(ptr->refid);
+    spdlog::debug("Loading {}", refidPath);
+    const auto xml = source.load(ptr->refid);
+    auto compounddef = XmlSource::getCompounddef(*xml);
+
+    const auto name = assertChild(compounddef, "compoundname").getText();
+    if (!filter.acceptCompound(compounddef, toEnumKind(compounddef.getAttr("kind")), name)) {
+        spdlog::debug("Filtered out {}", name);
+        cache.reject(ptr->refid);
+        return nullptr;
+    }
 
-    ptr->xmlPath = refidPath;
-    ptr->name = assertChild(compounddef, "compoundname").getText();
+    ptr->name = name;
+    ptr->getCompound().xmlPath = refidPath;
+    ptr->compound->source = &source;
     ptr->kind = toEnumKind(compounddef.getAttr("kind"));
-    ptr->language = Utils::normalizeLanguage(compounddef.getAttr("language", ""));
+    ptr->language = internLanguage(Utils::normalizeLanguage(compounddef.getAttr("language", "")));
     ptr->empty = false;
-    cache.insert(std::make_pair(ptr->refid, ptr));
+    ptr->contentHash = hashElement(compounddef);
+
+    // Someone else has already created this node, use theirs
+    const auto inserted = cache.insert(ptr);
+    if (inserted != ptr) {
+        return inserted;
+    }
 
     // Inner members such as functions
     auto sectiondef = compounddef.firstChildElement("sectiondef");
     while (sectiondef) {
         auto memberdef = sectiondef.firstChildElement("memberdef");
         while (memberdef) {
-            const auto childKindStr = memberdef.getAttr("kind");
+            if (!filter.acceptMember(memberdef, ptr->kind, ptr->name)) {
+                memberdef = memberdef.nextSiblingElement("memberdef");
+                continue;
+            }
             const auto childRefid = memberdef.getAttr("id");
-            const auto found = findInCache(cache, childRefid);
+            const auto found = cache.find(childRefid);
             const auto child = found ? found : Node::parse(memberdef, childRefid);
             const auto definition = memberdef.firstChildElement("definition");
             if (definition) {
@@ -83,7 +215,7 @@ Doxybook2::Node::parse(NodeCacheMap& cache, const std::string& inputDir, const N
                 }
             }
             child->language = ptr->language;
-            ptr->children.push_back(child);
+            ptr->compound->children.push_back(child);
 
             if (isGroupOrFile) {
                 // Only update child's parent if this is a group and the member has
@@ -105,8 +237,11 @@ Doxybook2::Node::parse(NodeCacheMap& cache, const std::string& inputDir, const N
     auto innerProcess = [&](Xml::Element& parent, const std::string& name) {
         parent.allChildElements(name, [&](Xml::Element& e) {
             const auto childRefid = e.getAttr("refid");
-            auto child = findOrCreate(inputDir, cache, childRefid, isGroupOrFile);
-            ptr->children.push_back(child);
+            auto child = findOrCreate(source, filter, cache, childRefid, isGroupOrFile);
+            if (!child) {
+                return;
+            }
+            ptr->compound->children.push_back(child);
 
             // Only update child's parent if we are not processing directories
             if (!isGroupOrFile || (isGroupOrFile && child->kind == Kind::MODULE) ||
@@ -149,8 +284,15 @@ Doxybook2::NodePtr Doxybook2::Node::parse(Xml::Element& memberdef, const std::st
     ptr->name = assertChild(memberdef, "name").getText();
     ptr->kind = toEnumKind(memberdef.getAttr("kind"));
     ptr->empty = true;
+    ptr->contentHash = hashElement(memberdef);
     ptr->parseBaseInfo(memberdef);
 
+    auto reimplements = memberdef.firstChildElement("reimplements");
+    while (reimplements) {
+        ptr->temp->reimplements.push_back(reimplements.getAttr("refid", ""));
+        reimplements = reimplements.nextSiblingElement("reimplements");
+    }
+
     if (ptr->kind == Kind::ENUM) {
         auto enumvalue = memberdef.firstChildElement("enumvalue");
         while (enumvalue) {
@@ -158,23 +300,17 @@ Doxybook2::NodePtr Doxybook2::Node::parse(Xml::Element& memberdef, const std::st
             value->name = enumvalue.firstChildElement("name").getText();
             value->kind = Kind::ENUMVALUE;
             value->empty = false;
+            value->contentHash = hashElement(enumvalue);
             value->parent = ptr.get();
             value->parseBaseInfo(enumvalue);
             value->parseBaseInfo(enumvalue);
-            ptr->children.push_back(value);
+            ptr->getCompound().children.push_back(value);
             enumvalue = enumvalue.nextSiblingElement("enumvalue");
         }
     }
     return ptr;
 }
 
-Doxybook2::Xml::Element Doxybook2::Node::assertChild(const Xml& xml, const std::string& name) {
-    auto child = xml.firstChildElement(name);
-    if (!child)
-        throw EXCEPTION("Unable to find <{}> element in root element file {}", name, xml.getPath());
-    return child;
-}
-
 Doxybook2::Xml::Element Doxybook2::Node::assertChild(const Xml::Element& xml, const std::string& name) {
     auto child = xml.firstChildElement(name);
     if (!child)
@@ -186,11 +322,41 @@ Doxybook2::Xml::Element Doxybook2::Node::assertChild(const Xml::Element& xml, co
     return child;
 }
 
+const Doxybook2::Node::Children Doxybook2::Node::noChildren;
+const Doxybook2::Node::ClassReferences Doxybook2::Node::noClassReferences;
+const Doxybook2::Node::Inherited Doxybook2::Node::noInherited;
+const std::string Doxybook2::Node::noString;
+
 Doxybook2::Node::Node(const std::string& refid) : temp(new Temp), refid(refid) {
 }
 
 Doxybook2::Node::~Node() = default;
 
+Doxybook2::Node::Compound& Doxybook2::Node::getCompound() {
+    if (!compound) {
+        compound = std::make_unique<Compound>();
+        compound->title = name;
+    }
+    return *compound;
+}
+
+const std::string* Doxybook2::Node::internLanguage(const std::string& language) {
+    static std::mutex mutex;
+    static std::unordered_set<std::string> languages;
+    std::lock_guard<std::mutex> lock(mutex);
+    // Pointers to the elements of an unordered_set stay valid on rehash
+    return &*languages.insert(language).first;
+}
+
+void Doxybook2::Node::releaseTemp() {
+    temp.reset();
+}
+
+const std::vector<std::string>& Doxybook2::Node::getReimplements() const {
+    static const std::vector<std::string> none;
+    return temp ? temp->reimplements : none;
+}
+
 void Doxybook2::Node::parseBaseInfo(const Xml::Element& element) {
     const auto briefdescription = element.firstChildElement("briefdescription");
     if (briefdescription) {
@@ -203,9 +369,9 @@ void Doxybook2::Node::parseBaseInfo(const Xml::Element& element) {
 
     const auto title = element.firstChildElement("title");
     if (title) {
-        this->title = title.getText();
-    } else {
-        this->title = this->name;
+        getCompound().title = title.getText();
+    } else if (compound) {
+        compound->title = this->name;
     }
 
     type = kindToType(kind);
@@ -218,7 +384,7 @@ void Doxybook2::Node::parseInheritanceInfo(const Xml::Element& element) {
         base.name = e.getText();
         base.virt = toEnumVirtual(e.getAttr("virt"));
         base.prot = toEnumVisibility(e.getAttr("prot"));
-        baseClasses.push_back(base);
+        getCompound().baseClasses.push_back(base);
     });
 
     element.allChildElements("derivedcompoundref", [&](Xml::Element& e) {
@@ -227,20 +393,21 @@ void Doxybook2::Node::parseInheritanceInfo(const Xml::Element& element) {
         derived.name = e.getText();
         derived.virt = toEnumVirtual(e.getAttr("virt"));
         derived.prot = toEnumVisibility(e.getAttr("prot"));
-        derivedClasses.push_back(derived);
+        getCompound().derivedClasses.push_back(derived);
     });
 }
 
 void Doxybook2::Node::finalize(const Config& config,
     const TextPrinter& plainPrinter,
     const TextPrinter& markdownPrinter,
-    const NodeCacheMap& cache) {
+    const NodeCacheMap& cache,
+    TextStore& texts) {
     // Sort children
-    if (config.sort) {
+    if (config.sort && compound) {
 #ifdef _MSC_VER
-        children.sort([](const NodePtr& a, const NodePtr& b) { return a->getName() < b->getName(); });
+        compound->children.sort([](const NodePtr& a, const NodePtr& b) { return a->getName() < b->getName(); });
 #else
-        children.sort([](const NodePtr& a, const NodePtr& b) { return a->getName() > b->getName(); });
+        compound->children.sort([](const NodePtr& a, const NodePtr& b) { return a->getName() > b->getName(); });
 #endif
     }
 
@@ -279,21 +446,21 @@ void Doxybook2::Node::finalize(const Config& config,
                         return urlFolderMaker(config, node);
                     }
                 }
-                return urlFolderMaker(config, node) + Utils::stripAnchor(node.refid) + config.linkSuffix +
-                       anchorMaker(node);
+                return urlFolderMaker(config, node) + shardPath(config, Utils::stripAnchor(node.refid)) +
+                       config.linkSuffix + anchorMaker(node);
             }
             case Kind::ENUMVALUE: {
                 const auto n = node.parent->parent;
-                return urlFolderMaker(config, *n) + Utils::stripAnchor(n->refid) + config.linkSuffix +
-                       anchorMaker(node);
+                return urlFolderMaker(config, *n) + shardPath(config, Utils::stripAnchor(n->refid)) +
+                       config.linkSuffix + anchorMaker(node);
             }
             default: {
                 auto* n = node.parent;
                 if (node.group) {
                     n = node.group;
                 }
-                return urlFolderMaker(config, *n) + Utils::stripAnchor(n->refid) + config.linkSuffix +
-                       anchorMaker(node);
+                return urlFolderMaker(config, *n) + shardPath(config, Utils::stripAnchor(n->refid)) +
+                       config.linkSuffix + anchorMaker(node);
             }
         }
     };
@@ -307,8 +474,9 @@ void Doxybook2::Node::finalize(const Config& config,
     }
 
     if (temp) {
-        brief = markdownPrinter.print(temp->brief);
-        summary = plainPrinter.print(temp->brief);
+        this->texts = &texts;
+        brief = texts.add(markdownPrinter.print(temp->brief));
+        summary = texts.add(plainPrinter.print(temp->brief));
         temp.reset();
 
         anchor = anchorMaker(*this);
@@ -324,26 +492,30 @@ void Doxybook2::Node::finalize(const Config& config,
             return it->second.get();
         };
 
-        for (auto& klass : baseClasses) {
-            if (!klass.refid.empty()) {
-                klass.ptr = findOrNull(klass.refid);
-                if (!klass.ptr) {
-                    klass.refid.clear();
+        if (compound) {
+            for (auto& klass : compound->baseClasses) {
+                if (!klass.refid.empty()) {
+                    klass.ptr = findOrNull(klass.refid);
+                    if (!klass.ptr) {
+                        klass.refid.clear();
+                    }
                 }
             }
-        }
 
-        for (auto& klass : derivedClasses) {
-            if (!klass.refid.empty()) {
-                klass.ptr = findOrNull(klass.refid);
-                if (!klass.ptr) {
-                    klass.refid.clear();
+            for (auto& klass : compound->derivedClasses) {
+                if (!klass.refid.empty()) {
+                    klass.ptr = findOrNull(klass.refid);
+                    if (!klass.ptr) {
+                        klass.refid.clear();
+                    }
                 }
             }
         }
     }
 
-    baseClasses = getAllBaseClasses(cache);
+    if (compound) {
+        compound->baseClasses = getAllBaseClasses(cache);
+    }
 }
 
 Doxybook2::Node::LoadDataResult Doxybook2::Node::loadData(const Config& config,
@@ -351,11 +523,13 @@ Doxybook2::Node::LoadDataResult Doxybook2::Node::loadData(const Config& config,
     const TextPrinter& markdownPrinter,
     const NodeCacheMap& cache) const {
 
-    spdlog::info("Parsing {}", xmlPath);
-    Xml xml(xmlPath);
+    if (!compound || !compound->source) {
+        throw EXCEPTION("Node {} has no xml to load the data from", refid);
+    }
 
-    auto root = assertChild(xml, "doxygen");
-    auto compounddef = assertChild(root, "compounddef");
+    spdlog::debug("Parsing {}", getXmlPath());
+    const auto xml = compound->source->load(refid);
+    auto compounddef = XmlSource::getCompounddef(*xml);
 
     auto data = loadData(config, plainPrinter, markdownPrinter, cache, compounddef);
     ChildrenData childrenData;
@@ -365,7 +539,15 @@ Doxybook2::Node::LoadDataResult Doxybook2::Node::loadData(const Config& config,
         auto memberdef = sectiondef.firstChildElement("memberdef");
         while (memberdef) {
             const auto childRefid = memberdef.getAttr("id");
-            const auto childPtr = this->findChild(childRefid);
+            const auto childIt = std::find_if(compound->children.begin(),
+                compound->children.end(),
+                [&](const NodePtr& child) { return child->refid == childRefid; });
+            // Filtered out when loaded
+            if (childIt == compound->children.end()) {
+                memberdef = memberdef.nextSiblingElement("memberdef");
+                continue;
+            }
+            const auto& childPtr = *childIt;
 
             const auto it = childrenData
                                 .insert(std::make_pair(childPtr.get()->getRefid(),
@@ -623,30 +805,34 @@ Doxybook2::Node::Data Doxybook2::Node::loadData(const Config& config,
 
     if (auto reimplements = element.firstChildElement("reimplements")) {
         const auto refid = reimplements.getAttr("refid", "");
-        if (!refid.empty()) {
-            data.reimplements = cache.at(refid).get();
+        const auto it = cache.find(refid);
+        if (it != cache.end()) {
+            data.reimplements = it->second.get();
         }
     }
 
     if (auto reimplementedby = element.firstChildElement("reimplementedby")) {
         while (reimplementedby) {
             const auto refid = reimplementedby.getAttr("refid", "");
-            if (!refid.empty()) {
-                data.reimplementedBy.push_back(cache.at(refid).get());
+            const auto it = cache.find(refid);
+            if (it != cache.end()) {
+                data.reimplementedBy.push_back(it->second.get());
             }
             reimplementedby = reimplementedby.nextSiblingElement("reimplementedby");
         }
     }
 
-    if (const auto programlisting = element.firstChildElement("programlisting")) {
-        data.programlisting = plainPrinter.print(XmlTextParser::parseParas(programlisting), language);
+    if (config.sourceListing != SourceListing::NONE) {
+        if (const auto programlisting = element.firstChildElement("programlisting")) {
+            data.programlisting = printListing(programlisting);
+        }
     }
 
     return data;
 }
 
 Doxybook2::NodePtr Doxybook2::Node::findChild(const std::string& refid) const {
-    for (const auto& ptr : children) {
+    for (const auto& ptr : getChildren()) {
         if (ptr->refid == refid)
             return ptr;
     }
@@ -662,7 +848,7 @@ Doxybook2::NodePtr Doxybook2::Node::find(const std::string& refid) const {
 }
 
 Doxybook2::NodePtr Doxybook2::Node::findRecursively(const std::string& refid) const {
-    for (auto it = children.begin(); it != children.end(); ++it) {
+    for (auto it = getChildren().begin(); it != getChildren().end(); ++it) {
         if (it->get()->refid == refid)
             return *it;
         auto test = it->get()->findRecursively(refid);
@@ -674,14 +860,14 @@ Doxybook2::NodePtr Doxybook2::Node::findRecursively(const std::string& refid) co
 
 Doxybook2::Node::ClassReferences Doxybook2::Node::getAllBaseClasses(const NodeCacheMap& cache) {
     std::list<ClassReference> newTemp;
-    for (auto& base : baseClasses) {
+    for (auto& base : getBaseClasses()) {
         newTemp.push_back(base);
     }
 
     for (auto& base : newTemp) {
         if (!base.refid.empty() && !base.ptr) {
-            auto found = cache.at(base.refid);
-            base.ptr = found.get();
+            const auto found = cache.find(base.refid);
+            base.ptr = found != cache.end() ? found->second.get() : nullptr;
         }
 
         if (base.ptr) {
@@ -0,0 +1,62 @@
+#include <Doxybook/NodeCache.hpp>
+#include <functional>
+
+Doxybook2::NodeCache::NodeCache(const size_t numOfShards)
+    : numOfShards(numOfShards == 0 ? 1 : numOfShards), shards(new Shard[this->numOfShards]) {
+}
+
+Doxybook2::NodeCache::Shard& Doxybook2::NodeCache::getShard(const std::string& refid) const {
+    return shards[std::hash<std::string>{}(refid) % numOfShards];
+}
+
+Doxybook2::NodePtr Doxybook2::NodeCache::find(const std::string& refid) const {
+    auto& shard = getShard(refid);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const auto found = shard.map.find(refid);
+    if (found != shard.map.end()) {
+        return found->second;
+    } else {
+        return nullptr;
+    }
+}
+
+Doxybook2::NodePtr Doxybook2::NodeCache::insert(const NodePtr& node) {
+    auto& shard = getShard(node->getRefid());
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.map.insert(std::make_pair(node->getRefid(), node)).first->second;
+}
+
+void Doxybook2::NodeCache::reject(const std::string& refid) {
+    std::lock_guard<std::mutex> lock(rejectedMutex);
+    rejected.insert(refid);
+}
+
+bool Doxybook2::NodeCache::isRejected(const std::string& refid) const {
+    std::lock_guard<std::mutex> lock(rejectedMutex);
+    return rejected.find(refid) != rejected.end();
+}
+
+size_t Doxybook2::NodeCache::size() const {
+    size_t total = 0;
+    for (size_t i = 0; i < numOfShards; i++) {
+        std::lock_guard<std::mutex> lock(shards[i].mutex);
+        total += shards[i].map.size();
+    }
+    return total;
+}
+
+Doxybook2::NodeCacheMap Doxybook2::NodeCache::freeze() {
+    NodeCacheMap map;
+    // Lower load factor, shorter buckets, faster lookups.
+    // The map is not modified much after the loading is done.
+    map.max_load_factor(0.5f);
+    map.reserve(size());
+    for (size_t i = 0; i < numOfShards; i++) {
+        std::lock_guard<std::mutex> lock(shards[i].mutex);
+        for (auto& pair : shards[i].map) {
+            map.insert(std::move(pair));
+        }
+        shards[i].map.clear();
+    }
+    return map;
+}
@@ -0,0 +1,113 @@
+#include "ExceptionUtils.hpp"
+#include <Doxybook/Exception.hpp>
+#include <Doxybook/Output.hpp>
+#include <Doxybook/Path.hpp>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+Doxybook2::FileOutput::FileOutput(std::string outputDir) : outputDir(std::move(outputDir)) {
+}
+
+void Doxybook2::FileOutput::createParentDirectory(const std::string& path) {
+    const auto found = path.find_last_of("/\\");
+    if (found == std::string::npos) {
+        return;
+    }
+
+    const auto dir = path.substr(0, found);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (directories.find(dir) != directories.end()) {
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(Path::join(outputDir, dir), ec);
+    if (ec) {
+        throw EXCEPTION("Failed to create directory {} error {}", Path::join(outputDir, dir), ec.message());
+    }
+    directories.insert(dir);
+}
+
+void Doxybook2::FileOutput::write(const std::string& path, const std::string& data) {
+    createParentDirectory(path);
+    const auto absPath = Path::join(outputDir, path);
+    std::ofstream file(absPath, std::ios::out | std::ios::binary);
+    if (!file) {
+        throw EXCEPTION("Failed to open file for writing {}", absPath);
+    }
+    file.write(data.data(), data.size());
+}
+
+void Doxybook2::MemoryOutput::write(const std::string& path, const std::string& data) {
+    std::lock_guard<std::mutex> lock(mutex);
+    files[path] = data;
+}
+
+const std::string& Doxybook2::MemoryOutput::get(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = files.find(path);
+    if (it == files.end()) {
+        throw EXCEPTION("File {} has not been generated", path);
+    }
+    return it->second;
+}
+
+bool Doxybook2::MemoryOutput::contains(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return files.find(path) != files.end();
+}
+
+Doxybook2::CallbackOutput::CallbackOutput(Callback callback) : callback(std::move(callback)) {
+}
+
+void Doxybook2::CallbackOutput::write(const std::string& path, const std::string& data) {
+    callback(path, data);
+}
+
+Doxybook2::HashingOutput::HashingOutput(Output& output) : output(output) {
+}
+
+void Doxybook2::HashingOutput::write(const std::string& path, const std::string& data) {
+    // Hashed while the contents are still in memory, not read back from the disk
+    const auto hash = Hash::of(data);
+    output.write(path, data);
+    add(path, hash);
+}
+
+void Doxybook2::HashingOutput::add(const std::string& path, const Hash::Value hash) {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.emplace_back(path, hash);
+}
+
+size_t Doxybook2::HashingOutput::getCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+std::vector<Doxybook2::HashingOutput::Entry> Doxybook2::HashingOutput::getSince(const size_t count) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (count >= entries.size()) {
+        return {};
+    }
+    return std::vector<Entry>(entries.begin() + count, entries.end());
+}
+
+void Doxybook2::HashingOutput::writeHashes(const std::string& path) {
+    std::map<std::string, Hash::Value> sorted;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& [file, hash] : entries) {
+            sorted[file] = hash;
+        }
+    }
+
+    nlohmann::json files = nlohmann::json::object();
+    for (const auto& [file, hash] : sorted) {
+        files[file] = Hash::toHex(hash);
+    }
+    nlohmann::json json;
+    json["algorithm"] = "fnv1a64";
+    json["files"] = std::move(files);
+    output.write(path, json.dump(2));
+}
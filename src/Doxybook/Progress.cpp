@@ -0,0 +1,89 @@
+#include <Doxybook/Progress.hpp>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+static const long long REPORT_INTERVAL_NS = 1000000000LL;
+
+static std::mutex jsonMutex;
+static std::ostream* jsonStream = nullptr;
+
+void Doxybook2::Progress::setJsonStream(std::ostream* stream) {
+    std::lock_guard<std::mutex> lock(jsonMutex);
+    jsonStream = stream;
+}
+
+Doxybook2::Progress::Progress(std::string phase, const size_t total)
+    : phase(std::move(phase)), total(total), start(std::chrono::steady_clock::now()) {
+    report(Event::START);
+}
+
+Doxybook2::Progress::~Progress() {
+    finish();
+}
+
+void Doxybook2::Progress::addTotal(const size_t count) {
+    total += count;
+}
+
+void Doxybook2::Progress::increment(const size_t count) {
+    done += count;
+    maybeReport();
+}
+
+void Doxybook2::Progress::set(const size_t done) {
+    this->done = done;
+    maybeReport();
+}
+
+void Doxybook2::Progress::finish() {
+    if (!finished.exchange(true)) {
+        report(Event::DONE);
+    }
+}
+
+void Doxybook2::Progress::maybeReport() {
+    const auto now =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    auto last = lastReport.load();
+    // Only one of the threads that crossed the interval reports
+    if (now - last >= REPORT_INTERVAL_NS && lastReport.compare_exchange_strong(last, now)) {
+        report(Event::PROGRESS);
+    }
+}
+
+void Doxybook2::Progress::report(const Event event) {
+    const size_t done = this->done;
+    const size_t total = this->total;
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const auto rate = elapsed > 0.0 ? done / elapsed : 0.0;
+    const auto eta = rate > 0.0 && total > done ? (total - done) / rate : 0.0;
+
+    if (event == Event::DONE) {
+        spdlog::info("{}: {} items in {:.2f}s ({:.0f}/s)", phase, done, elapsed, rate);
+    } else if (event == Event::PROGRESS) {
+        if (total > 0) {
+            spdlog::info("{}: {}/{} ({:.0f}%) {:.0f}/s, ETA {:.0f}s",
+                phase,
+                done,
+                total,
+                100.0 * done / total,
+                rate,
+                eta);
+        } else {
+            spdlog::info("{}: {} {:.0f}/s", phase, done, rate);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(jsonMutex);
+    if (jsonStream) {
+        nlohmann::json json;
+        json["event"] = event == Event::START ? "start" : event == Event::DONE ? "done" : "progress";
+        json["phase"] = phase;
+        json["done"] = done;
+        json["total"] = total;
+        json["elapsed"] = elapsed;
+        json["rate"] = rate;
+        json["eta"] = eta;
+        *jsonStream << json.dump() << std::endl;
+    }
+}
@@ -5,11 +5,13 @@
 #include <spdlog/spdlog.h>
 #include <Doxybook/Renderer.hpp>
 #include <Doxybook/Utils.hpp>
+#include <algorithm>
 #include <chrono>
 #include <dirent.h>
 #include <fmt/format.h>
 #include <inja/inja.hpp>
 #include <set>
+#include <sstream>
 #include <unordered_set>
 
 #ifdef _WIN32
@@ -58,6 +60,71 @@ static void directoryIterator(const std::string& path, const std::function<void(
     }
 }
 
+namespace {
+    // The limits of the page that is being rendered on this thread
+    struct RenderBudget {
+        std::string templateName;
+        std::chrono::steady_clock::time_point deadline;
+        int timeLimit{0};
+        size_t sizeLimit{0};
+        size_t size{0};
+
+        void check() const {
+            if (timeLimit > 0 && std::chrono::steady_clock::now() > deadline) {
+                throw Doxybook2::RenderLimitException(
+                    templateName, fmt::format("took longer than {} seconds to render", timeLimit));
+            }
+        }
+
+        void add(const size_t count) {
+            size += count;
+            if (sizeLimit > 0 && size > sizeLimit) {
+                throw Doxybook2::RenderLimitException(
+                    templateName, fmt::format("rendered more than {} bytes", sizeLimit));
+            }
+            check();
+        }
+    };
+
+    thread_local RenderBudget* currentBudget = nullptr;
+
+    // Checks the budget on every write of the template engine, so that a page
+    // is stopped as soon as it goes over the limit and not when it is finished.
+    class BudgetStringBuf : public std::stringbuf {
+    public:
+        explicit BudgetStringBuf(RenderBudget& budget) : budget(budget) {
+        }
+
+    protected:
+        std::streamsize xsputn(const char* s, const std::streamsize n) override {
+            budget.add(static_cast<size_t>(n));
+            inPut = true;
+            const auto ret = std::stringbuf::xsputn(s, n);
+            inPut = false;
+            return ret;
+        }
+
+        int_type overflow(const int_type c) override {
+            // Called by xsputn when the buffer grows, the bytes are already counted
+            if (!inPut && !traits_type::eq_int_type(c, traits_type::eof())) {
+                budget.add(1);
+            }
+            return std::stringbuf::overflow(c);
+        }
+
+    private:
+        RenderBudget& budget;
+        bool inPut{false};
+    };
+
+    // For the callbacks that can take long, a template can loop without writing anything
+    void checkBudget() {
+        if (currentBudget != nullptr) {
+            currentBudget->check();
+        }
+    }
+} // namespace
+
 static std::string filename(const std::string& path) {
     const auto found = path.find_last_of("/\\");
     if (found == std::string::npos) {
@@ -78,8 +145,9 @@ static std::string basename(const std::string& path) {
 Doxybook2::Renderer::Renderer(const Config& config,
     const Doxygen& doxygen,
     const JsonConverter& jsonConverter,
+    Output& output,
     const std::optional<std::string>& templatesPath)
-    : config(config), doxygen(doxygen), jsonConverter(jsonConverter),
+    : config(config), doxygen(doxygen), jsonConverter(jsonConverter), output(output),
       env(std::make_unique<inja::Environment>(
           templatesPath.has_value() ? trimPath(*templatesPath) + SEPARATOR : "./")) {
 
@@ -91,6 +159,10 @@ Doxybook2::Renderer::Renderer(const Config& config,
         const auto arg = args.at(0)->get<std::string>();
         return Utils::escape(arg);
     });
+    env->add_callback("escapeHtml", 1, [](inja::Arguments& args) -> std::string {
+        const auto arg = args.at(0)->get<std::string>();
+        return Utils::escapeHtml(arg);
+    });
     env->add_callback("title", 1, [](inja::Arguments& args) {
         const auto arg = args.at(0)->get<std::string>();
         return Utils::title(arg);
@@ -138,6 +210,7 @@ Doxybook2::Renderer::Renderer(const Config& config,
             return arr.at(arr.size() + idx);
     });
     env->add_callback("countProperty", 3, [](inja::Arguments& args) -> int {
+        checkBudget();
         const auto arr = args.at(0)->get<nlohmann::json>();
         const auto key = args.at(1)->get<std::string>();
         const auto value = args.at(2)->get<std::string>();
@@ -151,6 +224,7 @@ Doxybook2::Renderer::Renderer(const Config& config,
         return count;
     });
     env->add_callback("queryProperty", 3, [](inja::Arguments& args) -> nlohmann::json {
+        checkBudget();
         const auto arr = args.at(0)->get<nlohmann::json>();
         const auto key = args.at(1)->get<std::string>();
         const auto value = args.at(2)->get<std::string>();
@@ -164,11 +238,13 @@ Doxybook2::Renderer::Renderer(const Config& config,
         return ret;
     });
     env->add_callback("render", 2, [=](inja::Arguments& args) -> nlohmann::json {
+        checkBudget();
         const auto name = args.at(0)->get<std::string>();
         const auto data = args.at(1)->get<nlohmann::json>();
         return this->render(name, data);
     });
     env->add_callback("load", 1, [&](inja::Arguments& args) -> nlohmann::json {
+        checkBudget();
         const auto refid = args.at(0)->get<std::string>();
         return jsonConverter.getAsJson(*doxygen.find(refid));
     });
@@ -225,6 +301,7 @@ Doxybook2::Renderer::Renderer(const Config& config,
     // Recursive template loader with dependencies.
     // Thanks to C++17 we can use recursive lambdas.
     std::set<std::string> loaded;
+    const auto& defaultTemplates = getDefaultTemplates(config);
     const std::function<void(const std::string&, bool)> loadDependency = [&](const std::string& name,
                                                                              const bool include) {
         // Check if this template has been loaded.
@@ -340,27 +417,12 @@ Doxybook2::Renderer::Renderer(const Config& config,
 Doxybook2::Renderer::~Renderer() = default;
 
 void Doxybook2::Renderer::render(const std::string& name, const std::string& path, const nlohmann::json& data) const {
-    const auto it = templates.find(stripTmplSuffix(name));
-    if (it == templates.end()) {
-        throw EXCEPTION("Template {} not found", name);
-    }
-
-    const auto absPath = Path::join(config.outputDir, path);
     if (config.debugTemplateJson) {
-        std::ofstream dump(absPath + ".json");
-        dump << data.dump(2);
+        output.write(path + ".json", data.dump(2));
     }
 
-    std::fstream file(absPath, std::ios::out);
-    if (!file) {
-        throw EXCEPTION("Failed to open file for writing {}", absPath);
-    }
-    spdlog::info("Rendering {}", absPath);
-    try {
-      env->render_to(file, *it->second, data);
-    } catch (std::exception& e) {
-        throw EXCEPTION("Render template '{}' error {}", name, e.what());
-    }
+    spdlog::debug("Rendering {}", Path::join(config.outputDir, path));
+    output.write(path, render(name, data));
 }
 
 std::string Doxybook2::Renderer::render(const std::string& name, const nlohmann::json& data) const {
@@ -369,12 +431,45 @@ std::string Doxybook2::Renderer::render(const std::string& name, const nlohmann:
         throw EXCEPTION("Template {} not found", stripTmplSuffix(name));
     }
 
-    std::stringstream ss;
+    // No limits, or a render() callback inside of a page that is already measured
+    if ((config.renderTimeLimit <= 0 && config.renderSizeLimit <= 0) || currentBudget != nullptr) {
+        std::stringstream ss;
+        try {
+            env->render_to(ss, *it->second, data);
+        } catch (RenderLimitException&) {
+            throw;
+        } catch (std::exception& e) {
+            throw EXCEPTION("Failed to render template '{}' error {}", name, e.what());
+        }
+        return ss.str();
+    }
+
+    RenderBudget budget;
+    budget.templateName = stripTmplSuffix(name);
+    budget.timeLimit = std::max(config.renderTimeLimit, 0);
+    budget.sizeLimit = static_cast<size_t>(std::max(config.renderSizeLimit, 0));
+    budget.deadline = std::chrono::steady_clock::now() + std::chrono::seconds(budget.timeLimit);
+
+    BudgetStringBuf buf(budget);
+    std::ostream os(&buf);
+    // The exception thrown by the buffer is passed through instead of only setting the badbit
+    os.exceptions(std::ios::badbit);
+
+    struct BudgetScope {
+        explicit BudgetScope(RenderBudget& budget) {
+            currentBudget = &budget;
+        }
+        ~BudgetScope() {
+            currentBudget = nullptr;
+        }
+    } scope(budget);
+
     try {
-      env->render_to(ss, *it->second, data);
+        env->render_to(os, *it->second, data);
+    } catch (RenderLimitException&) {
+        throw;
     } catch (std::exception& e) {
         throw EXCEPTION("Failed to render template '{}' error {}", name, e.what());
     }
-    return ss.str();
+    return buf.str();
 }
-
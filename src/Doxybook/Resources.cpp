@@ -0,0 +1,131 @@
+#include <Doxybook/Resources.hpp>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <fmt/format.h>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+static const uint64_t MIB = 1024ULL * 1024ULL;
+
+// Below this the text is kept compressed and fewer pages wait in the pipeline
+static const uint64_t LOW_MEMORY = 1024ULL * MIB;
+
+// The memory worth one entry of the cache of the inherited members
+static const uint64_t INHERITED_CACHE_ENTRY = 32ULL * MIB;
+static const int INHERITED_CACHE_MIN = 8;
+
+static const int LOW_MEMORY_QUEUE_SIZE = 16;
+
+// Returns the contents of the file, empty if there is none
+static std::string readFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        return "";
+    }
+    std::stringstream ss;
+    ss << file.rdbuf();
+    return ss.str();
+}
+
+// The lower of the two, where 0 is no limit
+template <typename T> static T lowest(const T a, const T b) {
+    if (a <= 0) {
+        return b;
+    }
+    if (b <= 0) {
+        return a;
+    }
+    return std::min(a, b);
+}
+
+Doxybook2::Resources::Limits Doxybook2::Resources::read() {
+    // The cgroup2 entry is the one with the hierarchy 0, "0::/some/path"
+    std::istringstream lines(readFile("/proc/self/cgroup"));
+    std::string line;
+    while (std::getline(lines, line)) {
+        if (line.compare(0, 3, "0::") == 0) {
+            return read("/sys/fs/cgroup", line.substr(3));
+        }
+    }
+    return read("/sys/fs/cgroup", "/");
+}
+
+Doxybook2::Resources::Limits Doxybook2::Resources::read(const std::string& root, const std::string& cgroup) {
+    // The limits of the parents apply as well, up to the root of the hierarchy
+    // (which is the cgroup of the container when it has its own cgroup namespace)
+    Limits limits;
+    auto path = cgroup;
+    while (true) {
+        while (!path.empty() && path.back() == '/') {
+            path.pop_back();
+        }
+        const auto dir = root + path;
+        const auto found = parse(readFile(dir + "/cpu.max"), readFile(dir + "/memory.max"));
+        limits.cpus = lowest(limits.cpus, found.cpus);
+        limits.memory = lowest(limits.memory, found.memory);
+
+        const auto slash = path.rfind('/');
+        if (slash == std::string::npos) {
+            break;
+        }
+        path.erase(slash);
+    }
+    return limits;
+}
+
+Doxybook2::Resources::Limits Doxybook2::Resources::parse(const std::string& cpuMax, const std::string& memoryMax) {
+    Limits limits;
+
+    std::istringstream cpu(cpuMax);
+    std::string quota;
+    double period = 0.0;
+    if (cpu >> quota >> period && quota != "max" && period > 0.0) {
+        try {
+            limits.cpus = std::max(std::stod(quota), 0.0) / period;
+        } catch (std::exception&) {
+        }
+    }
+
+    std::istringstream memory(memoryMax);
+    std::string bytes;
+    if (memory >> bytes && bytes != "max") {
+        try {
+            limits.memory = std::stoull(bytes);
+        } catch (std::exception&) {
+        }
+    }
+
+    return limits;
+}
+
+void Doxybook2::Resources::tune(Config& config, const Limits& limits) {
+    if (limits.cpus > 0.0) {
+        // A quota of 1.5 CPUs still keeps two threads busy, one of them half of the time
+        auto cpus = static_cast<int>(std::ceil(limits.cpus));
+        const auto cores = static_cast<int>(std::thread::hardware_concurrency());
+        if (cores > 0) {
+            cpus = std::min(cpus, cores);
+        }
+        config.schedulerThreads = std::max(cpus, 1);
+    }
+
+    if (limits.memory > 0) {
+        // The default of 64 base classes with 2 GiB, fewer with less, but never none
+        const auto entries = static_cast<int>(std::min<uint64_t>(limits.memory / INHERITED_CACHE_ENTRY, INT_MAX));
+        config.inheritedCacheSize = std::min(config.inheritedCacheSize, std::max(entries, INHERITED_CACHE_MIN));
+
+        if (limits.memory < LOW_MEMORY) {
+            config.compressText = true;
+            config.pipelineQueueSize = std::min(config.pipelineQueueSize, LOW_MEMORY_QUEUE_SIZE);
+        }
+    }
+}
+
+std::string Doxybook2::Resources::describe(const Limits& limits) {
+    const auto cpus = limits.cpus > 0.0 ? fmt::format("{:g} CPUs", limits.cpus) : std::string("no CPU limit");
+    const auto memory =
+        limits.memory > 0 ? fmt::format("{} MiB of memory", limits.memory / MIB) : std::string("no memory limit");
+    return cpus + ", " + memory;
+}
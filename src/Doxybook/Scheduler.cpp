@@ -0,0 +1,246 @@
+#include <Doxybook/Scheduler.hpp>
+#include <algorithm>
+#include <chrono>
+#include <spdlog/spdlog.h>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+    // The scheduler and the index of the worker running on this thread
+    thread_local const Doxybook2::Scheduler* currentScheduler = nullptr;
+    thread_local size_t currentIndex = 0;
+} // namespace
+
+Doxybook2::Scheduler::Scheduler(size_t threads, const bool pinThreads) {
+    if (threads == 0) {
+        threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    for (size_t i = 0; i < threads; i++) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    // Started once all of them exist, they steal from each other
+    for (size_t i = 0; i < threads; i++) {
+        workers[i]->thread = std::thread([this, i, pinThreads]() { workerMain(i, pinThreads); });
+    }
+}
+
+Doxybook2::Scheduler::~Scheduler() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker->thread.join();
+    }
+}
+
+Doxybook2::Scheduler::GroupPtr Doxybook2::Scheduler::createGroup(std::string name,
+    const size_t maxConcurrency,
+    const Priority priority) {
+    auto group = std::make_shared<Group>();
+    group->name = std::move(name);
+    group->maxConcurrency = maxConcurrency;
+    group->priority = priority;
+    return group;
+}
+
+void Doxybook2::Scheduler::submit(const GroupPtr& group, Task task) {
+    {
+        std::lock_guard<std::mutex> lock(group->mutex);
+        if (group->cancelled) {
+            return;
+        }
+        group->pending++;
+    }
+    push({group, std::move(task)});
+}
+
+void Doxybook2::Scheduler::push(Entry entry) {
+    const auto priority = static_cast<size_t>(entry.group->priority);
+    const auto index = currentWorker();
+    if (index < workers.size()) {
+        auto& worker = *workers[index];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.queues[priority].push_back(std::move(entry));
+    } else {
+        std::lock_guard<std::mutex> lock(sharedMutex);
+        shared[priority].push_back(std::move(entry));
+    }
+
+    {
+        // Under the lock, so that a thread going to sleep does not miss it
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queued++;
+    }
+    wake.notify_one();
+}
+
+void Doxybook2::Scheduler::wait(const GroupPtr& group) {
+    const auto index = currentWorker();
+    std::unique_lock<std::mutex> lock(group->mutex);
+    if (index < workers.size()) {
+        // Blocking here could leave no thread to run the tasks waited for
+        while (group->pending > 0) {
+            lock.unlock();
+            Entry entry;
+            if (take(index, entry)) {
+                execute(entry);
+                lock.lock();
+            } else {
+                lock.lock();
+                group->done.wait_for(lock, std::chrono::milliseconds(1));
+            }
+        }
+    } else {
+        group->done.wait(lock, [&] { return group->pending == 0; });
+    }
+
+    if (group->error) {
+        std::rethrow_exception(group->error);
+    }
+}
+
+void Doxybook2::Scheduler::cancel(const GroupPtr& group) {
+    std::lock_guard<std::mutex> lock(group->mutex);
+    group->cancelled = true;
+    group->pending -= group->deferred.size();
+    group->deferred.clear();
+    if (group->pending == 0) {
+        group->done.notify_all();
+    }
+}
+
+size_t Doxybook2::Scheduler::currentWorker() const {
+    return currentScheduler == this ? currentIndex : workers.size();
+}
+
+bool Doxybook2::Scheduler::take(const size_t index, Entry& entry) {
+    const auto found = [&](std::deque<Entry>& queue, const bool back) {
+        if (queue.empty()) {
+            return false;
+        }
+        if (back) {
+            entry = std::move(queue.back());
+            queue.pop_back();
+        } else {
+            entry = std::move(queue.front());
+            queue.pop_front();
+        }
+        queued--;
+        return true;
+    };
+
+    for (size_t priority = 0; priority < PRIORITIES; priority++) {
+        if (index < workers.size()) {
+            std::lock_guard<std::mutex> lock(workers[index]->mutex);
+            if (found(workers[index]->queues[priority], true)) {
+                return true;
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(sharedMutex);
+            if (found(shared[priority], false)) {
+                return true;
+            }
+        }
+        for (size_t i = 1; i <= workers.size(); i++) {
+            const auto victim = (index + i) % workers.size();
+            if (victim == index) {
+                continue;
+            }
+            std::lock_guard<std::mutex> lock(workers[victim]->mutex);
+            if (found(workers[victim]->queues[priority], false)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void Doxybook2::Scheduler::execute(Entry& entry) {
+    auto& group = *entry.group;
+    {
+        std::lock_guard<std::mutex> lock(group.mutex);
+        if (group.cancelled) {
+            if (--group.pending == 0) {
+                group.done.notify_all();
+            }
+            return;
+        }
+        if (group.maxConcurrency > 0 && group.running >= group.maxConcurrency) {
+            group.deferred.push_back(std::move(entry.task));
+            return;
+        }
+        group.running++;
+    }
+
+    std::exception_ptr error;
+    try {
+        entry.task();
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    std::unique_lock<std::mutex> lock(group.mutex);
+    group.running--;
+    group.pending--;
+    if (error) {
+        if (!group.error) {
+            group.error = std::move(error);
+        }
+        group.cancelled = true;
+        group.pending -= group.deferred.size();
+        group.deferred.clear();
+    }
+
+    Task next;
+    if (!group.deferred.empty()) {
+        next = std::move(group.deferred.front());
+        group.deferred.pop_front();
+    }
+    if (group.pending == 0) {
+        group.done.notify_all();
+    }
+    lock.unlock();
+
+    if (next) {
+        push({entry.group, std::move(next)});
+    }
+}
+
+void Doxybook2::Scheduler::workerMain(const size_t index, const bool pin) {
+    currentScheduler = this;
+    currentIndex = index;
+
+    if (pin) {
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(index % std::max<size_t>(std::thread::hardware_concurrency(), 1), &set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+            spdlog::warn("Failed to pin the scheduler thread {} to a core", index);
+        }
+#else
+        if (index == 0) {
+            spdlog::warn("Pinning the scheduler threads is not supported on this platform");
+        }
+#endif
+    }
+
+    while (true) {
+        Entry entry;
+        if (take(index, entry)) {
+            execute(entry);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [&] { return stopping || queued > 0; });
+        if (stopping && queued <= 0) {
+            break;
+        }
+    }
+}
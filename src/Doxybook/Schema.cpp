@@ -0,0 +1,164 @@
+#include <Doxybook/Schema.hpp>
+#include <fmt/format.h>
+
+Doxybook2::Schema::StreamWriter::StreamWriter(std::ostream& out) : out(out) {
+}
+
+void Doxybook2::Schema::StreamWriter::separator() {
+    if (afterKey) {
+        afterKey = false;
+        return;
+    }
+    if (!first.empty()) {
+        if (!first.back()) {
+            out << ',';
+        }
+        first.back() = false;
+    }
+}
+
+void Doxybook2::Schema::StreamWriter::beginObject() {
+    separator();
+    out << '{';
+    first.push_back(true);
+}
+
+void Doxybook2::Schema::StreamWriter::endObject() {
+    first.pop_back();
+    out << '}';
+}
+
+void Doxybook2::Schema::StreamWriter::beginArray() {
+    separator();
+    out << '[';
+    first.push_back(true);
+}
+
+void Doxybook2::Schema::StreamWriter::endArray() {
+    first.pop_back();
+    out << ']';
+}
+
+void Doxybook2::Schema::StreamWriter::key(const std::string& name) {
+    separator();
+    string(name);
+    out << ':';
+    afterKey = true;
+}
+
+void Doxybook2::Schema::StreamWriter::value(const std::string& str) {
+    separator();
+    string(str);
+}
+
+void Doxybook2::Schema::StreamWriter::value(const bool b) {
+    separator();
+    out << (b ? "true" : "false");
+}
+
+void Doxybook2::Schema::StreamWriter::value(const int i) {
+    separator();
+    out << i;
+}
+
+void Doxybook2::Schema::StreamWriter::string(const std::string& str) {
+    out << '"';
+    for (const auto c : str) {
+        switch (c) {
+            case '"':
+                out << "\\\"";
+                break;
+            case '\\':
+                out << "\\\\";
+                break;
+            case '\n':
+                out << "\\n";
+                break;
+            case '\r':
+                out << "\\r";
+                break;
+            case '\t':
+                out << "\\t";
+                break;
+            case '\b':
+                out << "\\b";
+                break;
+            case '\f':
+                out << "\\f";
+                break;
+            default: {
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out << fmt::format("\\u{:04x}", static_cast<int>(c));
+                } else {
+                    out << c;
+                }
+                break;
+            }
+        }
+    }
+    out << '"';
+}
+
+Doxybook2::Schema::CborWriter::CborWriter(std::string& out) : out(out) {
+}
+
+void Doxybook2::Schema::CborWriter::head(const uint8_t major, const uint64_t length) {
+    const auto m = static_cast<char>(major << 5);
+    if (length < 24) {
+        out += static_cast<char>(m | length);
+    } else if (length <= 0xff) {
+        out += static_cast<char>(m | 24);
+        out += static_cast<char>(length);
+    } else if (length <= 0xffff) {
+        out += static_cast<char>(m | 25);
+        out += static_cast<char>(length >> 8);
+        out += static_cast<char>(length);
+    } else if (length <= 0xffffffff) {
+        out += static_cast<char>(m | 26);
+        for (auto shift = 24; shift >= 0; shift -= 8) {
+            out += static_cast<char>(length >> shift);
+        }
+    } else {
+        out += static_cast<char>(m | 27);
+        for (auto shift = 56; shift >= 0; shift -= 8) {
+            out += static_cast<char>(length >> shift);
+        }
+    }
+}
+
+void Doxybook2::Schema::CborWriter::beginObject() {
+    out += static_cast<char>(0xbf);
+}
+
+void Doxybook2::Schema::CborWriter::endObject() {
+    out += static_cast<char>(0xff);
+}
+
+void Doxybook2::Schema::CborWriter::beginArray() {
+    out += static_cast<char>(0x9f);
+}
+
+void Doxybook2::Schema::CborWriter::endArray() {
+    out += static_cast<char>(0xff);
+}
+
+void Doxybook2::Schema::CborWriter::key(const std::string& name) {
+    value(name);
+}
+
+void Doxybook2::Schema::CborWriter::value(const std::string& str) {
+    head(3, str.size());
+    out += str;
+}
+
+void Doxybook2::Schema::CborWriter::value(const bool b) {
+    out += static_cast<char>(b ? 0xf5 : 0xf4);
+}
+
+void Doxybook2::Schema::CborWriter::value(const int i) {
+    if (i >= 0) {
+        head(0, static_cast<uint64_t>(i));
+    } else {
+        head(1, static_cast<uint64_t>(-(static_cast<int64_t>(i) + 1)));
+    }
+}
@@ -0,0 +1,443 @@
+#include "ExceptionUtils.hpp"
+#include <Doxybook/Exception.hpp>
+#include <Doxybook/SymbolIndex.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <unordered_set>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const char MAGIC[8] = {'D', 'X', 'B', 'K', 'S', 'Y', 'M', '1'};
+    const uint32_t ENDIAN_MARK = 0x01020304;
+
+    // Offset and length of a string in the strings table
+    struct Str {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    struct Header {
+        char magic[8];
+        uint32_t byteOrder;
+        uint32_t symbols;
+        uint32_t keys;
+        uint32_t trigrams;
+        uint32_t postings;
+        uint32_t children;
+        uint32_t strings;
+        uint32_t symbolsOffset;
+        uint32_t keysOffset;
+        uint32_t trigramsOffset;
+        uint32_t postingsOffset;
+        uint32_t childrenOffset;
+        uint32_t stringsOffset;
+        uint32_t reserved;
+    };
+
+    struct Record {
+        Str fullname;
+        Str name;
+        Str title;
+        Str kind;
+        Str refid;
+        Str url;
+        Str brief;
+        uint32_t parent;
+        uint32_t childrenOffset;
+        uint32_t childrenCount;
+        // Number of the distinct trigrams of the full name
+        uint32_t trigrams;
+    };
+
+    struct Key {
+        Str key;
+        uint32_t id;
+    };
+
+    struct Trigram {
+        uint32_t value;
+        uint32_t postingsOffset;
+        uint32_t postingsCount;
+    };
+
+    // Each of the tables starts 4 bytes aligned
+    static_assert(sizeof(Header) % 4 == 0 && sizeof(Record) % 4 == 0, "unexpected padding");
+    static_assert(sizeof(Key) == 12 && sizeof(Trigram) == 12, "unexpected padding");
+
+    class StringTable {
+    public:
+        Str add(const std::string& str) {
+            const auto found = offsets.find(str);
+            if (found != offsets.end()) {
+                return found->second;
+            }
+            const Str result{static_cast<uint32_t>(data.size()), static_cast<uint32_t>(str.size())};
+            data += str;
+            offsets.emplace(str, result);
+            return result;
+        }
+
+        const std::string& get() const {
+            return data;
+        }
+
+    private:
+        std::string data;
+        std::unordered_map<std::string, Str> offsets;
+    };
+
+    // Distinct trigrams of the lowercase text padded by a space, " foo " => " fo", "foo", "oo "
+    std::vector<uint32_t> trigramsOf(const std::string_view& text) {
+        std::string padded = " ";
+        for (const auto c : text) {
+            padded += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        padded += " ";
+
+        std::vector<uint32_t> result;
+        for (size_t i = 0; i + 3 <= padded.size(); i++) {
+            result.push_back(static_cast<uint32_t>(static_cast<unsigned char>(padded[i])) << 16 |
+                             static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 1])) << 8 |
+                             static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 2])));
+        }
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    }
+
+    // Same as the "fullname" of the JsonConverter, the compounds are qualified already
+    std::string fullnameOf(const Doxybook2::Node& node) {
+        const auto parent = node.getParent();
+        if (!node.isStructured() && parent != nullptr && parent->isStructured()) {
+            return parent->getName() + "::" + node.getName();
+        }
+        return node.getName();
+    }
+
+    template <typename T> void append(std::string& out, const std::vector<T>& items) {
+        out.append(reinterpret_cast<const char*>(items.data()), items.size() * sizeof(T));
+    }
+} // namespace
+
+std::string Doxybook2::SymbolIndex::build(const Node& index, const std::function<bool(const Node&)>& filter) {
+    // Every node once, the members of a group are the children of the group
+    // and of their class or namespace as well
+    std::vector<const Node*> nodes;
+    std::unordered_map<const Node*, Id> ids;
+    std::function<void(const Node&)> collect = [&](const Node& parent) {
+        for (const auto& child : parent.getChildren()) {
+            if (filter && !filter(*child)) {
+                continue;
+            }
+            if (ids.emplace(child.get(), static_cast<Id>(nodes.size())).second) {
+                nodes.push_back(child.get());
+                collect(*child);
+            }
+        }
+    };
+    collect(index);
+
+    StringTable strings;
+    std::vector<Record> records;
+    std::vector<Key> keys;
+    std::vector<uint32_t> children;
+    std::unordered_map<uint32_t, std::vector<Id>> postings;
+    records.reserve(nodes.size());
+
+    for (Id id = 0; id < nodes.size(); id++) {
+        const auto& node = *nodes[id];
+        const auto fullname = fullnameOf(node);
+        const auto trigrams = trigramsOf(fullname);
+
+        Record record{};
+        record.fullname = strings.add(fullname);
+        record.name = strings.add(node.getName());
+        record.title = strings.add(node.getTitle());
+        record.kind = strings.add(toStr(node.getKind()));
+        record.refid = strings.add(node.getRefid());
+        record.url = strings.add(node.getUrl());
+        record.brief = strings.add(node.getSummary());
+        const auto parent = node.getParent() != nullptr ? ids.find(node.getParent()) : ids.end();
+        record.parent = parent != ids.end() ? parent->second : NONE;
+        record.childrenOffset = static_cast<uint32_t>(children.size());
+        for (const auto& child : node.getChildren()) {
+            const auto found = ids.find(child.get());
+            if (found != ids.end()) {
+                children.push_back(found->second);
+            }
+        }
+        record.childrenCount = static_cast<uint32_t>(children.size()) - record.childrenOffset;
+        record.trigrams = static_cast<uint32_t>(trigrams.size());
+        records.push_back(record);
+
+        keys.push_back({record.fullname, id});
+        if (node.getName() != fullname) {
+            keys.push_back({record.name, id});
+        }
+        if (!node.getTitle().empty() && node.getTitle() != node.getName() && node.getTitle() != fullname) {
+            keys.push_back({record.title, id});
+        }
+        for (const auto trigram : trigrams) {
+            postings[trigram].push_back(id);
+        }
+    }
+
+    const auto& blob = strings.get();
+    const auto keyOf = [&](const Key& key) { return std::string_view(blob.data() + key.key.offset, key.key.length); };
+    std::sort(keys.begin(), keys.end(), [&](const Key& a, const Key& b) {
+        const auto ka = keyOf(a);
+        const auto kb = keyOf(b);
+        return ka < kb || (ka == kb && a.id < b.id);
+    });
+
+    std::vector<Trigram> trigrams;
+    std::vector<uint32_t> postingsTable;
+    trigrams.reserve(postings.size());
+    for (const auto& [value, list] : postings) {
+        trigrams.push_back({value, 0, static_cast<uint32_t>(list.size())});
+    }
+    std::sort(trigrams.begin(), trigrams.end(), [](const Trigram& a, const Trigram& b) { return a.value < b.value; });
+    for (auto& trigram : trigrams) {
+        const auto& list = postings.at(trigram.value);
+        trigram.postingsOffset = static_cast<uint32_t>(postingsTable.size());
+        postingsTable.insert(postingsTable.end(), list.begin(), list.end());
+    }
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.byteOrder = ENDIAN_MARK;
+    header.symbols = static_cast<uint32_t>(records.size());
+    header.keys = static_cast<uint32_t>(keys.size());
+    header.trigrams = static_cast<uint32_t>(trigrams.size());
+    header.postings = static_cast<uint32_t>(postingsTable.size());
+    header.children = static_cast<uint32_t>(children.size());
+    header.strings = static_cast<uint32_t>(blob.size());
+    header.symbolsOffset = sizeof(Header);
+    header.keysOffset = header.symbolsOffset + header.symbols * sizeof(Record);
+    header.trigramsOffset = header.keysOffset + header.keys * sizeof(Key);
+    header.postingsOffset = header.trigramsOffset + header.trigrams * sizeof(Trigram);
+    header.childrenOffset = header.postingsOffset + header.postings * sizeof(uint32_t);
+    header.stringsOffset = header.childrenOffset + header.children * sizeof(uint32_t);
+
+    std::string out;
+    out.reserve(header.stringsOffset + blob.size());
+    out.append(reinterpret_cast<const char*>(&header), sizeof(Header));
+    append(out, records);
+    append(out, keys);
+    append(out, trigrams);
+    append(out, postingsTable);
+    append(out, children);
+    out += blob;
+    return out;
+}
+
+Doxybook2::SymbolIndex::SymbolIndex(const std::string& path) {
+#ifndef _WIN32
+    const auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw EXCEPTION("Failed to open symbol index {}", path);
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+        length = static_cast<size_t>(st.st_size);
+        mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            mapped = nullptr;
+        }
+    }
+    ::close(fd);
+    data = static_cast<const char*>(mapped);
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw EXCEPTION("Failed to open symbol index {}", path);
+    }
+    buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    data = buffer.data();
+    length = buffer.size();
+#endif
+
+    if (!isValid()) {
+        release();
+        throw EXCEPTION("File {} is not a symbol index or it has been created on another machine", path);
+    }
+}
+
+Doxybook2::SymbolIndex::~SymbolIndex() {
+    release();
+}
+
+void Doxybook2::SymbolIndex::release() {
+#ifndef _WIN32
+    if (mapped != nullptr) {
+        ::munmap(mapped, length);
+        mapped = nullptr;
+    }
+#endif
+    buffer.clear();
+    data = nullptr;
+    length = 0;
+}
+
+bool Doxybook2::SymbolIndex::isValid() const {
+    if (data == nullptr || length < sizeof(Header)) {
+        return false;
+    }
+    const auto& header = *table<Header>(0);
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.byteOrder != ENDIAN_MARK) {
+        return false;
+    }
+    // Each table has to fit into the file, as 64 bit so that nothing overflows
+    const auto fits = [&](const uint64_t offset, const uint64_t count, const uint64_t size) {
+        return offset % 4 == 0 && offset + count * size <= length;
+    };
+    return fits(header.symbolsOffset, header.symbols, sizeof(Record)) &&
+           fits(header.keysOffset, header.keys, sizeof(Key)) &&
+           fits(header.trigramsOffset, header.trigrams, sizeof(Trigram)) &&
+           fits(header.postingsOffset, header.postings, sizeof(uint32_t)) &&
+           fits(header.childrenOffset, header.children, sizeof(uint32_t)) &&
+           static_cast<uint64_t>(header.stringsOffset) + header.strings <= length;
+}
+
+size_t Doxybook2::SymbolIndex::size() const {
+    return table<Header>(0)->symbols;
+}
+
+Doxybook2::SymbolIndex::Symbol Doxybook2::SymbolIndex::get(const Id id) const {
+    const auto& header = *table<Header>(0);
+    if (id >= header.symbols) {
+        throw EXCEPTION("Symbol {} is out of range of the {} symbols", id, header.symbols);
+    }
+    const auto& record = table<Record>(header.symbolsOffset)[id];
+    const auto str = [&](const Str& s) {
+        if (static_cast<uint64_t>(s.offset) + s.length > header.strings) {
+            throw EXCEPTION("Symbol {} is corrupted", id);
+        }
+        return std::string_view(data + header.stringsOffset + s.offset, s.length);
+    };
+
+    Symbol symbol;
+    symbol.id = id;
+    symbol.fullname = str(record.fullname);
+    symbol.name = str(record.name);
+    symbol.title = str(record.title);
+    symbol.kind = str(record.kind);
+    symbol.refid = str(record.refid);
+    symbol.url = str(record.url);
+    symbol.brief = str(record.brief);
+    symbol.parent = record.parent;
+    return symbol;
+}
+
+std::vector<Doxybook2::SymbolIndex::Symbol> Doxybook2::SymbolIndex::getChildren(const Id id) const {
+    const auto& header = *table<Header>(0);
+    const auto& record = table<Record>(header.symbolsOffset)[get(id).id];
+    std::vector<Symbol> result;
+    if (static_cast<uint64_t>(record.childrenOffset) + record.childrenCount > header.children) {
+        throw EXCEPTION("Symbol {} is corrupted", id);
+    }
+    const auto children = table<uint32_t>(header.childrenOffset) + record.childrenOffset;
+    for (uint32_t i = 0; i < record.childrenCount; i++) {
+        result.push_back(get(children[i]));
+    }
+    return result;
+}
+
+std::vector<Doxybook2::SymbolIndex::Symbol> Doxybook2::SymbolIndex::findExact(const std::string& name) const {
+    return findKeys(name, true, 0);
+}
+
+std::vector<Doxybook2::SymbolIndex::Symbol> Doxybook2::SymbolIndex::findPrefix(const std::string& prefix,
+    const size_t limit) const {
+    return findKeys(prefix, false, limit);
+}
+
+std::vector<Doxybook2::SymbolIndex::Symbol> Doxybook2::SymbolIndex::findKeys(const std::string& prefix,
+    const bool exact,
+    const size_t limit) const {
+
+    const auto& header = *table<Header>(0);
+    const auto begin = table<Key>(header.keysOffset);
+    const auto end = begin + header.keys;
+    const auto keyOf = [&](const Key& key) {
+        return std::string_view(data + header.stringsOffset + key.key.offset, key.key.length);
+    };
+
+    std::vector<Symbol> result;
+    std::unordered_set<Id> seen;
+    auto it = std::lower_bound(
+        begin, end, std::string_view(prefix), [&](const Key& key, const std::string_view& value) {
+            return keyOf(key) < value;
+        });
+    for (; it != end; ++it) {
+        const auto key = keyOf(*it);
+        if (exact ? key != prefix : key.compare(0, prefix.size(), prefix) != 0) {
+            break;
+        }
+        if (seen.insert(it->id).second) {
+            result.push_back(get(it->id));
+            if (limit != 0 && result.size() >= limit) {
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<Doxybook2::SymbolIndex::Match> Doxybook2::SymbolIndex::findFuzzy(const std::string& query,
+    const size_t limit,
+    const double minScore) const {
+
+    const auto& header = *table<Header>(0);
+    const auto queryTrigrams = trigramsOf(query);
+    const auto begin = table<Trigram>(header.trigramsOffset);
+    const auto end = begin + header.trigrams;
+    const auto postings = table<uint32_t>(header.postingsOffset);
+
+    // Number of the trigrams of the query in each of the symbols
+    std::vector<uint32_t> common(header.symbols, 0);
+    for (const auto value : queryTrigrams) {
+        const auto found =
+            std::lower_bound(begin, end, value, [](const Trigram& t, const uint32_t v) { return t.value < v; });
+        if (found == end || found->value != value ||
+            static_cast<uint64_t>(found->postingsOffset) + found->postingsCount > header.postings) {
+            continue;
+        }
+        for (uint32_t i = 0; i < found->postingsCount; i++) {
+            const auto id = postings[found->postingsOffset + i];
+            if (id < header.symbols) {
+                common[id]++;
+            }
+        }
+    }
+
+    const auto records = table<Record>(header.symbolsOffset);
+    std::vector<Match> result;
+    for (Id id = 0; id < header.symbols; id++) {
+        if (common[id] == 0) {
+            continue;
+        }
+        const auto all = queryTrigrams.size() + records[id].trigrams - common[id];
+        const auto score = static_cast<double>(common[id]) / static_cast<double>(all);
+        if (score >= minScore) {
+            result.push_back({get(id), score});
+        }
+    }
+
+    std::sort(result.begin(), result.end(), [](const Match& a, const Match& b) {
+        return a.score > b.score || (a.score == b.score && a.symbol.fullname < b.symbol.fullname);
+    });
+    if (limit != 0 && result.size() > limit) {
+        result.resize(limit);
+    }
+    return result;
+}
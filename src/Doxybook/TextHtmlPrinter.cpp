@@ -0,0 +1,412 @@
+#include <Doxybook/Doxygen.hpp>
+#include <Doxybook/TextHtmlPrinter.hpp>
+#include <Doxybook/Utils.hpp>
+#include <fstream>
+#include <sstream>
+
+static int headingLevel(const Doxybook2::XmlTextParser::Node* node) {
+    if (node == nullptr) {
+        return 0;
+    }
+    switch (node->type) {
+        case Doxybook2::XmlTextParser::Node::Type::SECT1:
+            return 1;
+        case Doxybook2::XmlTextParser::Node::Type::SECT2:
+            return 2;
+        case Doxybook2::XmlTextParser::Node::Type::SECT3:
+            return 3;
+        case Doxybook2::XmlTextParser::Node::Type::SECT4:
+            return 4;
+        case Doxybook2::XmlTextParser::Node::Type::SECT5:
+            return 5;
+        case Doxybook2::XmlTextParser::Node::Type::SECT6:
+            return 6;
+        default:
+            return 0;
+    }
+}
+
+std::string Doxybook2::TextHtmlPrinter::print(const XmlTextParser::Node& node, const std::string& language) const {
+    PrintData data;
+    // A single paragraph (i.e. a brief) is printed without the <p> so it can be
+    // put inline into the tables and the headings of the templates.
+    if (node.type == XmlTextParser::Node::Type::PARAS && node.children.size() == 1 &&
+        node.children.front().type == XmlTextParser::Node::Type::PARA) {
+        for (const auto& child : node.children.front().children) {
+            print(data, &node.children.front(), &child, language);
+        }
+    } else {
+        print(data, nullptr, &node, language);
+    }
+    auto str = data.ss.str();
+    while (!str.empty() && str.back() == '\n')
+        str.pop_back();
+    return str;
+}
+
+void Doxybook2::TextHtmlPrinter::print(PrintData& data,
+    const XmlTextParser::Node* parent,
+    const XmlTextParser::Node* node,
+    const std::string& language) const {
+
+    const auto paragraph = node->type == XmlTextParser::Node::Type::PARA && parent &&
+                           parent->type != XmlTextParser::Node::Type::LISTITEM &&
+                           parent->type != XmlTextParser::Node::Type::TABLE_CELL;
+
+    switch (node->type) {
+        case XmlTextParser::Node::Type::TEXT: {
+            data.ss << Utils::escapeHtml(node->data);
+            break;
+        }
+        case XmlTextParser::Node::Type::PARA: {
+            if (paragraph) {
+                data.ss << "<p>";
+            }
+            break;
+        }
+        case XmlTextParser::Node::Type::TITLE: {
+            const auto level = headingLevel(parent);
+            if (level > 0) {
+                data.ss << "\n<h" << level << ">";
+            } else {
+                data.ss << "<strong>";
+            }
+            break;
+        }
+        case XmlTextParser::Node::Type::BOLD: {
+            data.ss << "<strong>";
+            break;
+        }
+        case XmlTextParser::Node::Type::EMPHASIS: {
+            data.ss << "<em>";
+            break;
+        }
+        case XmlTextParser::Node::Type::STRIKE: {
+            data.ss << "<del>";
+            break;
+        }
+        case XmlTextParser::Node::Type::SUPERSCRIPT: {
+            data.ss << "<sup>";
+            break;
+        }
+        case XmlTextParser::Node::Type::ITEMIZEDLIST: {
+            data.ss << "\n<ul>\n";
+            data.lists.push_back(false);
+            break;
+        }
+        case XmlTextParser::Node::Type::ORDEREDLIST: {
+            data.ss << "\n<ol>\n";
+            data.lists.push_back(false);
+            break;
+        }
+        case XmlTextParser::Node::Type::VARIABLELIST: {
+            data.ss << "\n<dl>\n";
+            data.lists.push_back(true);
+            break;
+        }
+        case XmlTextParser::Node::Type::VARLISTENTRY: {
+            data.ss << "<dt>";
+            break;
+        }
+        case XmlTextParser::Node::Type::LISTITEM: {
+            data.ss << (!data.lists.empty() && data.lists.back() ? "<dd>" : "<li>");
+            break;
+        }
+        case XmlTextParser::Node::Type::ULINK: {
+            if (!node->extra.empty()) {
+                data.ss << "<a href=\"" << Utils::escapeHtml(node->extra) << "\">";
+                data.validLink = true;
+            }
+            break;
+        }
+        case XmlTextParser::Node::Type::REF: {
+            const auto found = doxygen.getCache().find(node->extra);
+            if (found != doxygen.getCache().end() && !found->second->getUrl().empty()) {
+                data.ss << "<a href=\"" << Utils::escapeHtml(found->second->getUrl()) << "\">";
+                data.validLink = true;
+            }
+            break;
+        }
+        case XmlTextParser::Node::Type::IMAGE: {
+            const auto image = config.copyImages ? copyImage(node->extra) : node->extra;
+            const auto prefix = config.baseUrl + config.imagesFolder;
+            const auto name = config.imagesFolder.empty() ? image : shardPath(config, image);
+            const auto src = prefix + (prefix.empty() ? "" : "/") + name;
+            data.ss << "<img src=\"" << Utils::escapeHtml(src) << "\" alt=\"" << Utils::escapeHtml(node->extra)
+                    << "\"/>";
+            break;
+        }
+        case XmlTextParser::Node::Type::COMPUTEROUTPUT: {
+            data.ss << "<code>";
+            break;
+        }
+        case XmlTextParser::Node::Type::PROGRAMLISTING: {
+            auto lang = language;
+            const auto i = node->extra.find_last_of('.');
+            if (i != std::string::npos) {
+                lang = Utils::normalizeLanguage(node->extra.substr(i + 1));
+            }
+            data.ss << "\n<pre><code class=\"language-" << Utils::escapeHtml(lang) << "\">";
+            break;
+        }
+        case XmlTextParser::Node::Type::VERBATIM: {
+            data.ss << "\n<pre>";
+            break;
+        }
+        case XmlTextParser::Node::Type::BLOCKQUOTE: {
+            data.ss << "\n<blockquote>\n";
+            break;
+        }
+        case XmlTextParser::Node::Type::SP: {
+            data.ss << " ";
+            break;
+        }
+        case XmlTextParser::Node::Type::HRULER: {
+            data.ss << "\n<hr/>\n";
+            break;
+        }
+        case XmlTextParser::Node::Type::NONBREAKSPACE: {
+            data.ss << "&nbsp;";
+            break;
+        }
+        case XmlTextParser::Node::Type::TABLE: {
+            data.ss << "\n<table>\n";
+            data.tableHeader = true;
+            break;
+        }
+        case XmlTextParser::Node::Type::TABLE_ROW: {
+            data.ss << "<tr>";
+            break;
+        }
+        case XmlTextParser::Node::Type::TABLE_CELL: {
+            // Same as the Markdown tables, the first row is the header
+            data.ss << (data.tableHeader ? "<th>" : "<td>");
+            break;
+        }
+        case XmlTextParser::Node::Type::SQUO: {
+            data.ss << "&quot;";
+            break;
+        }
+        case XmlTextParser::Node::Type::NDASH: {
+            data.ss << "&ndash;";
+            break;
+        }
+        case XmlTextParser::Node::Type::MDASH: {
+            data.ss << "&mdash;";
+            break;
+        }
+        case XmlTextParser::Node::Type::LINEBREAK: {
+            data.ss << "<br/>\n";
+            break;
+        }
+        case XmlTextParser::Node::Type::ONLYFOR: {
+            data.ss << "(";
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+
+    switch (node->type) {
+        case XmlTextParser::Node::Type::PROGRAMLISTING: {
+            programlisting(data, *node);
+            break;
+        }
+        case XmlTextParser::Node::Type::FORMULA: {
+            if (node->children.empty()) {
+                break;
+            }
+            const auto& formula = node->children.front().data;
+            if (formula.empty()) {
+                break;
+            }
+            if (formula[0] == '$' && formula.size() >= 3) {
+                data.ss << config.formulaInlineStart;
+                data.ss << Utils::escapeHtml(formula.substr(1, formula.size() - 2));
+                data.ss << config.formulaInlineEnd;
+            } else if (formula.find("\\[") == 0 && formula.size() >= 5) {
+                data.ss << config.formulaBlockStart;
+                data.ss << Utils::escapeHtml(formula.substr(2, formula.size() - 4));
+                data.ss << config.formulaBlockEnd;
+            }
+            break;
+        }
+        default: {
+            for (const auto& child : node->children) {
+                print(data, node, &child, language);
+            }
+        }
+    }
+
+    switch (node->type) {
+        case XmlTextParser::Node::Type::PARA: {
+            if (paragraph) {
+                data.ss << "</p>\n";
+            }
+            break;
+        }
+        case XmlTextParser::Node::Type::TITLE: {
+            const auto level = headingLevel(parent);
+            if (level > 0) {
+                data.ss << "</h" << level << ">\n";
+            } else {
+                data.ss << "</strong>";
+            }
+            break;
+        }
+        case XmlTextParser::Node::Type::BOLD: {
+            data.ss << "</strong>";
+            break;
+        }
+        case XmlTextParser::Node::Type::EMPHASIS: {
+            data.ss << "</em>";
+            break;
+        }
+        case XmlTextParser::Node::Type::STRIKE: {
+            data.ss << "</del>";
+            break;
+        }
+        case XmlTextParser::Node::Type::SUPERSCRIPT: {
+            data.ss << "</sup>";
+            break;
+        }
+        case XmlTextParser::Node::Type::ITEMIZEDLIST: {
+            data.ss << "</ul>\n";
+            data.lists.pop_back();
+            break;
+        }
+        case XmlTextParser::Node::Type::ORDEREDLIST: {
+            data.ss << "</ol>\n";
+            data.lists.pop_back();
+            break;
+        }
+        case XmlTextParser::Node::Type::VARIABLELIST: {
+            data.ss << "</dl>\n";
+            data.lists.pop_back();
+            break;
+        }
+        case XmlTextParser::Node::Type::VARLISTENTRY: {
+            data.ss << "</dt>\n";
+            break;
+        }
+        case XmlTextParser::Node::Type::LISTITEM: {
+            data.ss << (!data.lists.empty() && data.lists.back() ? "</dd>\n" : "</li>\n");
+            break;
+        }
+        case XmlTextParser::Node::Type::ULINK:
+        case XmlTextParser::Node::Type::REF: {
+            if (data.validLink) {
+                data.ss << "</a>";
+            }
+            data.validLink = false;
+            break;
+        }
+        case XmlTextParser::Node::Type::COMPUTEROUTPUT: {
+            data.ss << "</code>";
+            break;
+        }
+        case XmlTextParser::Node::Type::PROGRAMLISTING: {
+            data.ss << "</code></pre>\n";
+            if (!node->extra.empty() && node->extra.find_last_of('.') != 0) {
+                // If it's not only the extension name, output the filename
+                data.ss << "<p><em>Filename: " << Utils::escapeHtml(node->extra) << "</em></p>\n";
+            }
+            break;
+        }
+        case XmlTextParser::Node::Type::VERBATIM: {
+            data.ss << "</pre>\n";
+            break;
+        }
+        case XmlTextParser::Node::Type::BLOCKQUOTE: {
+            data.ss << "</blockquote>\n";
+            break;
+        }
+        case XmlTextParser::Node::Type::TABLE: {
+            data.ss << "</table>\n";
+            data.tableHeader = false;
+            break;
+        }
+        case XmlTextParser::Node::Type::TABLE_ROW: {
+            data.ss << "</tr>\n";
+            data.tableHeader = false;
+            break;
+        }
+        case XmlTextParser::Node::Type::TABLE_CELL: {
+            data.ss << (data.tableHeader ? "</th>" : "</td>");
+            break;
+        }
+        case XmlTextParser::Node::Type::ONLYFOR: {
+            data.ss << ")";
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+}
+
+void Doxybook2::TextHtmlPrinter::programlisting(PrintData& data, const XmlTextParser::Node& node) const {
+    switch (node.type) {
+        case XmlTextParser::Node::Type::TEXT: {
+            data.ss << Utils::escapeHtml(node.data);
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+
+    for (const auto& child : node.children) {
+        programlisting(data, child);
+    }
+
+    switch (node.type) {
+        case XmlTextParser::Node::Type::CODELINE: {
+            data.ss << "\n";
+            break;
+        }
+        case XmlTextParser::Node::Type::SP: {
+            data.ss << " ";
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+}
+
+std::string Doxybook2::TextHtmlPrinter::copyImage(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(imagesMutex);
+    const auto found = copiedImages.find(name);
+    if (found != copiedImages.end()) {
+        return found->second;
+    }
+    auto& copied = copiedImages[name];
+    copied = name;
+
+    std::ifstream src(Utils::join(inputDir, name), std::ios::binary);
+    if (!src) {
+        return copied;
+    }
+    const std::string contents((std::istreambuf_iterator<char>(src)), std::istreambuf_iterator<char>());
+    if (config.hashImageNames) {
+        copied = Hash::fileName(name, Hash::of(contents));
+    }
+
+    const auto path = config.useFolders && !config.imagesFolder.empty()
+                          ? Utils::join(config.imagesFolder, shardPath(config, copied))
+                          : copied;
+    if (output != nullptr) {
+        output->write(path, contents);
+    } else {
+        const auto shard = shardFolderName(config, copied);
+        if (!shard.empty() && !config.imagesFolder.empty()) {
+            Utils::createDirectory(Utils::join(config.outputDir, config.imagesFolder, shard));
+        }
+        std::ofstream dst(Utils::join(config.outputDir, path), std::ios::binary);
+        if (dst)
+            dst.write(contents.data(), contents.size());
+    }
+    return copied;
+}
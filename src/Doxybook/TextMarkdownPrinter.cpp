@@ -4,15 +4,108 @@
 #include <fstream>
 #include <sstream>
 
+namespace {
+    struct HtmlCodePolicy;
+
+    // Links as [text](url) and inline code as `code`
+    struct MarkdownPolicy {
+        // The policy used for the contents of the inline code
+        typedef MarkdownPolicy Code;
+
+        static void text(std::ostream& ss, const std::string& str) {
+            ss << str;
+        }
+
+        static void codeBegin(std::ostream& ss) {
+            ss << "`";
+        }
+
+        static void codeEnd(std::ostream& ss) {
+            ss << "`";
+        }
+
+        // The url is null if the link has no target, returns true if the link has been opened
+        static bool linkBegin(std::ostream& ss, const std::string* url) {
+            ss << "[";
+            return true;
+        }
+
+        static void linkEnd(std::ostream& ss, const std::string* url, const bool opened) {
+            ss << "]";
+            if (url != nullptr) {
+                ss << "(" << *url << ")";
+            }
+        }
+    };
+
+    // Links as <a> tags and inline code as <code> tags (config.linkAndInlineCodeAsHTML)
+    struct HtmlLinksPolicy {
+        typedef HtmlCodePolicy Code;
+
+        static void text(std::ostream& ss, const std::string& str) {
+            ss << str;
+        }
+
+        static void codeBegin(std::ostream& ss) {
+            ss << "<code>";
+        }
+
+        static void codeEnd(std::ostream& ss) {
+            ss << "</code>";
+        }
+
+        static bool linkBegin(std::ostream& ss, const std::string* url) {
+            if (url == nullptr || url->empty()) {
+                return false;
+            }
+            ss << "<a href=\"" << *url << "\">";
+            return true;
+        }
+
+        static void linkEnd(std::ostream& ss, const std::string* url, const bool opened) {
+            if (opened) {
+                ss << "</a>";
+            }
+        }
+    };
+
+    // Markdown is not processed inside of the <code> tags, the text has to be escaped
+    struct HtmlCodePolicy : HtmlLinksPolicy {
+        typedef HtmlCodePolicy Code;
+
+        static void text(std::ostream& ss, const std::string& str) {
+            ss << Doxybook2::Utils::escape(str);
+        }
+    };
+
+    template <bool Quote> void newline(std::ostream& ss, const char* prefix = "> ") {
+        ss << "\n";
+        if constexpr (Quote) {
+            ss << prefix;
+        }
+    }
+} // namespace
+
+Doxybook2::TextMarkdownPrinter::TextMarkdownPrinter(
+    const Config& config, std::string inputDir, const Doxygen& doxygen, Output* output)
+    : TextPrinter(config, doxygen), inputDir(std::move(inputDir)), output(output) {
+    if (config.linkAndInlineCodeAsHTML) {
+        printFunc = &TextMarkdownPrinter::print<HtmlLinksPolicy, false>;
+    } else {
+        printFunc = &TextMarkdownPrinter::print<MarkdownPolicy, false>;
+    }
+}
+
 std::string Doxybook2::TextMarkdownPrinter::print(const XmlTextParser::Node& node, const std::string& language) const {
     PrintData data;
-    print(data, nullptr, &node, nullptr, nullptr, language);
+    (this->*printFunc)(data, nullptr, &node, nullptr, nullptr, language);
     auto str = data.ss.str();
     while (!str.empty() && str.back() == '\n')
         str.pop_back();
     return str;
 }
 
+template <typename Policy, bool Quote>
 void Doxybook2::TextMarkdownPrinter::print(PrintData& data,
     const XmlTextParser::Node* parent,
     const XmlTextParser::Node* node,
@@ -20,20 +113,19 @@ void Doxybook2::TextMarkdownPrinter::print(PrintData& data,
     const XmlTextParser::Node* next,
     const std::string& language) const {
 
-    auto newline = [&] {
-        data.ss << "\n";
-        if (data.quote) {
-            data.ss << "> ";
+    const auto newline = [&] { ::newline<Quote>(data.ss); };
+
+    const auto children = [&](auto self) {
+        for (size_t i = 0; i < node->children.size(); i++) {
+            const auto childNext = i + 1 < node->children.size() ? &node->children[i + 1] : nullptr;
+            const auto childPrevious = i > 0 ? &node->children[i - 1] : nullptr;
+            (this->*self)(data, node, &node->children[i], childPrevious, childNext, language);
         }
     };
 
     switch (node->type) {
         case XmlTextParser::Node::Type::TEXT: {
-            if (config.linkAndInlineCodeAsHTML && data.inComputerOutput) {
-                data.ss << Utils::escape(node->data);
-            } else {
-                data.ss << node->data;
-            }
+            Policy::text(data.ss, node->data);
             data.eol = false;
             break;
         }
@@ -112,56 +204,27 @@ void Doxybook2::TextMarkdownPrinter::print(PrintData& data,
             break;
         }
         case XmlTextParser::Node::Type::ULINK: {
-            if (config.linkAndInlineCodeAsHTML) {
-                if (!node->extra.empty()) {
-                    data.ss << "<a href=\"" << node->extra << "\">";
-                    data.validLink = true;
-                }
-            } else {
-                data.ss << "[";
-            }
+            data.validLink = Policy::linkBegin(data.ss, node->extra.empty() ? nullptr : &node->extra);
             data.eol = false;
             break;
         }
         case XmlTextParser::Node::Type::REF: {
-            if (config.linkAndInlineCodeAsHTML) {
-                const auto found = doxygen.getCache().find(node->extra);
-                if (found != doxygen.getCache().end() && !found->second->getUrl().empty()) {
-                    data.ss << "<a href=\"" << found->second->getUrl() << "\">";
-                    data.validLink = true;
-                }
-            } else {
-                data.ss << "[";
-            }
+            const auto found = doxygen.getCache().find(node->extra);
+            data.validLink = Policy::linkBegin(
+                data.ss, found != doxygen.getCache().end() ? &found->second->getUrl() : nullptr);
             data.eol = false;
             break;
         }
         case XmlTextParser::Node::Type::IMAGE: {
+            const auto image = config.copyImages ? copyImage(node->extra) : node->extra;
             const auto prefix = config.baseUrl + config.imagesFolder;
-            data.ss << "![" << node->extra << "](" << prefix << (prefix.empty() ? "" : "/") << node->extra << ")";
-            data.eol = false;
-            if (config.copyImages) {
-                std::ifstream src(Utils::join(inputDir, node->extra), std::ios::binary);
-                if (src && config.useFolders && !config.imagesFolder.empty()) {
-                    std::ofstream dst(
-                        Utils::join(config.outputDir, config.imagesFolder, node->extra), std::ios::binary);
-                    if (dst)
-                        dst << src.rdbuf();
-                } else if (src) {
-                    std::ofstream dst(Utils::join(config.outputDir, node->extra), std::ios::binary);
-                    if (dst)
-                        dst << src.rdbuf();
-                }
-            }
+            const auto name = config.imagesFolder.empty() ? image : shardPath(config, image);
+            data.ss << "![" << node->extra << "](" << prefix << (prefix.empty() ? "" : "/") << name << ")";
+            data.eol = false;
             break;
         }
         case XmlTextParser::Node::Type::COMPUTEROUTPUT: {
-            if (config.linkAndInlineCodeAsHTML) {
-                data.ss << "<code>";
-            } else {
-                data.ss << "`";
-            }
-            data.inComputerOutput = true;
+            Policy::codeBegin(data.ss);
             data.eol = false;
             break;
         }
@@ -192,8 +255,7 @@ void Doxybook2::TextMarkdownPrinter::print(PrintData& data,
         }
         case XmlTextParser::Node::Type::BLOCKQUOTE: {
             newline();
-            data.quote = true;
-            newline();
+            ::newline<true>(data.ss);
             data.eol = true;
             break;
         }
@@ -273,7 +335,15 @@ void Doxybook2::TextMarkdownPrinter::print(PrintData& data,
 
     switch (node->type) {
         case XmlTextParser::Node::Type::PROGRAMLISTING: {
-            programlisting(data, *node);
+            programlisting<Quote>(data, *node);
+            break;
+        }
+        case XmlTextParser::Node::Type::COMPUTEROUTPUT: {
+            children(&TextMarkdownPrinter::print<typename Policy::Code, Quote>);
+            break;
+        }
+        case XmlTextParser::Node::Type::BLOCKQUOTE: {
+            children(&TextMarkdownPrinter::print<Policy, true>);
             break;
         }
         case XmlTextParser::Node::Type::FORMULA: {
@@ -297,11 +367,7 @@ void Doxybook2::TextMarkdownPrinter::print(PrintData& data,
             break;
         }
         default: {
-            for (size_t i = 0; i < node->children.size(); i++) {
-                const auto childNext = i + 1 < node->children.size() ? &node->children[i + 1] : nullptr;
-                const auto childPrevious = i > 0 ? &node->children[i - 1] : nullptr;
-                print(data, node, &node->children[i], childPrevious, childNext, language);
-            }
+            children(&TextMarkdownPrinter::print<Policy, Quote>);
         }
     }
 
@@ -328,40 +394,22 @@ void Doxybook2::TextMarkdownPrinter::print(PrintData& data,
             break;
         }
         case XmlTextParser::Node::Type::ULINK: {
-            if (config.linkAndInlineCodeAsHTML) {
-                if (data.validLink) {
-                    data.ss << "</a>";
-                }
-            } else {
-                data.ss << "]";
-                if (!node->extra.empty()) {
-                    data.ss << "(" << node->extra << ")";
-                }
-            }
+            Policy::linkEnd(data.ss, node->extra.empty() ? nullptr : &node->extra, data.validLink);
             data.validLink = false;
             data.eol = false;
             break;
         }
         case XmlTextParser::Node::Type::REF: {
-            if (config.linkAndInlineCodeAsHTML) {
-                if (data.validLink) {
-                    data.ss << "</a>";
-                }
-            } else {
-                data.ss << "]";
-                const auto found = doxygen.getCache().find(node->extra);
-                if (found != doxygen.getCache().end()) {
-                    data.ss << "(" << found->second->getUrl() << ")";
-                }
-            }
+            const auto found = doxygen.getCache().find(node->extra);
+            Policy::linkEnd(
+                data.ss, found != doxygen.getCache().end() ? &found->second->getUrl() : nullptr, data.validLink);
             data.validLink = false;
             data.eol = false;
             break;
         }
         case XmlTextParser::Node::Type::BLOCKQUOTE: {
-            data.quote = false;
-            newline();
-            newline();
+            ::newline<false>(data.ss);
+            ::newline<false>(data.ss);
             data.eol = true;
             break;
         }
@@ -384,12 +432,7 @@ void Doxybook2::TextMarkdownPrinter::print(PrintData& data,
             break;
         }
         case XmlTextParser::Node::Type::COMPUTEROUTPUT: {
-            if (config.linkAndInlineCodeAsHTML) {
-                data.ss << "</code>";
-            } else {
-                data.ss << "`";
-            }
-            data.inComputerOutput = false;
+            Policy::codeEnd(data.ss);
             data.eol = false;
             break;
         }
@@ -474,6 +517,7 @@ void Doxybook2::TextMarkdownPrinter::print(PrintData& data,
     }
 }
 
+template <bool Quote>
 void Doxybook2::TextMarkdownPrinter::programlisting(PrintData& data, const XmlTextParser::Node& node) const {
     switch (node.type) {
         case XmlTextParser::Node::Type::TEXT: {
@@ -485,20 +529,13 @@ void Doxybook2::TextMarkdownPrinter::programlisting(PrintData& data, const XmlTe
         }
     }
 
-    auto newline = [&] {
-        data.ss << "\n";
-        if (data.quote) {
-            data.ss << ">> ";
-        }
-    };
-
     for (const auto& child : node.children) {
-        programlisting(data, child);
+        programlisting<Quote>(data, child);
     }
 
     switch (node.type) {
         case XmlTextParser::Node::Type::CODELINE: {
-            newline();
+            ::newline<Quote>(data.ss, ">> ");
             break;
         }
         case XmlTextParser::Node::Type::SP: {
@@ -510,3 +547,45 @@ void Doxybook2::TextMarkdownPrinter::programlisting(PrintData& data, const XmlTe
         }
     }
 }
+
+std::string Doxybook2::TextMarkdownPrinter::copyImage(const std::string& name) const {
+    // The pages are printed from multiple threads and the same image
+    // can be used by many pages, copy it only once.
+    std::lock_guard<std::mutex> lock(imagesMutex);
+    const auto found = copiedImages.find(name);
+    if (found != copiedImages.end()) {
+        return found->second;
+    }
+    auto& copied = copiedImages[name];
+    copied = name;
+
+    std::ifstream src(Utils::join(inputDir, name), std::ios::binary);
+    if (!src) {
+        return copied;
+    }
+    const std::string contents((std::istreambuf_iterator<char>(src)), std::istreambuf_iterator<char>());
+    if (config.hashImageNames) {
+        copied = Hash::fileName(name, Hash::of(contents));
+    }
+
+    if (output != nullptr) {
+        const auto path = config.useFolders && !config.imagesFolder.empty()
+                              ? Utils::join(config.imagesFolder, shardPath(config, copied))
+                              : copied;
+        output->write(path, contents);
+    } else if (config.useFolders && !config.imagesFolder.empty()) {
+        const auto shard = shardFolderName(config, copied);
+        if (!shard.empty()) {
+            Utils::createDirectory(Utils::join(config.outputDir, config.imagesFolder, shard));
+        }
+        std::ofstream dst(
+            Utils::join(config.outputDir, config.imagesFolder, shardPath(config, copied)), std::ios::binary);
+        if (dst)
+            dst.write(contents.data(), contents.size());
+    } else {
+        std::ofstream dst(Utils::join(config.outputDir, copied), std::ios::binary);
+        if (dst)
+            dst.write(contents.data(), contents.size());
+    }
+    return copied;
+}
@@ -0,0 +1,302 @@
+#include "ExceptionUtils.hpp"
+#include <Doxybook/TextStore.hpp>
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+// Encoded text is a sequence of tokens:
+//   0xxxxxxx                    - literal run of x + 1 bytes that follow
+//   1xxxxxxx <varint distance>  - copy x + MIN_MATCH bytes from distance bytes back
+// The distance reaches back into the decoded text and further into the dictionary,
+// as if the dictionary was placed right in front of the text.
+static constexpr size_t MIN_MATCH = 4;
+static constexpr size_t MAX_MATCH = 0x7f + MIN_MATCH;
+static constexpr size_t MAX_LITERALS = 0x80;
+static constexpr size_t MAX_CHAIN = 32;
+static constexpr size_t DICTIONARY_HASH_BITS = 15;
+
+static uint32_t hash4(const char* data) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < MIN_MATCH; i++) {
+        value = (value << 8) | static_cast<unsigned char>(data[i]);
+    }
+    return (value * 2654435761U) >> (32 - DICTIONARY_HASH_BITS);
+}
+
+static size_t varintSize(size_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        size++;
+    }
+    return size;
+}
+
+static void writeVarint(std::string& out, size_t value) {
+    while (value >= 0x80) {
+        out += static_cast<char>((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+static size_t readVarint(const char*& ptr) {
+    size_t value = 0;
+    size_t shift = 0;
+    while (true) {
+        const auto byte = static_cast<unsigned char>(*ptr++);
+        value |= static_cast<size_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+        shift += 7;
+    }
+}
+
+Doxybook2::TextStore::TextStore() {
+    entries.push_back(Entry{0, 0, 0});
+}
+
+Doxybook2::TextStore::Id Doxybook2::TextStore::add(const std::string& text) {
+    if (text.empty()) {
+        return EMPTY;
+    }
+    if (compressed) {
+        return append(text);
+    }
+
+    const auto hash = Hash::of(text);
+    const auto range = index.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        const auto& entry = entries[it->second];
+        if (entry.length == text.size() && data.compare(entry.offset, entry.length, text) == 0) {
+            return it->second;
+        }
+    }
+    const auto id = append(text);
+    index.emplace(hash, id);
+    return id;
+}
+
+std::string Doxybook2::TextStore::get(const Id id) const {
+    assert(id < entries.size());
+    const auto& entry = entries[id];
+    if (entry.rawLength == 0) {
+        return data.substr(entry.offset, entry.length);
+    }
+    return decode(entry);
+}
+
+Doxybook2::TextStore::Id Doxybook2::TextStore::append(const std::string& text) {
+    if (entries.size() >= std::numeric_limits<Id>::max()) {
+        throw EXCEPTION("Too many texts in the text store");
+    }
+
+    Entry entry{static_cast<uint32_t>(data.size()), static_cast<uint32_t>(text.size()), 0};
+    if (compressed && text.size() >= minLength) {
+        const auto encoded = encode(text);
+        if (encoded.size() < text.size()) {
+            entry.length = static_cast<uint32_t>(encoded.size());
+            entry.rawLength = static_cast<uint32_t>(text.size());
+            data += encoded;
+        } else {
+            data += text;
+        }
+    } else {
+        data += text;
+    }
+    if (data.size() > std::numeric_limits<uint32_t>::max()) {
+        throw EXCEPTION("Text store is over 4GB");
+    }
+
+    entries.push_back(entry);
+    return static_cast<Id>(entries.size() - 1);
+}
+
+void Doxybook2::TextStore::compress(const size_t minLength, const size_t dictionarySize) {
+    if (compressed) {
+        return;
+    }
+
+    train(dictionarySize);
+
+    std::vector<std::string> texts;
+    texts.reserve(entries.size());
+    for (Id id = 0; id < entries.size(); id++) {
+        texts.push_back(get(id));
+    }
+
+    this->minLength = std::max<size_t>(minLength, MIN_MATCH);
+    compressed = true;
+    entries.clear();
+    data.clear();
+    index.clear();
+    index.rehash(0);
+
+    entries.push_back(Entry{0, 0, 0});
+    for (size_t i = 1; i < texts.size(); i++) {
+        append(texts[i]);
+        std::string().swap(texts[i]);
+    }
+    data.shrink_to_fit();
+    entries.shrink_to_fit();
+}
+
+void Doxybook2::TextStore::train(const size_t dictionarySize) {
+    // Words (with the space that follows) and pairs of words repeated across
+    // the texts, scored by the number of bytes they would save
+    std::unordered_map<std::string, size_t> counts;
+    for (Id id = 1; id < entries.size(); id++) {
+        const auto text = get(id);
+        size_t start = 0;
+        size_t previous = std::string::npos;
+        while (start < text.size()) {
+            auto end = text.find(' ', start);
+            end = end == std::string::npos ? text.size() : end + 1;
+            if (end - start >= MIN_MATCH) {
+                counts[text.substr(start, end - start)]++;
+            }
+            if (previous != std::string::npos) {
+                counts[text.substr(previous, end - previous)]++;
+            }
+            previous = start;
+            start = end;
+        }
+    }
+
+    std::vector<std::pair<size_t, const std::string*>> scored;
+    for (const auto& pair : counts) {
+        if (pair.second > 1 && pair.first.size() >= MIN_MATCH) {
+            scored.emplace_back((pair.second - 1) * pair.first.size(), &pair.first);
+        }
+    }
+    std::sort(scored.begin(), scored.end(), [](const auto& a, const auto& b) {
+        return a.first != b.first ? a.first > b.first : *a.second < *b.second;
+    });
+
+    // The best scoring words go last, closest to the text, so that the distances are short
+    std::vector<const std::string*> selected;
+    size_t total = 0;
+    for (const auto& pair : scored) {
+        if (total + pair.second->size() > dictionarySize) {
+            continue;
+        }
+        total += pair.second->size();
+        selected.push_back(pair.second);
+    }
+    dictionary.clear();
+    dictionary.reserve(total);
+    for (auto it = selected.rbegin(); it != selected.rend(); ++it) {
+        dictionary += **it;
+    }
+
+    dictionaryHead.assign(size_t(1) << DICTIONARY_HASH_BITS, -1);
+    dictionaryPrev.assign(dictionary.size(), -1);
+    for (size_t i = 0; i + MIN_MATCH <= dictionary.size(); i++) {
+        const auto hash = hash4(&dictionary[i]);
+        dictionaryPrev[i] = dictionaryHead[hash];
+        dictionaryHead[hash] = static_cast<int32_t>(i);
+    }
+}
+
+std::string Doxybook2::TextStore::encode(const std::string& text) const {
+    const auto base = dictionary.size();
+    const auto at = [&](const size_t pos) { return pos < base ? dictionary[pos] : text[pos - base]; };
+
+    // Hash chains over the text itself, the dictionary ones are built by train()
+    std::unordered_map<uint32_t, int32_t> head;
+    std::vector<int32_t> prev(text.size(), -1);
+    const auto insert = [&](const size_t pos) {
+        if (pos + MIN_MATCH <= text.size()) {
+            auto& first = head.emplace(hash4(&text[pos]), -1).first->second;
+            prev[pos] = first;
+            first = static_cast<int32_t>(pos);
+        }
+    };
+
+    std::string out;
+    out.reserve(text.size());
+    size_t literals = 0;
+    const auto flush = [&](const size_t end) {
+        while (literals < end) {
+            const auto count = std::min(end - literals, MAX_LITERALS);
+            out += static_cast<char>(count - 1);
+            out.append(text, literals, count);
+            literals += count;
+        }
+    };
+
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t bestLength = 0;
+        size_t bestDistance = 0;
+        if (pos + MIN_MATCH <= text.size()) {
+            const auto maxLength = std::min(MAX_MATCH, text.size() - pos);
+            const auto tryMatch = [&](const size_t candidate) {
+                size_t length = 0;
+                while (length < maxLength && at(candidate + length) == text[pos + length]) {
+                    length++;
+                }
+                if (length > bestLength) {
+                    bestLength = length;
+                    bestDistance = base + pos - candidate;
+                }
+            };
+
+            const auto hash = hash4(&text[pos]);
+            const auto it = head.find(hash);
+            auto candidate = it != head.end() ? it->second : -1;
+            for (size_t depth = 0; candidate >= 0 && depth < MAX_CHAIN; depth++) {
+                tryMatch(base + candidate);
+                candidate = prev[candidate];
+            }
+            candidate = dictionaryHead.empty() ? -1 : dictionaryHead[hash];
+            for (size_t depth = 0; candidate >= 0 && depth < MAX_CHAIN && bestLength < maxLength; depth++) {
+                tryMatch(candidate);
+                candidate = dictionaryPrev[candidate];
+            }
+        }
+
+        // A match is only worth it if it is shorter than the literals it replaces
+        if (bestLength >= MIN_MATCH && bestLength > 1 + varintSize(bestDistance)) {
+            flush(pos);
+            out += static_cast<char>(0x80 | (bestLength - MIN_MATCH));
+            writeVarint(out, bestDistance);
+            for (size_t i = 0; i < bestLength; i++) {
+                insert(pos + i);
+            }
+            pos += bestLength;
+            literals = pos;
+        } else {
+            insert(pos);
+            pos++;
+        }
+    }
+    flush(text.size());
+    return out;
+}
+
+std::string Doxybook2::TextStore::decode(const Entry& entry) const {
+    const auto base = dictionary.size();
+    std::string out;
+    out.reserve(entry.rawLength);
+
+    const auto* ptr = data.data() + entry.offset;
+    const auto* end = ptr + entry.length;
+    while (ptr < end) {
+        const auto token = static_cast<unsigned char>(*ptr++);
+        if ((token & 0x80) == 0) {
+            const size_t count = token + 1;
+            out.append(ptr, count);
+            ptr += count;
+        } else {
+            const size_t length = (token & 0x7f) + MIN_MATCH;
+            const auto start = base + out.size() - readVarint(ptr);
+            // The copy may overlap the bytes it produces, so go byte by byte
+            for (size_t i = start; i < start + length; i++) {
+                out += i < base ? dictionary[i] : out[i - base];
+            }
+        }
+    }
+    return out;
+}
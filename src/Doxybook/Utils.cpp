@@ -185,6 +185,36 @@ std::string Doxybook2::Utils::escape(std::string str) {
     return ret;
 }
 
+std::string Doxybook2::Utils::escapeHtml(const std::string& str) {
+    std::string ret;
+    ret.reserve(str.size());
+    for (const auto& c : str) {
+        switch (c) {
+            case '&': {
+                ret += "&amp;";
+                break;
+            }
+            case '<': {
+                ret += "&lt;";
+                break;
+            }
+            case '>': {
+                ret += "&gt;";
+                break;
+            }
+            case '"': {
+                ret += "&quot;";
+                break;
+            }
+            default: {
+                ret += c;
+                break;
+            }
+        }
+    }
+    return ret;
+}
+
 std::vector<std::string> Doxybook2::Utils::split(const std::string& str, const std::string& delim) {
     std::vector<std::string> tokens;
     size_t last = 0;
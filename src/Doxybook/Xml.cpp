@@ -41,6 +41,14 @@ void Doxybook2::Xml::Element::allChildElements(const std::string& name, const El
     }
 }
 
+void Doxybook2::Xml::Element::allAttributes(const AttributeCallback& callback) const {
+    auto attr = ptr->FirstAttribute();
+    while (attr != nullptr) {
+        callback(attr->Name(), attr->Value());
+        attr = attr->Next();
+    }
+}
+
 Doxybook2::Xml::Element Doxybook2::Xml::Element::nextSiblingElement() const {
     return Element(ptr->NextSiblingElement());
 }
@@ -113,6 +121,15 @@ Doxybook2::Xml::Xml(const std::string& path) : doc(new tinyxml2::XMLDocument) {
     doc->SetUserData(this);
 }
 
+Doxybook2::Xml::Xml(const std::string& path, const std::string& data) : doc(new tinyxml2::XMLDocument) {
+    this->path = path;
+    const auto err = doc->Parse(data.c_str(), data.size());
+    if (err != tinyxml2::XMLError::XML_SUCCESS) {
+        throw EXCEPTION("{}", doc->ErrorStr());
+    }
+    doc->SetUserData(this);
+}
+
 Doxybook2::Xml::~Xml() = default;
 
 Doxybook2::Xml::Element Doxybook2::Xml::firstChildElement(const std::string& name) const {
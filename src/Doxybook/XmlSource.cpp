@@ -0,0 +1,208 @@
+#include "ExceptionUtils.hpp"
+#include <Doxybook/Exception.hpp>
+#include <Doxybook/Path.hpp>
+#include <Doxybook/XmlSource.hpp>
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <spdlog/spdlog.h>
+
+static const size_t CHUNK_SIZE = 1024 * 1024;
+static const std::string START_TAG = "<compounddef";
+static const std::string END_TAG = "</compounddef>";
+
+// Finds the next <compounddef> start tag, returns npos if the buffer ends before it is known
+static size_t findStartTag(const std::string& buffer, size_t pos) {
+    while ((pos = buffer.find(START_TAG, pos)) != std::string::npos) {
+        const auto next = pos + START_TAG.size();
+        if (next >= buffer.size()) {
+            return std::string::npos;
+        }
+        if (std::isspace(static_cast<unsigned char>(buffer[next])) || buffer[next] == '>') {
+            return pos;
+        }
+        pos = next;
+    }
+    return std::string::npos;
+}
+
+// Returns the value of the attribute from a start tag such as <compounddef id="..." kind="...">
+static std::string getTagAttr(const std::string& tag, const std::string& name) {
+    size_t pos = 0;
+    while ((pos = tag.find(name + "=", pos)) != std::string::npos) {
+        const auto start = pos + name.size() + 1;
+        if (pos > 0 && std::isspace(static_cast<unsigned char>(tag[pos - 1])) && start < tag.size() &&
+            (tag[start] == '"' || tag[start] == '\'')) {
+            const auto end = tag.find(tag[start], start + 1);
+            if (end != std::string::npos) {
+                return tag.substr(start + 1, end - start - 1);
+            }
+        }
+        pos = start;
+    }
+    return "";
+}
+
+bool Doxybook2::XmlSource::isCombined(const std::string& input) {
+    return std::filesystem::is_regular_file(input);
+}
+
+std::string Doxybook2::XmlSource::getInputDir(const std::string& input) {
+    if (isCombined(input)) {
+        return std::filesystem::path(input).parent_path().string();
+    }
+    return input;
+}
+
+Doxybook2::XmlSource::XmlSource(const std::string& input) : input(input), combined(isCombined(input)) {
+    if (combined) {
+        file.open(input, std::ios::binary);
+        if (!file) {
+            throw EXCEPTION("Failed to open file {}", input);
+        }
+        scan();
+        if (compounds.empty()) {
+            throw EXCEPTION("No <compounddef> element in file {}", input);
+        }
+        return;
+    }
+
+    const auto indexPath = Path::join(input, "index.xml");
+    Xml xml(indexPath);
+
+    auto root = xml.firstChildElement("doxygenindex");
+    if (!root)
+        throw EXCEPTION("Unable to find root element in file {}", indexPath);
+
+    auto compound = root.firstChildElement("compound");
+    if (!compound)
+        throw EXCEPTION("No <compound> element in file {}", indexPath);
+    while (compound) {
+        try {
+            auto kind = compound.getAttr("kind");
+            auto refid = compound.getAttr("refid");
+            compounds.emplace_back(std::move(kind), std::move(refid));
+        } catch (std::exception& e) {
+            spdlog::warn("compound error {}", e.what());
+        }
+        compound = compound.nextSiblingElement("compound");
+    }
+}
+
+Doxybook2::XmlSource::~XmlSource() = default;
+
+void Doxybook2::XmlSource::scan() {
+    std::string buffer;
+    // Offset of the start of the buffer within the file
+    size_t bufferOffset = 0;
+    size_t begin = std::string::npos;
+    size_t searchFrom = 0;
+    std::vector<char> chunk(CHUNK_SIZE);
+
+    while (true) {
+        if (begin == std::string::npos) {
+            begin = findStartTag(buffer, searchFrom);
+        }
+
+        auto end = std::string::npos;
+        if (begin != std::string::npos) {
+            end = buffer.find(END_TAG, std::max(begin, searchFrom));
+        }
+
+        if (end == std::string::npos) {
+            // Drop everything that has been scanned, keep only the current compound
+            // or the bytes that may be the start of a tag cut in half by the chunk.
+            const auto keep =
+                begin != std::string::npos ? begin : buffer.size() - std::min(buffer.size(), START_TAG.size());
+            buffer.erase(0, keep);
+            bufferOffset += keep;
+            if (begin != std::string::npos) {
+                begin = 0;
+                searchFrom = buffer.size() - std::min(buffer.size(), END_TAG.size());
+            } else {
+                searchFrom = 0;
+            }
+
+            file.read(chunk.data(), chunk.size());
+            if (file.gcount() <= 0) {
+                break;
+            }
+            buffer.append(chunk.data(), static_cast<size_t>(file.gcount()));
+            continue;
+        }
+
+        end += END_TAG.size();
+        const auto tag = buffer.substr(begin, buffer.find('>', begin) - begin);
+        auto kind = getTagAttr(tag, "kind");
+        auto refid = getTagAttr(tag, "id");
+        if (kind.empty() || refid.empty()) {
+            spdlog::warn("compounddef at offset {} in {} has no id or kind", bufferOffset + begin, input);
+        } else {
+            ranges[refid] = Range{bufferOffset + begin, end - begin};
+            compounds.emplace_back(std::move(kind), std::move(refid));
+        }
+
+        searchFrom = end;
+        begin = std::string::npos;
+    }
+
+    if (begin != std::string::npos) {
+        spdlog::warn("Unterminated compounddef at offset {} in {}", bufferOffset + begin, input);
+    }
+
+    file.clear();
+}
+
+void Doxybook2::XmlSource::allCompounds(const CompoundCallback& callback) const {
+    for (const auto& pair : compounds) {
+        callback(pair.first, pair.second);
+    }
+}
+
+std::string Doxybook2::XmlSource::getPath(const std::string& refid) const {
+    if (combined) {
+        return input;
+    }
+    return Path::join(input, refid + ".xml");
+}
+
+std::unique_ptr<Doxybook2::Xml> Doxybook2::XmlSource::load(const std::string& refid) const {
+    if (!combined) {
+        return std::make_unique<Xml>(getPath(refid));
+    }
+
+    const auto it = ranges.find(refid);
+    if (it == ranges.end()) {
+        throw EXCEPTION("Compound {} not found in {}", refid, input);
+    }
+
+    std::string data(it->second.length, '\0');
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        file.seekg(static_cast<std::streamoff>(it->second.offset));
+        file.read(&data[0], static_cast<std::streamsize>(data.size()));
+        if (static_cast<size_t>(file.gcount()) != data.size()) {
+            file.clear();
+            throw EXCEPTION("Failed to read compound {} from {}", refid, input);
+        }
+    }
+
+    return std::make_unique<Xml>(input, data);
+}
+
+Doxybook2::Xml::Element Doxybook2::XmlSource::getCompounddef(const Xml& xml) {
+    // The compounds of the combined file are parsed on their own, without the <doxygen> root
+    if (auto compounddef = xml.firstChildElement("compounddef")) {
+        return compounddef;
+    }
+
+    const auto root = xml.firstChildElement("doxygen");
+    if (!root)
+        throw EXCEPTION("Unable to find <doxygen> element in root element file {}", xml.getPath());
+    auto compounddef = root.firstChildElement("compounddef");
+    if (!compounddef)
+        throw EXCEPTION("Unable to find <compounddef> element in element <doxygen> line {} file {}",
+            root.getLine(),
+            xml.getPath());
+    return compounddef;
+}
@@ -1,11 +1,22 @@
+#include <Doxybook/Checkpoint.hpp>
 #include <Doxybook/DefaultTemplates.hpp>
 #include <Doxybook/Doxygen.hpp>
 #include <Doxybook/Generator.hpp>
+#include <Doxybook/JsonDelta.hpp>
+#include <Doxybook/Output.hpp>
+#include <spdlog/async.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
 #include <Doxybook/Path.hpp>
+#include <Doxybook/Progress.hpp>
+#include <Doxybook/Resources.hpp>
+#include <Doxybook/Scheduler.hpp>
+#include <Doxybook/SymbolIndex.hpp>
+#include <Doxybook/TextHtmlPrinter.hpp>
 #include <Doxybook/TextMarkdownPrinter.hpp>
 #include <Doxybook/TextPlainPrinter.hpp>
 #include <Doxybook/Utils.hpp>
+#include <Doxybook/XmlSource.hpp>
 #include <cxxopts.hpp>
 #include <cassert>
 #include <iostream>
@@ -43,30 +54,154 @@ static const Generator::Filter INDEX_PAGES_FILTER = {Kind::PAGE};
 
 static const Generator::Filter INDEX_EXAMPLES_FILTER = {Kind::EXAMPLE};
 
-int main(int argc, char* argv[]) {
+static nlohmann::json symbolToJson(const SymbolIndex::Symbol& symbol) {
+    nlohmann::json json;
+    json["fullname"] = symbol.fullname;
+    json["name"] = symbol.name;
+    json["title"] = symbol.title;
+    json["kind"] = symbol.kind;
+    json["refid"] = symbol.refid;
+    json["url"] = symbol.url;
+    json["brief"] = symbol.brief;
+    return json;
+}
+
+static void printSymbol(const SymbolIndex::Symbol& symbol, const std::string& indent) {
+    std::cout << indent << symbol.fullname << " (" << symbol.kind << ") " << symbol.url << "\n";
+    if (!symbol.brief.empty()) {
+        std::cout << indent << "    " << symbol.brief << "\n";
+    }
+}
+
+// doxybook2 query <symbols.idx> <name>, looks up the symbols in the index written with config.symbolIndex
+static int query(int argc, char* argv[]) {
+    cxxopts::Options options("doxybook2 query", "Look up symbols in the symbols.idx of a previous run");
+    options.positional_help("<symbols.idx> <name>");
+
+    options.add_options()
+    ("h, help", "Shows this help message.")
+    ("index", "Path to the symbols.idx generated with the symbolIndex config.", cxxopts::value<std::string>())
+    ("name", "The name to look up, such as ns::Foo::bar, bar, or the title of a group.", cxxopts::value<std::string>())
+    ("p, prefix", "Find the symbols whose name starts with the name.")
+    ("f, fuzzy", "Find the symbols whose full name is similar to the name.")
+    ("children", "List the children of each symbol found, such as the members of a group or a class.")
+    ("json", "Print the symbols as JSON.")
+    ("limit", "Maximum number of symbols found by --prefix or --fuzzy, 0 for no limit.", cxxopts::value<int>()->default_value("20"))
+    ;
+    options.parse_positional({"index", "name"});
+
+    auto args = options.parse(argc, argv);
+    if (args["help"].as<bool>() || !args.count("index") || !args.count("name")) {
+        std::cerr << options.help() << std::endl;
+        return args["help"].as<bool>() ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    const SymbolIndex index(args["index"].as<std::string>());
+    const auto name = args["name"].as<std::string>();
+    const auto limit = static_cast<size_t>(std::max(args["limit"].as<int>(), 0));
+    const auto fuzzy = args.count("fuzzy") > 0;
+
+    std::vector<SymbolIndex::Match> matches;
+    if (fuzzy) {
+        matches = index.findFuzzy(name, limit);
+    } else {
+        const auto symbols = args.count("prefix") ? index.findPrefix(name, limit) : index.findExact(name);
+        for (const auto& symbol : symbols) {
+            matches.push_back({symbol, 1.0});
+        }
+    }
+
+    if (args.count("json")) {
+        auto json = nlohmann::json::array();
+        for (const auto& match : matches) {
+            auto item = symbolToJson(match.symbol);
+            if (fuzzy) {
+                item["score"] = match.score;
+            }
+            if (args.count("children")) {
+                item["children"] = nlohmann::json::array();
+                for (const auto& child : index.getChildren(match.symbol.id)) {
+                    item["children"].push_back(symbolToJson(child));
+                }
+            }
+            json.push_back(std::move(item));
+        }
+        std::cout << json.dump(2) << std::endl;
+        return matches.empty() ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    if (matches.empty() && !fuzzy) {
+        // Most likely a typo, show what comes close
+        matches = index.findFuzzy(name, 5);
+        std::cout << "No symbol named " << name << (matches.empty() ? "" : ", similar ones:") << "\n";
+        for (const auto& match : matches) {
+            printSymbol(match.symbol, "");
+        }
+        return EXIT_FAILURE;
+    }
+    for (const auto& match : matches) {
+        printSymbol(match.symbol, "");
+        if (args.count("children")) {
+            for (const auto& child : index.getChildren(match.symbol.id)) {
+                printSymbol(child, "  ");
+            }
+        }
+    }
+    return matches.empty() ? EXIT_FAILURE : EXIT_SUCCESS;
+}
 
+int main(int argc, char* argv[]) {
+    // The log messages are formatted and written by a background thread,
+    // so that the logging does not slow down the loading and the rendering.
+    spdlog::init_thread_pool(8192, 1);
+    spdlog::set_default_logger(spdlog::create_async<spdlog::sinks::stdout_color_sink_mt>("doxybook2"));
     spdlog::set_pattern("%^[%l]%$ %v");
 
-    cxxopts::Options options("Doxybook", "Doxygen XML to Markdown (or JSON)");
+    // Writes out the queued log messages on every return
+    struct LogShutdown {
+        ~LogShutdown() {
+            spdlog::shutdown();
+        }
+    } logShutdown;
+
+    if (argc > 1 && std::string(argv[1]) == "query") {
+        try {
+            return query(argc - 1, argv + 1);
+        } catch (std::exception& e) {
+            spdlog::error(e.what());
+            return EXIT_FAILURE;
+        }
+    }
+
+    cxxopts::Options options("Doxybook", "Doxygen XML to Markdown (or HTML, or JSON)");
 
     options.add_options()
     ("h, help", "Shows this help message.")
     ("v, version", "Shows the version.")
     ("q, quiet", "Run in quiet mode, no stdout, display only errors and warnings to stderr.", cxxopts::value<bool>()->default_value("false"))
-    ("i, input", "Path to the generated Doxygen XML folder. Must contain index.xml!", cxxopts::value<std::string>())
+    ("verbose", "Print a message for every loaded, parsed and rendered file.")
+    ("progress-json", "Write machine readable progress events to stderr, one JSON object per line.")
+    ("i, input", "Path to the generated Doxygen XML folder. Must contain index.xml! "
+                 "Or path to a single combined XML file (all.xml) created by Doxygen's combine.xslt.", cxxopts::value<std::string>())
     ("o, output", "Path to the target folder where to generate markdown files.", cxxopts::value<std::string>())
     ("j, json", "Generate JSON only, no markdown, into the output path. This will also generate index.json.")
+    ("json-delta", "With --json, compare the JSON with the previous run in the output path "
+                   "and write the added, removed, and modified (RFC 6902 patch) files into delta.json.")
     ("c, config", "Optional path to a config json file.", cxxopts::value<std::string>())
     ("config-data", "Optional json data to override config.", cxxopts::value<std::string>())
     ("t, templates", "Optional path to a folder with templates.", cxxopts::value<std::string>())
     ("generate-config", "Generate config file given a path to the destination json file", cxxopts::value<std::string>())
-    ("generate-templates", "Generate template files given a path to a target folder.", cxxopts::value<std::string>())
+    ("generate-templates", "Generate template files given a path to a target folder. "
+                           "Use together with --config to get the HTML templates.", cxxopts::value<std::string>())
     ("d, debug-templates", "Debug templates. This will create JSON for each generated template.")
+    ("resume", "Keep a checkpoint of the run in the output folder. If the run is interrupted, "
+               "run it again with --resume to continue where it stopped.")
     ("summary-input", "Path to the summary input file. This file must contain \"{{doxygen}}\" string.", cxxopts::value<std::string>())
     ("summary-output", "Where to generate summary file. This file will be created. Not a directory!", cxxopts::value<std::string>())
     ("example", "Example usage:\n"
                                    "    doxybook2 --generate-config doxybook.json\n"
                                    "    doxybook2 -i ./doxygen/xml -o ./docs/content -c doxybook.json\n"
+                                   "    doxybook2 query ./docs/content/symbols.idx Engine::Audio::AudioBuffer\n"
                                    "\n")
     ;
 
@@ -77,10 +212,18 @@ int main(int argc, char* argv[]) {
 
         auto args = options.parse(argc, argv);
 
+        if (args.count("verbose")) {
+            spdlog::set_level(spdlog::level::debug);
+        }
+
         if (args["quiet"].as<bool>()) {
             spdlog::set_level(spdlog::level::off);
         }
 
+        if (args.count("progress-json")) {
+            Progress::setJsonStream(&std::cerr);
+        }
+
         if (args["help"].as<bool>()) {
             std::cerr << options.help() << std::endl;
             return EXIT_SUCCESS;
@@ -97,7 +240,10 @@ int main(int argc, char* argv[]) {
         }
 
         else if (args.count("generate-templates")) {
-            saveDefaultTemplates(args["generate-templates"].as<std::string>());
+            if (args.count("config")) {
+                loadConfig(config, args["config"].as<std::string>());
+            }
+            saveDefaultTemplates(args["generate-templates"].as<std::string>(), getDefaultTemplates(config));
             return EXIT_SUCCESS;
         }
 
@@ -108,6 +254,10 @@ int main(int argc, char* argv[]) {
                 return EXIT_FAILURE;
             }
 
+            // Fit the defaults into the limits of the container, the config loaded next overrides them
+            const auto limits = Resources::read();
+            Resources::tune(config, limits);
+
             if (args.count("config")) {
                 loadConfig(config, args["config"].as<std::string>());
             }
@@ -116,6 +266,13 @@ int main(int argc, char* argv[]) {
                 loadConfigData(config, args["config-data"].as<std::string>());
             }
 
+            if (limits.cpus > 0.0 || limits.memory > 0) {
+                spdlog::info("Running with {}: schedulerThreads {}, inheritedCacheSize {}, pipelineQueueSize {}, "
+                             "compressText {}",
+                    Resources::describe(limits), config.schedulerThreads, config.inheritedCacheSize,
+                    config.pipelineQueueSize, config.compressText);
+            }
+
             if (args.count("debug-templates")) {
                 config.debugTemplateJson = true;
             }
@@ -123,21 +280,93 @@ int main(int argc, char* argv[]) {
             if (args.count("json")) {
                 config.useFolders = false;
                 config.imagesFolder = "";
+                // The next run compares with the hashes of this one
+                if (args.count("json-delta")) {
+                    config.contentHashes = true;
+                }
+            } else if (args.count("json-delta")) {
+                spdlog::warn("--json-delta has no effect without --json");
             }
 
             config.outputDir = args["output"].as<std::string>();
 
-            Doxygen doxygen(config);
-            TextMarkdownPrinter markdownPrinter(config, args["input"].as<std::string>(), doxygen);
-            TextPlainPrinter plainPrinter(config, doxygen);
-            JsonConverter jsonConverter(config, doxygen, plainPrinter, markdownPrinter);
+            // The Markdown defaults make no sense for the HTML pages
+            if (config.outputFormat == OutputFormat::HTML) {
+                if (config.fileExt == "md") {
+                    config.fileExt = "html";
+                }
+                if (config.linkSuffix == ".md") {
+                    config.linkSuffix = ".html";
+                }
+            }
+
+            // The images are next to the combined xml file or inside of the xml folder
+            const auto inputDir = XmlSource::getInputDir(args["input"].as<std::string>());
 
             std::optional<std::string> templatesPath;
             if (args.count("templates")) {
                 templatesPath = args["templates"].as<std::string>();
             }
 
-            Generator generator(config, doxygen, jsonConverter, templatesPath);
+            FileOutput fileOutput(config.outputDir);
+            std::unique_ptr<HashingOutput> hashingOutput;
+            if (config.contentHashes) {
+                hashingOutput = std::make_unique<HashingOutput>(fileOutput);
+            }
+            Output& hashedOutput = hashingOutput ? static_cast<Output&>(*hashingOutput) : fileOutput;
+
+            // Compares with the previous run before its files are overwritten
+            std::unique_ptr<JsonDeltaOutput> deltaOutput;
+            if (args.count("json") && args.count("json-delta")) {
+                deltaOutput = std::make_unique<JsonDeltaOutput>(hashedOutput, config.outputDir);
+            }
+            Output& comparedOutput = deltaOutput ? static_cast<Output&>(*deltaOutput) : hashedOutput;
+
+            // Everything written is recorded in the checkpoint, until the run finishes
+            std::unique_ptr<Checkpoint> checkpoint;
+            std::unique_ptr<CheckpointOutput> checkpointOutput;
+            auto resumed = false;
+            if (args.count("resume")) {
+                Utils::createDirectory(config.outputDir);
+                checkpoint = std::make_unique<Checkpoint>(Path::join(config.outputDir, ".doxybook2-checkpoint"));
+                const auto key = Checkpoint::makeKey(args["input"].as<std::string>(),
+                    saveConfigData(config) + templatesPath.value_or("") + (args.count("json") ? "json" : ""));
+                resumed = checkpoint->open(key);
+                checkpointOutput = std::make_unique<CheckpointOutput>(comparedOutput, *checkpoint);
+                // The files written before are not written again, their hashes are in the journal
+                if (resumed && hashingOutput) {
+                    for (const auto& [path, hash] : checkpoint->getDone()) {
+                        hashingOutput->add(path, hash);
+                        if (deltaOutput) {
+                            deltaOutput->add(path, hash);
+                        }
+                    }
+                }
+            }
+            Output& output = checkpointOutput ? static_cast<Output&>(*checkpointOutput) : comparedOutput;
+
+            Doxygen doxygen(config);
+            TextMarkdownPrinter markdownPrinter(config, inputDir, doxygen, &output);
+            TextHtmlPrinter htmlPrinter(config, inputDir, doxygen, &output);
+            TextPlainPrinter plainPrinter(config, doxygen);
+            // The rich text (brief, details, etc.) is printed in the format of the generated pages
+            const TextPrinter& textPrinter =
+                config.outputFormat == OutputFormat::HTML ? static_cast<const TextPrinter&>(htmlPrinter)
+                                                          : markdownPrinter;
+            JsonConverter jsonConverter(config, doxygen, plainPrinter, textPrinter);
+
+            // Shared by the stages of all of the pipelines. Not with the forked processes,
+            // a process should not have other threads when it forks.
+            std::unique_ptr<Scheduler> scheduler;
+            if (config.renderProcesses <= 0) {
+                scheduler = std::make_unique<Scheduler>(
+                    static_cast<size_t>(std::max(config.schedulerThreads, 0)), config.schedulerPinThreads);
+            }
+
+            Generator generator(config, doxygen, jsonConverter, output, templatesPath);
+            generator.setCheckpoint(checkpoint.get());
+            generator.setScheduler(scheduler.get());
+            generator.setHashes(hashingOutput.get());
 
             const auto shouldGenerate = [&](const FolderCategory category) {
                 return std::find(config.foldersToGenerate.begin(), config.foldersToGenerate.end(), category) !=
@@ -163,10 +392,19 @@ int main(int argc, char* argv[]) {
                 }
             }
 
-            spdlog::info("Loading...");
-            doxygen.load(args["input"].as<std::string>());
-            spdlog::info("Finalizing...");
-            doxygen.finalize(plainPrinter, markdownPrinter);
+            if (resumed && checkpoint->hasSnapshot()) {
+                spdlog::info("Resuming, {} files have been written before", checkpoint->getDoneCount());
+                doxygen.loadSnapshot(args["input"].as<std::string>(), checkpoint->getSnapshotPath());
+            } else {
+                spdlog::info("Loading...");
+                doxygen.load(args["input"].as<std::string>());
+                spdlog::info("Finalizing...");
+                doxygen.finalize(plainPrinter, textPrinter);
+                if (checkpoint) {
+                    doxygen.saveSnapshot(checkpoint->getSnapshotPath());
+                    checkpoint->snapshotSaved();
+                }
+            }
             spdlog::info("Rendering...");
 
             if (args.count("json")) {
@@ -248,6 +486,43 @@ int main(int argc, char* argv[]) {
                     generator.printIndex(FolderCategory::EXAMPLES, INDEX_EXAMPLES_FILTER, {});
                 }
             }
+
+            if (config.symbolIndex) {
+                generator.symbolIndex();
+            }
+
+            for (const auto& stage : generator.getStats()) {
+                spdlog::info("Stage '{}' threads: {} pages: {} max queue depth: {} busy: {:.2f}s",
+                    stage.name,
+                    stage.threads,
+                    stage.processed,
+                    stage.maxQueueDepth,
+                    stage.busySeconds);
+            }
+
+            const auto& violations = generator.getRenderViolations();
+            if (!violations.empty()) {
+                spdlog::warn("{} pages went over the render limits and were {}",
+                    violations.size(),
+                    config.renderLimitPlaceholder ? "replaced by a placeholder" : "skipped");
+                for (const auto& violation : violations) {
+                    spdlog::warn("  {} template '{}' {}", violation.refid, violation.templateName, violation.reason);
+                }
+            }
+
+            if (deltaOutput) {
+                spdlog::info("Writing {}", Path::join(config.outputDir, "delta.json"));
+                deltaOutput->writeDelta();
+            }
+            if (hashingOutput) {
+                spdlog::info("Writing {}", Path::join(config.outputDir, "hashes.json"));
+                hashingOutput->writeHashes();
+            }
+
+            // Finished, nothing to resume
+            if (checkpoint) {
+                checkpoint->remove();
+            }
         } else {
             std::cerr << options.help() << std::endl;
             return EXIT_FAILURE;
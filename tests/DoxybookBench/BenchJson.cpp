@@ -0,0 +1,156 @@
+#include <Doxybook/FlatMap.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string>
+
+// Builds, copies, reads and dumps class page shaped template data with the
+// default std::map objects and with FlatMap objects. Counts the allocations
+// of each step by replacing the global operator new.
+using namespace Doxybook2;
+
+static std::atomic<size_t> allocations{0};
+
+void* operator new(const size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+struct Result {
+    double seconds{0.0};
+    size_t allocations{0};
+};
+
+static Result measure(const std::function<void()>& callback) {
+    const auto before = allocations.load();
+    const auto start = std::chrono::steady_clock::now();
+    callback();
+    Result result;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.allocations = allocations.load() - before;
+    return result;
+}
+
+// Same keys and roughly the same insertion order as the JsonConverter
+template <class Json> static Json member(const int page, const int index) {
+    Json json;
+    json["refid"] = "class" + std::to_string(page) + "_1a" + std::to_string(index);
+    json["name"] = "member" + std::to_string(index);
+    json["kind"] = "function";
+    json["visibility"] = "public";
+    json["static"] = index % 3 == 0;
+    json["const"] = index % 2 == 0;
+    json["explicit"] = false;
+    json["inline"] = true;
+    json["virtual"] = index % 4 == 0;
+    json["pureVirtual"] = false;
+    json["brief"] = "Returns the value of the member";
+    json["type"] = "const std::string &";
+    json["argsString"] = "(int value) const";
+    json["definition"] = "const std::string & Foo::member";
+    json["url"] = "Classes/class" + std::to_string(page) + ".md#function-member" + std::to_string(index);
+    json["location"]["file"] = "include/Foo.hpp";
+    json["location"]["line"] = 10 + index;
+    json["location"]["column"] = 5;
+    auto& param = json["params"][0];
+    param["name"] = "value";
+    param["type"] = "int";
+    param["defval"] = "0";
+    return json;
+}
+
+template <class Json> static Json page(const int index, const int members) {
+    Json json;
+    json["refid"] = "class" + std::to_string(index);
+    json["name"] = "Foo" + std::to_string(index);
+    json["title"] = "Foo" + std::to_string(index);
+    json["fullname"] = "Ns::Foo" + std::to_string(index);
+    json["kind"] = "class";
+    json["language"] = "cpp";
+    json["brief"] = "A class";
+    json["details"] = "A longer description of the class";
+    json["url"] = "Classes/class" + std::to_string(index) + ".md";
+    json["hasAdditionalMembers"] = false;
+    json["parent"]["name"] = "Ns";
+    json["parent"]["refid"] = "namespaceNs";
+    json["baseClasses"] = Json::array();
+    for (auto i = 0; i < members; i++) {
+        json["publicFunctions"].push_back(member<Json>(index, i));
+    }
+    return json;
+}
+
+// What a template does: walks the members and reads a few fields of each
+template <class Json> static size_t read(const Json& json) {
+    size_t total = json.at("name").template get_ref<const std::string&>().size();
+    for (const auto& m : json.at("publicFunctions")) {
+        total += m.at("name").template get_ref<const std::string&>().size();
+        total += m.at("brief").template get_ref<const std::string&>().size();
+        total += m.at("static").template get<bool>() ? 1 : 0;
+        total += m.at("location").at("line").template get<int>();
+        total += m.contains("reimplements") ? 1 : 0;
+    }
+    return total;
+}
+
+template <class Json> static void run(const char* name, const int pages, const int members) {
+    std::vector<Json> data;
+    data.reserve(pages);
+    size_t sink = 0;
+
+    const auto build = measure([&]() {
+        for (auto i = 0; i < pages; i++) {
+            data.push_back(page<Json>(i, members));
+        }
+    });
+    const auto copy = measure([&]() {
+        for (const auto& json : data) {
+            // The renderer callbacks copy their arguments like this
+            const Json copied = json;
+            sink += copied.size();
+        }
+    });
+    const auto lookup = measure([&]() {
+        for (const auto& json : data) {
+            sink += read(json);
+        }
+    });
+    const auto dump = measure([&]() {
+        for (const auto& json : data) {
+            sink += json.dump().size();
+        }
+    });
+    const auto destroy = measure([&]() { data.clear(); });
+
+    for (const auto& [step, result] : std::vector<std::pair<const char*, Result>>{
+             {"build", build}, {"copy", copy}, {"lookup", lookup}, {"dump", dump}, {"destroy", destroy}}) {
+        std::printf("%-16s %-8s %10.3f %14zu\n", name, step, result.seconds, result.allocations);
+    }
+    if (sink == 0) {
+        std::printf("unexpected result\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    const auto pages = argc > 1 ? std::atoi(argv[1]) : 20000;
+    const auto members = 20;
+    std::printf("%d pages, %d members each\n\n", pages, members);
+    std::printf("%-16s %-8s %10s %14s\n", "type", "step", "time (s)", "allocations");
+    run<nlohmann::json>("nlohmann::json", pages, members);
+    run<FlatJson>("FlatJson", pages, members);
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <Doxybook/Pipeline.hpp>
+#include <Doxybook/Scheduler.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+// How the scheduler and the pipeline running on it scale from 1 to 64 threads.
+// Each item does a fixed amount of CPU bound work, so the speedup is limited
+// only by the cores and the overhead of the scheduler.
+using namespace Doxybook2;
+
+static uint64_t work(uint64_t value, const int rounds) {
+    for (auto i = 0; i < rounds; i++) {
+        value ^= value << 13;
+        value ^= value >> 7;
+        value ^= value << 17;
+    }
+    return value;
+}
+
+static double measure(const std::function<void()>& callback) {
+    const auto start = std::chrono::steady_clock::now();
+    callback();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    const auto items = argc > 1 ? std::atoi(argv[1]) : 20000;
+    const auto rounds = argc > 2 ? std::atoi(argv[2]) : 20000;
+    std::printf("%d items, %d rounds each, %u cores\n\n", items, rounds, std::thread::hardware_concurrency());
+    std::printf("%8s %12s %8s %12s %8s\n", "threads", "tasks (s)", "speedup", "pipeline (s)", "speedup");
+
+    double tasksBase = 0.0;
+    double pipelineBase = 0.0;
+    for (size_t threads = 1; threads <= 64; threads *= 2) {
+        Scheduler scheduler(threads);
+        std::atomic<uint64_t> sink{0};
+
+        // Independent tasks, submitted from the outside
+        const auto tasks = measure([&]() {
+            auto group = scheduler.createGroup("tasks");
+            for (auto i = 0; i < items; i++) {
+                scheduler.submit(group, [&, i]() { sink += work(i + 1, rounds); });
+            }
+            scheduler.wait(group);
+        });
+
+        // The same work split into three stages, the first two without a limit
+        const auto pipeline = measure([&]() {
+            Pipeline<uint64_t> pipeline(64, &scheduler);
+            pipeline.addStage("first", threads, [&](uint64_t& value) { value = work(value, rounds / 2); });
+            pipeline.addStage("second", threads, [&](uint64_t& value) { value = work(value, rounds / 2); });
+            pipeline.addStage("sink", 1, [&](uint64_t& value) { sink += value; }, Scheduler::Priority::HIGH);
+            for (auto i = 0; i < items; i++) {
+                pipeline.push(i + 1);
+            }
+            pipeline.finish();
+        });
+
+        if (threads == 1) {
+            tasksBase = tasks;
+            pipelineBase = pipeline;
+        }
+        std::printf("%8zu %12.3f %8.2f %12.3f %8.2f\n",
+            threads,
+            tasks,
+            tasksBase / tasks,
+            pipeline,
+            pipelineBase / pipeline);
+        if (sink == 0) {
+            std::printf("unexpected result\n");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <Doxybook/Config.hpp>
+#include <Doxybook/Doxygen.hpp>
+#include <Doxybook/TextHtmlPrinter.hpp>
+#include <Doxybook/TextMarkdownPrinter.hpp>
+#include <Doxybook/TextPlainPrinter.hpp>
+#include <Doxybook/Xml.hpp>
+#include <Doxybook/XmlTextParser.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <spdlog/spdlog.h>
+
+using namespace Doxybook2;
+
+// The input is the inside of a <detaileddescription> element,
+// it is parsed and printed by all of the text printers.
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    static const auto init = []() {
+        spdlog::set_level(spdlog::level::off);
+        return true;
+    }();
+    (void)init;
+
+    static const auto config = []() {
+        Config config;
+        config.copyImages = false;
+        return config;
+    }();
+    static const auto htmlLinksConfig = []() {
+        Config config;
+        config.copyImages = false;
+        config.linkAndInlineCodeAsHTML = true;
+        return config;
+    }();
+    static const Doxygen doxygen(config);
+    static const TextPlainPrinter plainPrinter(config, doxygen);
+    static const TextMarkdownPrinter markdownPrinter(config, "", doxygen);
+    static const TextMarkdownPrinter htmlLinksPrinter(htmlLinksConfig, "", doxygen);
+    static const TextHtmlPrinter htmlPrinter(config, "", doxygen);
+
+    std::string str = "<?xml version='1.0' encoding='UTF-8' standalone='no'?>\n<detaileddescription>";
+    str.append(reinterpret_cast<const char*>(data), size);
+    str += "</detaileddescription>";
+
+    try {
+        Xml xml("fuzz.xml", str);
+        const auto element = xml.firstChildElement("detaileddescription");
+        if (!element) {
+            return 0;
+        }
+        const auto node = XmlTextParser::parseParas(element);
+        plainPrinter.print(node, "cpp");
+        markdownPrinter.print(node, "cpp");
+        htmlLinksPrinter.print(node, "cpp");
+        htmlPrinter.print(node, "cpp");
+    } catch (std::exception& e) {
+        // Invalid xml is reported as an exception, that is fine
+        (void)e;
+    }
+    return 0;
+}
@@ -0,0 +1,32 @@
+#include <Doxybook/Utils.hpp>
+#include <cstddef>
+#include <cstdint>
+
+using namespace Doxybook2;
+
+// The input is used as the string for all of the string functions.
+// For split() the first byte is the length of the delimiter that follows it.
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    const std::string str(reinterpret_cast<const char*>(data), size);
+
+    Utils::escape(str);
+    Utils::escapeHtml(str);
+    Utils::title(str);
+    Utils::toLower(str);
+    Utils::safeAnchorId(str);
+    Utils::stripNamespace(str);
+    Utils::stripAnchor(str);
+    Utils::extractQualifiedNameFromFunctionDefinition(str);
+    Utils::normalizeLanguage(str);
+    Utils::replaceNewline(str);
+    Utils::filename(str);
+
+    if (size > 0) {
+        const auto length = std::min<size_t>(data[0] % 4 + 1, size - 1);
+        const auto delim = str.substr(1, length);
+        if (!delim.empty()) {
+            Utils::split(str.substr(1 + length), delim);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include <Doxybook/Node.hpp>
+#include <Doxybook/Xml.hpp>
+#include <Doxybook/XmlSource.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <spdlog/spdlog.h>
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+using namespace Doxybook2;
+
+// The input is a compound file, or a combined file with multiple compounds (all.xml).
+// It goes through the combined file scanner, the xml parser and the member parsing.
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    static const auto path = []() {
+        spdlog::set_level(spdlog::level::off);
+        // Unique per process, so that the fuzzers can run with -jobs
+        const auto name = "doxybook2_fuzz_" + std::to_string(getpid()) + ".xml";
+        return (std::filesystem::temp_directory_path() / name).string();
+    }();
+
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+    }
+
+    try {
+        XmlSource source(path);
+        source.allCompounds([&](const std::string& kind, const std::string& refid) {
+            (void)kind;
+            try {
+                const auto xml = source.load(refid);
+                auto compounddef = XmlSource::getCompounddef(*xml);
+                auto sectiondef = compounddef.firstChildElement("sectiondef");
+                while (sectiondef) {
+                    auto memberdef = sectiondef.firstChildElement("memberdef");
+                    while (memberdef) {
+                        Node::parse(memberdef, memberdef.getAttr("id"));
+                        memberdef = memberdef.nextSiblingElement("memberdef");
+                    }
+                    sectiondef = sectiondef.nextSiblingElement("sectiondef");
+                }
+            } catch (std::exception& e) {
+                (void)e;
+            }
+        });
+    } catch (std::exception& e) {
+        // Invalid xml or no compounds are reported as an exception, that is fine
+        (void)e;
+    }
+    return 0;
+}
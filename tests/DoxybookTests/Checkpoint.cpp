@@ -0,0 +1,85 @@
+#include <Doxybook/Checkpoint.hpp>
+#include <Doxybook/Doxygen.hpp>
+#include <Doxybook/TextMarkdownPrinter.hpp>
+#include <Doxybook/TextPlainPrinter.hpp>
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+
+using namespace Doxybook2;
+
+TEST_CASE("Checkpoint journal") {
+    const auto dir = (std::filesystem::temp_directory_path() / "doxybook2_checkpoint").string();
+    std::filesystem::remove_all(dir);
+
+    {
+        Checkpoint checkpoint(dir);
+        CHECK(!checkpoint.open("key"));
+        CHECK(!checkpoint.hasSnapshot());
+        checkpoint.record("Classes/classFoo.md", "foo");
+        checkpoint.record("Classes/classBar.md", "bar");
+    }
+
+    // The process has been killed in the middle of writing a line
+    std::ofstream((std::filesystem::path(dir) / "journal").string(), std::ios::app) << "0123";
+
+    SECTION("Same key resumes") {
+        Checkpoint checkpoint(dir);
+        CHECK(checkpoint.open("key"));
+        CHECK(checkpoint.getDoneCount() == 2);
+        CHECK(checkpoint.isDone("Classes/classFoo.md"));
+        CHECK(checkpoint.isDone("Classes/classBar.md"));
+        CHECK(!checkpoint.isDone("Classes/classBaz.md"));
+    }
+
+    SECTION("Different key starts over") {
+        Checkpoint checkpoint(dir);
+        CHECK(!checkpoint.open("other key"));
+        CHECK(checkpoint.getDoneCount() == 0);
+        CHECK(!checkpoint.isDone("Classes/classFoo.md"));
+    }
+
+    SECTION("Removed once finished") {
+        Checkpoint checkpoint(dir);
+        CHECK(checkpoint.open("key"));
+        checkpoint.remove();
+        CHECK(!std::filesystem::exists(dir));
+    }
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("Snapshot restores the same model") {
+    Config config;
+    config.copyImages = false;
+    Doxygen doxygen(config);
+    TextPlainPrinter plainPrinter(config, doxygen);
+    TextMarkdownPrinter markdownPrinter(config, IMPORT_DIR, doxygen);
+    doxygen.load(IMPORT_DIR);
+    doxygen.finalize(plainPrinter, markdownPrinter);
+
+    const auto path = (std::filesystem::temp_directory_path() / "doxybook2_snapshot.cbor").string();
+    doxygen.saveSnapshot(path);
+
+    Doxygen restored(config);
+    restored.loadSnapshot(IMPORT_DIR, path);
+    std::filesystem::remove(path);
+
+    CHECK(restored.getIndex().getHash() == doxygen.getIndex().getHash());
+    REQUIRE(restored.getCache().size() == doxygen.getCache().size());
+    for (const auto& pair : doxygen.getCache()) {
+        const auto& a = *pair.second;
+        const auto& b = *restored.find(pair.first);
+        CHECK(a.getRefid() == b.getRefid());
+        CHECK(a.getKind() == b.getKind());
+        CHECK(a.getName() == b.getName());
+        CHECK(a.getTitle() == b.getTitle());
+        CHECK(a.getBrief() == b.getBrief());
+        CHECK(a.getUrl() == b.getUrl());
+        CHECK(a.getLanguage() == b.getLanguage());
+        CHECK(a.getHash() == b.getHash());
+        CHECK(a.getChildren().size() == b.getChildren().size());
+        CHECK(a.getBaseClasses().size() == b.getBaseClasses().size());
+        CHECK((a.getParent() ? a.getParent()->getRefid() : "") == (b.getParent() ? b.getParent()->getRefid() : ""));
+    }
+}
@@ -0,0 +1,98 @@
+#include <Doxybook/Config.hpp>
+#include <Doxybook/Doxygen.hpp>
+#include <Doxybook/Output.hpp>
+#include <Doxybook/TextHtmlPrinter.hpp>
+#include <Doxybook/TextMarkdownPrinter.hpp>
+#include <Doxybook/Xml.hpp>
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+using namespace Doxybook2;
+
+TEST_CASE("Hash the files written into the output", "[ContentHashes]") {
+    MemoryOutput memory;
+    HashingOutput output(memory);
+    output.write("Classes/classFoo.md", "# Foo");
+    output.write("index_classes.md", "first");
+    const auto mark = output.getCount();
+    output.write("index_classes.md", "second");
+    output.add("images/logo.png", 42);
+
+    // Only what came after the mark, in the order it was written
+    const auto since = output.getSince(mark);
+    REQUIRE(since.size() == 2);
+    CHECK(since[0].first == "index_classes.md");
+    CHECK(since[0].second == Hash::of("second"));
+    CHECK(since[1].first == "images/logo.png");
+
+    output.writeHashes();
+    CHECK(memory.get("index_classes.md") == "second");
+    const auto json = nlohmann::json::parse(memory.get("hashes.json"));
+    CHECK(json.at("algorithm") == "fnv1a64");
+    const auto& files = json.at("files");
+    REQUIRE(files.size() == 3);
+    CHECK(files.at("Classes/classFoo.md") == Hash::toHex(Hash::of("# Foo")));
+    CHECK(files.at("index_classes.md") == Hash::toHex(Hash::of("second")));
+    CHECK(files.at("images/logo.png") == Hash::toHex(42));
+    CHECK_FALSE(files.contains("hashes.json"));
+}
+
+TEST_CASE("Put the hash into a file name", "[ContentHashes]") {
+    CHECK(Hash::fileName("logo.png", 0x1f) == "logo.000000000000001f.png");
+    CHECK(Hash::fileName("img/logo.v2.svg", 1) == "img/logo.v2.0000000000000001.svg");
+    CHECK(Hash::fileName("LICENSE", 1) == "LICENSE.0000000000000001");
+    CHECK(Hash::fileName(".hidden", 1) == ".hidden.0000000000000001");
+    CHECK(Hash::fileName("v1.0/logo", 1) == "v1.0/logo.0000000000000001");
+}
+
+TEST_CASE("Copy the images under the hash of their contents", "[ContentHashes]") {
+    const auto dir = std::filesystem::temp_directory_path() / "doxybook_content_hashes";
+    std::filesystem::create_directories(dir);
+    {
+        std::ofstream file(dir / "logo.png", std::ios::binary);
+        file << "not really a png";
+    }
+    const auto xmlPath = (dir / "text.xml").string();
+    {
+        std::ofstream file(xmlPath);
+        file << "<?xml version='1.0' encoding='UTF-8' standalone='no'?>\n";
+        file << "<detaileddescription><para><image type=\"html\" name=\"logo.png\"></image>"
+                "<image type=\"html\" name=\"logo.png\"></image></para></detaileddescription>\n";
+    }
+    const auto hashed = Hash::fileName("logo.png", Hash::of("not really a png"));
+
+    Config config;
+    config.hashImageNames = true;
+    Doxygen doxygen(config);
+    Xml xml(xmlPath);
+    const auto paras = XmlTextParser::parseParas(xml.firstChildElement("detaileddescription"));
+
+    SECTION("Markdown") {
+        MemoryOutput output;
+        TextMarkdownPrinter printer(config, dir.string(), doxygen, &output);
+        const auto str = printer.print(paras, "cpp");
+        CHECK(str == "![logo.png](images/" + hashed + ")![logo.png](images/" + hashed + ")");
+        CHECK(output.getFiles().size() == 1);
+        CHECK(output.get("images/" + hashed) == "not really a png");
+    }
+
+    SECTION("HTML") {
+        MemoryOutput output;
+        TextHtmlPrinter printer(config, dir.string(), doxygen, &output);
+        const auto str = printer.print(paras, "cpp");
+        CHECK(str.find("<img src=\"images/" + hashed + "\" alt=\"logo.png\"/>") != std::string::npos);
+        CHECK(output.get("images/" + hashed) == "not really a png");
+    }
+
+    SECTION("Without the hash") {
+        config.hashImageNames = false;
+        MemoryOutput output;
+        TextMarkdownPrinter printer(config, dir.string(), doxygen, &output);
+        CHECK(printer.print(paras, "cpp") == "![logo.png](images/logo.png)![logo.png](images/logo.png)");
+        CHECK(output.contains("images/logo.png"));
+    }
+
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,65 @@
+#include <Doxybook/FlatMap.hpp>
+#include <catch2/catch.hpp>
+
+using namespace Doxybook2;
+
+static const std::string PAGE = R"({
+  "refid": "classFoo", "name": "Foo", "kind": "class", "brief": "A class",
+  "publicFunctions": [
+    {"name": "zeta", "refid": "a1", "static": false, "params": [{"name": "x", "type": "int"}]},
+    {"name": "alpha", "refid": "a2", "static": true, "params": []}
+  ],
+  "location": {"file": "Foo.hpp", "line": 12, "column": 5},
+  "baseClasses": [], "abstract": null, "url": "classFoo.md"
+})";
+
+TEST_CASE("FlatJson dumps exactly like nlohmann::json", "[FlatMap]") {
+    const auto flat = FlatJson::parse(PAGE);
+    const auto tree = nlohmann::json::parse(PAGE);
+    REQUIRE(flat.dump() == tree.dump());
+    REQUIRE(flat.dump(2) == tree.dump(2));
+    REQUIRE(FlatJson::parse(flat.dump()) == flat);
+}
+
+TEST_CASE("FlatJson keeps keys sorted and unique", "[FlatMap]") {
+    FlatJson data;
+    data["url"] = "a.md";
+    data["brief"] = "text";
+    data["name"] = "Foo";
+    data["kind"] = "class";
+    data["name"] = "Bar";
+    data.emplace("abstract", false);
+    REQUIRE_FALSE(data.emplace("kind", "struct").second);
+
+    std::vector<std::string> keys;
+    for (const auto& item : data.items()) {
+        keys.push_back(item.key());
+    }
+    REQUIRE(keys == std::vector<std::string>{"abstract", "brief", "kind", "name", "url"});
+    REQUIRE(data["name"] == "Bar");
+    REQUIRE(data.at("kind") == "class");
+    REQUIRE(data.count("url") == 1);
+    REQUIRE(data.count("missing") == 0);
+    REQUIRE(data.find("missing") == data.end());
+    REQUIRE_THROWS(data.at("missing"));
+
+    REQUIRE(data.erase("brief") == 1);
+    REQUIRE(data.erase("brief") == 0);
+    data.erase(data.find("abstract"));
+    REQUIRE(data.dump() == R"({"kind":"class","name":"Bar","url":"a.md"})");
+}
+
+TEST_CASE("FlatJson merges and compares as objects", "[FlatMap]") {
+    FlatJson a = {{"b", 2}, {"a", 1}};
+    FlatJson b = {{"a", 1}, {"b", 2}};
+    REQUIRE(a == b);
+
+    a.update(FlatJson{{"c", 3}, {"a", 0}});
+    REQUIRE(a.dump() == R"({"a":0,"b":2,"c":3})");
+    REQUIRE(a != b);
+
+    const std::map<std::string, int> map = {{"y", 2}, {"x", 1}};
+    const FlatJson converted = map;
+    REQUIRE(converted.dump() == R"({"x":1,"y":2})");
+    REQUIRE(converted.get<std::map<std::string, int>>() == map);
+}
@@ -0,0 +1,75 @@
+#include <Doxybook/Exception.hpp>
+#include <Doxybook/ForkPool.hpp>
+#include <catch2/catch.hpp>
+#include <cstdlib>
+#include <map>
+
+using namespace Doxybook2;
+
+TEST_CASE("Fork pool runs every job once") {
+    if (!ForkPool::isSupported()) {
+        return;
+    }
+
+    // Forked after this was filled, the workers see it without it being sent
+    std::vector<std::string> inputs;
+    for (size_t i = 0; i < 100; i++) {
+        inputs.push_back("job " + std::to_string(i));
+    }
+
+    std::map<size_t, std::string> results;
+    ForkPool pool(4, 7);
+    const auto lost = pool.run(
+        inputs.size(),
+        [&](const size_t job) { return inputs[job] + " done"; },
+        [&](const size_t job, std::string result) { CHECK(results.emplace(job, std::move(result)).second); });
+
+    CHECK(lost.empty());
+    REQUIRE(results.size() == inputs.size());
+    for (size_t i = 0; i < inputs.size(); i++) {
+        CHECK(results[i] == inputs[i] + " done");
+    }
+}
+
+TEST_CASE("Fork pool survives a crashing job") {
+    if (!ForkPool::isSupported()) {
+        return;
+    }
+
+    std::map<size_t, std::string> results;
+    ForkPool pool(2, 4);
+    const auto lost = pool.run(
+        20,
+        [&](const size_t job) {
+            if (job == 9) {
+                std::abort();
+            }
+            return std::to_string(job);
+        },
+        [&](const size_t job, std::string result) { results.emplace(job, std::move(result)); });
+
+    // Only the crashing job is lost, the rest of its batch is done by the replacement
+    CHECK(lost == std::vector<size_t>{9});
+    CHECK(results.size() == 19);
+    CHECK(results.count(9) == 0);
+    CHECK(results[8] == "8");
+    CHECK(results[10] == "10");
+}
+
+TEST_CASE("Fork pool rethrows the error of a job") {
+    if (!ForkPool::isSupported()) {
+        return;
+    }
+
+    ForkPool pool(2, 1);
+    CHECK_THROWS_WITH(pool.run(
+                          5,
+                          [&](const size_t job) -> std::string {
+                              if (job == 3) {
+                                  throw Exception("job 3 failed");
+                              }
+                              return "";
+                          },
+                          [&](size_t, std::string) {}),
+        "job 3 failed");
+}
@@ -0,0 +1,67 @@
+#include <Doxybook/Config.hpp>
+#include <Doxybook/Doxygen.hpp>
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+
+using namespace Doxybook2;
+
+static const std::string INDEX_XML = R"(<?xml version='1.0' encoding='UTF-8' standalone='no'?>
+<doxygenindex version="1.8.17">
+  <compound refid="classFoo" kind="class"><name>Foo</name></compound>
+</doxygenindex>
+)";
+
+static std::string classXml(const std::string& brief, const int line, const std::string& indent) {
+    return R"(<?xml version='1.0' encoding='UTF-8' standalone='no'?>
+<doxygen version="1.8.17">
+  <compounddef id="classFoo" kind="class" language="C++" prot="public">
+    <compoundname>Foo</compoundname>
+    <sectiondef kind="public-func">
+      <memberdef kind="function" id="classFoo_1a0" prot="public" static="no" const="no" explicit="no" inline="no" virt="non-virtual">
+        <type>void</type>
+        <definition>void Foo::bar</definition>
+        <argsstring>()</argsstring>
+        <name>bar</name>
+        <briefdescription>)" +
+           indent + "<para>" + brief + R"(</para></briefdescription>
+        <location file="Foo.hpp" line=")" +
+           std::to_string(line) + R"(" column="5"/>
+      </memberdef>
+    </sectiondef>
+    <briefdescription><para>The Foo class</para></briefdescription>
+    <location file="Foo.hpp" line=")" +
+           std::to_string(line - 2) + R"(" column="1"/>
+  </compounddef>
+</doxygen>
+)";
+}
+
+static std::pair<Hash::Value, Hash::Value> loadHashes(const std::string& name, const std::string& classXml) {
+    const auto dir = std::filesystem::temp_directory_path() / ("doxybook2_hash_" + name);
+    std::filesystem::create_directories(dir);
+    std::ofstream((dir / "index.xml").string()) << INDEX_XML;
+    std::ofstream((dir / "classFoo.xml").string()) << classXml;
+
+    Config config;
+    Doxygen doxygen(config);
+    doxygen.load(dir.string());
+    std::filesystem::remove_all(dir);
+
+    const auto klass = doxygen.find("classFoo");
+    const auto member = doxygen.find("classFoo_1a0");
+    return {klass->getHash(), member->getHash()};
+}
+
+TEST_CASE("Content hashes ignore formatting and line numbers") {
+    const auto original = loadHashes("a", classXml("Does the bar", 10, ""));
+    const auto moved = loadHashes("b", classXml("Does the bar", 42, "\n          "));
+    const auto changed = loadHashes("c", classXml("Does the bar twice", 10, ""));
+
+    CHECK(original.first == moved.first);
+    CHECK(original.second == moved.second);
+
+    // The member changed and so did its parent
+    CHECK(original.second != changed.second);
+    CHECK(original.first != changed.first);
+}
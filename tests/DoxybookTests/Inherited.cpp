@@ -0,0 +1,163 @@
+#include <Doxybook/Config.hpp>
+#include <Doxybook/Doxygen.hpp>
+#include <Doxybook/JsonConverter.hpp>
+#include <Doxybook/TextMarkdownPrinter.hpp>
+#include <Doxybook/TextPlainPrinter.hpp>
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+
+using namespace Doxybook2;
+
+static const std::string INDEX_XML = R"(<?xml version='1.0' encoding='UTF-8' standalone='no'?>
+<doxygenindex version="1.8.17">
+  <compound refid="classA" kind="class"><name>A</name></compound>
+  <compound refid="classB" kind="class"><name>B</name></compound>
+  <compound refid="classC" kind="class"><name>C</name></compound>
+</doxygenindex>
+)";
+
+static const std::string A_XML = R"(<?xml version='1.0' encoding='UTF-8' standalone='no'?>
+<doxygen version="1.8.17">
+  <compounddef id="classA" kind="class" language="C++" prot="public">
+    <compoundname>A</compoundname>
+    <derivedcompoundref refid="classB" prot="public" virt="non-virtual">B</derivedcompoundref>
+    <sectiondef kind="public-func">
+      <memberdef kind="function" id="classA_1a0" prot="public" static="no" virt="virtual">
+        <name>run</name>
+        <reimplementedby refid="classB_1a0">run</reimplementedby>
+        <briefdescription></briefdescription>
+        <detaileddescription></detaileddescription>
+      </memberdef>
+      <memberdef kind="function" id="classA_1a1" prot="public" static="no" virt="non-virtual">
+        <name>helper</name>
+        <briefdescription></briefdescription>
+        <detaileddescription></detaileddescription>
+      </memberdef>
+    </sectiondef>
+    <sectiondef kind="protected-attrib">
+      <memberdef kind="variable" id="classA_1a2" prot="protected" static="no" mutable="no">
+        <name>value</name>
+        <briefdescription><para>The value</para></briefdescription>
+        <detaileddescription></detaileddescription>
+      </memberdef>
+    </sectiondef>
+    <briefdescription></briefdescription>
+    <detaileddescription></detaileddescription>
+  </compounddef>
+</doxygen>
+)";
+
+static const std::string B_XML = R"(<?xml version='1.0' encoding='UTF-8' standalone='no'?>
+<doxygen version="1.8.17">
+  <compounddef id="classB" kind="class" language="C++" prot="public">
+    <compoundname>B</compoundname>
+    <basecompoundref refid="classA" prot="public" virt="non-virtual">A</basecompoundref>
+    <derivedcompoundref refid="classC" prot="public" virt="non-virtual">C</derivedcompoundref>
+    <sectiondef kind="public-func">
+      <memberdef kind="function" id="classB_1a0" prot="public" static="no" virt="virtual">
+        <name>execute</name>
+        <reimplements refid="classA_1a0">run</reimplements>
+        <briefdescription></briefdescription>
+        <detaileddescription></detaileddescription>
+      </memberdef>
+      <memberdef kind="function" id="classB_1a1" prot="public" static="no" virt="non-virtual">
+        <name>tick</name>
+        <briefdescription></briefdescription>
+        <detaileddescription></detaileddescription>
+      </memberdef>
+    </sectiondef>
+    <briefdescription></briefdescription>
+    <detaileddescription></detaileddescription>
+  </compounddef>
+</doxygen>
+)";
+
+static const std::string C_XML = R"(<?xml version='1.0' encoding='UTF-8' standalone='no'?>
+<doxygen version="1.8.17">
+  <compounddef id="classC" kind="class" language="C++" prot="public">
+    <compoundname>C</compoundname>
+    <basecompoundref refid="classB" prot="public" virt="non-virtual">B</basecompoundref>
+    <sectiondef kind="public-func">
+      <memberdef kind="function" id="classC_1a0" prot="public" static="no" virt="non-virtual">
+        <name>helper</name>
+        <briefdescription></briefdescription>
+        <detaileddescription></detaileddescription>
+      </memberdef>
+    </sectiondef>
+    <briefdescription></briefdescription>
+    <detaileddescription></detaileddescription>
+  </compounddef>
+</doxygen>
+)";
+
+static std::vector<std::string> inheritedNames(const Node& node, const std::string& base) {
+    std::vector<std::string> names;
+    for (const auto& inherited : node.getInheritedMembers()) {
+        if (inherited.base->getRefid() == base) {
+            for (const auto* member : inherited.members) {
+                names.push_back(member->getName());
+            }
+        }
+    }
+    return names;
+}
+
+TEST_CASE("Inherited members are resolved once per class") {
+    const auto dir = std::filesystem::temp_directory_path() / "doxybook2_inherited";
+    std::filesystem::create_directories(dir);
+    std::ofstream((dir / "index.xml").string()) << INDEX_XML;
+    std::ofstream((dir / "classA.xml").string()) << A_XML;
+    std::ofstream((dir / "classB.xml").string()) << B_XML;
+    std::ofstream((dir / "classC.xml").string()) << C_XML;
+
+    Config config;
+    config.copyImages = false;
+    Doxygen doxygen(config);
+    TextPlainPrinter plainPrinter(config, doxygen);
+    TextMarkdownPrinter markdownPrinter(config, dir.string(), doxygen);
+    doxygen.load(dir.string());
+    doxygen.finalize(plainPrinter, markdownPrinter);
+
+    // B::execute() overrides A::run() under another name, only the reimplements hide it.
+    // The overridden run() and the helper() hidden by C::helper() are left out.
+    const auto& c = *doxygen.find("classC");
+    CHECK(inheritedNames(c, "classB") == std::vector<std::string>{"execute", "tick"});
+    CHECK(inheritedNames(c, "classA") == std::vector<std::string>{"value"});
+    CHECK(inheritedNames(*doxygen.find("classB"), "classA") == std::vector<std::string>{"helper", "value"});
+    CHECK(doxygen.find("classA")->getInheritedMembers().empty());
+
+    SECTION("Converted to json") {
+        JsonConverter jsonConverter(config, doxygen, plainPrinter, markdownPrinter);
+        const auto json = jsonConverter.getAsJson(c);
+        CHECK(json.at("hasAdditionalMembers").get<bool>());
+        REQUIRE(json.at("inheritedPublicFunctions").size() == 2);
+        CHECK(json.at("inheritedPublicFunctions")[0].at("name") == "execute");
+        CHECK(json.at("inheritedPublicFunctions")[0].at("inheritedFrom").at("refid") == "classB");
+        REQUIRE(json.at("inheritedProtectedAttributes").size() == 1);
+        CHECK(json.at("inheritedProtectedAttributes")[0].at("inheritedFrom").at("name") == "A");
+
+        for (const auto& base : json.at("baseClasses")) {
+            if (base.at("refid") == "classA") {
+                CHECK(!base.contains("publicFunctions"));
+                REQUIRE(base.at("protectedAttributes").size() == 1);
+                CHECK(base.at("protectedAttributes")[0].at("brief") == "The value");
+            } else {
+                CHECK(base.at("publicFunctions").size() == 2);
+            }
+        }
+
+        // The second page uses the members converted for the first one
+        CHECK(jsonConverter.getAsJson(c) == json);
+    }
+
+    SECTION("Restored from a snapshot") {
+        const auto path = (dir / "snapshot.cbor").string();
+        doxygen.saveSnapshot(path);
+        Doxygen restored(config);
+        restored.loadSnapshot(dir.string(), path);
+        const auto& restoredC = *restored.find("classC");
+        CHECK(inheritedNames(restoredC, "classB") == std::vector<std::string>{"execute", "tick"});
+        CHECK(inheritedNames(restoredC, "classA") == std::vector<std::string>{"value"});
+    }
+}
@@ -0,0 +1,79 @@
+#include <Doxybook/JsonDelta.hpp>
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+
+using namespace Doxybook2;
+
+static nlohmann::json readJson(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    return nlohmann::json::parse(file);
+}
+
+TEST_CASE("Compare the JSON output with the previous run", "[JsonDelta]") {
+    const auto dir = std::filesystem::temp_directory_path() / "doxybook_json_delta";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    const nlohmann::json foo = {{"name", "Foo"}, {"brief", "Old"}, {"members", {"a", "b"}}};
+    const nlohmann::json fooChanged = {{"name", "Foo"}, {"brief", "New"}, {"members", {"a"}}};
+    const nlohmann::json bar = {{"name", "Bar"}};
+
+    // The previous run
+    {
+        FileOutput files(dir.string());
+        HashingOutput output(files);
+        output.write("classFoo.json", foo.dump(2));
+        output.write("classBar.json", bar.dump(2));
+        output.write("classOld.json", "{}");
+        output.write("classResumed.json", "{}");
+        output.write("logo.png", "png");
+        output.writeHashes();
+    }
+
+    SECTION("Added, removed and modified files") {
+        FileOutput files(dir.string());
+        HashingOutput hashing(files);
+        JsonDeltaOutput output(hashing, dir.string());
+        REQUIRE(output.hasPrevious());
+
+        output.write("classFoo.json", fooChanged.dump(2));
+        output.write("classBar.json", bar.dump(2));
+        output.write("classNew.json", "{}");
+        output.add("classResumed.json", Hash::of("{\"changed\":true}"));
+        output.writeDelta();
+
+        const auto delta = readJson(dir / "delta.json");
+        CHECK(delta.at("previous") == true);
+        CHECK(delta.at("added") == nlohmann::json{"classNew.json"});
+        CHECK(delta.at("removed") == nlohmann::json{"classOld.json"});
+
+        const auto& modified = delta.at("modified");
+        REQUIRE(modified.size() == 2);
+        CHECK(modified[0].at("path") == "classFoo.json");
+        CHECK(foo.patch(modified[0].at("patch")) == fooChanged);
+        CHECK(modified[1].at("path") == "classResumed.json");
+        CHECK(modified[1].at("patch").is_null());
+
+        // The file has been overwritten after it has been compared
+        CHECK(readJson(dir / "classFoo.json") == fooChanged);
+    }
+
+    SECTION("Without the previous hashes") {
+        std::filesystem::remove(dir / "hashes.json");
+        MemoryOutput memory;
+        JsonDeltaOutput output(memory, dir.string());
+        CHECK_FALSE(output.hasPrevious());
+
+        output.write("classFoo.json", foo.dump(2));
+        output.writeDelta();
+
+        const auto delta = nlohmann::json::parse(memory.get("delta.json"));
+        CHECK(delta.at("previous") == false);
+        CHECK(delta.at("added") == nlohmann::json{"classFoo.json"});
+        CHECK(delta.at("removed").empty());
+        CHECK(delta.at("modified").empty());
+    }
+
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,153 @@
+#include <Doxybook/Config.hpp>
+#include <Doxybook/Doxygen.hpp>
+#include <Doxybook/LoadFilter.hpp>
+#include <Doxybook/TextMarkdownPrinter.hpp>
+#include <Doxybook/TextPlainPrinter.hpp>
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+
+using namespace Doxybook2;
+
+static const std::string INDEX_XML = R"(<?xml version='1.0' encoding='UTF-8' standalone='no'?>
+<doxygenindex version="1.8.17">
+  <compound refid="namespacens" kind="namespace"><name>ns</name></compound>
+  <compound refid="namespacens_1_1detail" kind="namespace"><name>ns::detail</name></compound>
+  <compound refid="classns_1_1Foo" kind="class"><name>ns::Foo</name></compound>
+  <compound refid="classns_1_1detail_1_1Impl" kind="class"><name>ns::detail::Impl</name></compound>
+</doxygenindex>
+)";
+
+static const std::string NS_XML = R"(<?xml version='1.0' encoding='UTF-8' standalone='no'?>
+<doxygen version="1.8.17">
+  <compounddef id="namespacens" kind="namespace" language="C++">
+    <compoundname>ns</compoundname>
+    <innerclass refid="classns_1_1Foo" prot="public">ns::Foo</innerclass>
+    <innernamespace refid="namespacens_1_1detail">ns::detail</innernamespace>
+    <briefdescription></briefdescription>
+    <detaileddescription></detaileddescription>
+  </compounddef>
+</doxygen>
+)";
+
+static const std::string DETAIL_XML = R"(<?xml version='1.0' encoding='UTF-8' standalone='no'?>
+<doxygen version="1.8.17">
+  <compounddef id="namespacens_1_1detail" kind="namespace" language="C++">
+    <compoundname>ns::detail</compoundname>
+    <innerclass refid="classns_1_1detail_1_1Impl" prot="public">ns::detail::Impl</innerclass>
+    <briefdescription></briefdescription>
+    <detaileddescription></detaileddescription>
+  </compounddef>
+</doxygen>
+)";
+
+static const std::string FOO_XML = R"(<?xml version='1.0' encoding='UTF-8' standalone='no'?>
+<doxygen version="1.8.17">
+  <compounddef id="classns_1_1Foo" kind="class" language="C++" prot="public">
+    <compoundname>ns::Foo</compoundname>
+    <sectiondef kind="public-func">
+      <memberdef kind="function" id="classns_1_1Foo_1a0" prot="public" static="no" virt="non-virtual">
+        <name>documented</name>
+        <briefdescription><para>Documented</para></briefdescription>
+        <detaileddescription></detaileddescription>
+      </memberdef>
+      <memberdef kind="function" id="classns_1_1Foo_1a1" prot="public" static="no" virt="non-virtual">
+        <name>undocumented</name>
+        <briefdescription></briefdescription>
+        <detaileddescription></detaileddescription>
+      </memberdef>
+    </sectiondef>
+    <sectiondef kind="private-func">
+      <memberdef kind="function" id="classns_1_1Foo_1a2" prot="private" static="no" virt="non-virtual">
+        <name>secret</name>
+        <briefdescription><para>Secret</para></briefdescription>
+        <detaileddescription></detaileddescription>
+      </memberdef>
+    </sectiondef>
+    <briefdescription><para>Uses <ref refid="classns_1_1detail_1_1Impl" kindref="compound">Impl</ref></para></briefdescription>
+    <detaileddescription></detaileddescription>
+  </compounddef>
+</doxygen>
+)";
+
+static const std::string IMPL_XML = R"(<?xml version='1.0' encoding='UTF-8' standalone='no'?>
+<doxygen version="1.8.17">
+  <compounddef id="classns_1_1detail_1_1Impl" kind="class" language="C++" prot="public">
+    <compoundname>ns::detail::Impl</compoundname>
+    <briefdescription><para>Implementation</para></briefdescription>
+    <detaileddescription></detaileddescription>
+  </compounddef>
+</doxygen>
+)";
+
+TEST_CASE("Exclude patterns match the enclosing scopes") {
+    Config config;
+    config.loadExclude = {"*::detail"};
+    const LoadFilter filter(config);
+    CHECK(filter.isEnabled());
+    CHECK(filter.isExcluded("ns::detail"));
+    CHECK(filter.isExcluded("ns::detail::Impl"));
+    CHECK(filter.isExcluded("ns::detail::Impl::run"));
+    CHECK(!filter.isExcluded("ns::details"));
+    CHECK(!filter.isExcluded("ns::Foo"));
+    CHECK(!LoadFilter(Config{}).isEnabled());
+}
+
+TEST_CASE("Filtered entities are not loaded") {
+    const auto dir = std::filesystem::temp_directory_path() / "doxybook2_load_filter";
+    std::filesystem::create_directories(dir);
+    std::ofstream((dir / "index.xml").string()) << INDEX_XML;
+    std::ofstream((dir / "namespacens.xml").string()) << NS_XML;
+    std::ofstream((dir / "namespacens_1_1detail.xml").string()) << DETAIL_XML;
+    std::ofstream((dir / "classns_1_1Foo.xml").string()) << FOO_XML;
+    std::ofstream((dir / "classns_1_1detail_1_1Impl.xml").string()) << IMPL_XML;
+
+    Config config;
+    config.copyImages = false;
+
+    SECTION("Everything without filters") {
+        Doxygen doxygen(config);
+        TextPlainPrinter plainPrinter(config, doxygen);
+        TextMarkdownPrinter markdownPrinter(config, dir.string(), doxygen);
+        doxygen.load(dir.string());
+        doxygen.finalize(plainPrinter, markdownPrinter);
+
+        CHECK(doxygen.getCache().count("classns_1_1detail_1_1Impl") == 1);
+        CHECK(doxygen.find("classns_1_1Foo")->getChildren().size() == 3);
+        CHECK(doxygen.find("classns_1_1Foo")->getBrief().find("](") != std::string::npos);
+    }
+
+    SECTION("Public, documented, and without detail") {
+        config.loadVisibility = Visibility::PUBLIC;
+        config.loadUndocumented = false;
+        config.loadExclude = {"*::detail"};
+        Doxygen doxygen(config);
+        TextPlainPrinter plainPrinter(config, doxygen);
+        TextMarkdownPrinter markdownPrinter(config, dir.string(), doxygen);
+        doxygen.load(dir.string());
+        doxygen.finalize(plainPrinter, markdownPrinter);
+
+        CHECK(doxygen.getCache().count("namespacens_1_1detail") == 0);
+        CHECK(doxygen.getCache().count("classns_1_1detail_1_1Impl") == 0);
+        CHECK(doxygen.getCache().count("classns_1_1Foo_1a1") == 0);
+        CHECK(doxygen.getCache().count("classns_1_1Foo_1a2") == 0);
+
+        const auto foo = doxygen.find("classns_1_1Foo");
+        REQUIRE(foo->getChildren().size() == 1);
+        CHECK(foo->getChildren().front()->getName() == "documented");
+        CHECK(doxygen.find("namespacens")->getChildren().size() == 1);
+
+        // The link to the filtered class is plain text
+        CHECK(foo->getBrief().find("Impl") != std::string::npos);
+        CHECK(foo->getBrief().find("](") == std::string::npos);
+    }
+
+    SECTION("Languages") {
+        config.loadLanguages = {"python"};
+        Doxygen doxygen(config);
+        doxygen.load(dir.string());
+        CHECK(doxygen.getIndex().getChildren().empty());
+    }
+
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,51 @@
+#include <Doxybook/NodeCache.hpp>
+#include <catch2/catch.hpp>
+#include <thread>
+
+using namespace Doxybook2;
+
+TEST_CASE("Node cache keeps the first inserted node") {
+    NodeCache cache(4);
+    const auto a = std::make_shared<Node>("classFoo");
+    const auto b = std::make_shared<Node>("classFoo");
+
+    CHECK(cache.find("classFoo") == nullptr);
+    CHECK(cache.insert(a) == a);
+    CHECK(cache.insert(b) == a);
+    CHECK(cache.find("classFoo") == a);
+    CHECK(cache.size() == 1);
+
+    const auto map = cache.freeze();
+    CHECK(map.size() == 1);
+    CHECK(map.at("classFoo") == a);
+    CHECK(cache.size() == 0);
+}
+
+TEST_CASE("Node cache resolves concurrent inserts to a single winner") {
+    static const auto numOfThreads = 8;
+    static const auto numOfRefids = 1000;
+
+    NodeCache cache;
+    std::vector<std::vector<NodePtr>> results(numOfThreads);
+    std::vector<std::thread> threads;
+    for (auto t = 0; t < numOfThreads; t++) {
+        threads.emplace_back([&, t]() {
+            for (auto i = 0; i < numOfRefids; i++) {
+                const auto node = std::make_shared<Node>("class" + std::to_string(i));
+                results[t].push_back(cache.insert(node));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    CHECK(cache.size() == numOfRefids);
+    for (auto i = 0; i < numOfRefids; i++) {
+        const auto winner = cache.find("class" + std::to_string(i));
+        REQUIRE(winner != nullptr);
+        for (auto t = 0; t < numOfThreads; t++) {
+            CHECK(results[t][i] == winner);
+        }
+    }
+}
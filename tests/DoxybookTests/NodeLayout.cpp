@@ -0,0 +1,76 @@
+#include <Doxybook/Config.hpp>
+#include <Doxybook/Doxygen.hpp>
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+
+using namespace Doxybook2;
+
+static const std::string INDEX_XML = R"(<?xml version='1.0' encoding='UTF-8' standalone='no'?>
+<doxygenindex version="1.8.17">
+  <compound refid="classBase" kind="class"><name>Base</name></compound>
+  <compound refid="classFoo" kind="class"><name>Foo</name></compound>
+</doxygenindex>
+)";
+
+static const std::string BASE_XML = R"(<?xml version='1.0' encoding='UTF-8' standalone='no'?>
+<doxygen version="1.8.17">
+  <compounddef id="classBase" kind="class" language="C++" prot="public">
+    <compoundname>Base</compoundname>
+    <derivedcompoundref refid="classFoo" prot="public" virt="non-virtual">Foo</derivedcompoundref>
+  </compounddef>
+</doxygen>
+)";
+
+static const std::string FOO_XML = R"(<?xml version='1.0' encoding='UTF-8' standalone='no'?>
+<doxygen version="1.8.17">
+  <compounddef id="classFoo" kind="class" language="C++" prot="public">
+    <compoundname>Foo</compoundname>
+    <basecompoundref refid="classBase" prot="public" virt="non-virtual">Base</basecompoundref>
+    <sectiondef kind="public-func">
+      <memberdef kind="function" id="classFoo_1a0" prot="public" static="no" virt="non-virtual">
+        <name>bar</name>
+      </memberdef>
+      <memberdef kind="enum" id="classFoo_1a1" prot="public" static="no" strong="yes">
+        <name>Color</name>
+        <enumvalue id="classFoo_1a1a0" prot="public"><name>RED</name></enumvalue>
+      </memberdef>
+    </sectiondef>
+  </compounddef>
+</doxygen>
+)";
+
+TEST_CASE("Members do not carry compound fields") {
+    const auto dir = std::filesystem::temp_directory_path() / "doxybook2_node_layout";
+    std::filesystem::create_directories(dir);
+    std::ofstream((dir / "index.xml").string()) << INDEX_XML;
+    std::ofstream((dir / "classBase.xml").string()) << BASE_XML;
+    std::ofstream((dir / "classFoo.xml").string()) << FOO_XML;
+
+    Config config;
+    Doxygen doxygen(config);
+    doxygen.load(dir.string());
+    std::filesystem::remove_all(dir);
+
+    const auto klass = doxygen.find("classFoo");
+    CHECK(klass->getTitle() == "Foo");
+    CHECK(klass->getChildren().size() == 2);
+    CHECK(!klass->getXmlPath().empty());
+    REQUIRE(klass->getBaseClasses().size() == 1);
+    CHECK(klass->getBaseClasses().front().name == "Base");
+    CHECK(doxygen.find("classBase")->getDerivedClasses().size() == 1);
+
+    const auto member = doxygen.find("classFoo_1a0");
+    CHECK(member->getTitle() == "bar");
+    CHECK(member->getChildren().empty());
+    CHECK(member->getXmlPath().empty());
+    CHECK(member->getBaseClasses().empty());
+    CHECK(member->getLanguage() == "cpp");
+    // The language string is shared with the parent, not copied
+    CHECK(&member->getLanguage() == &klass->getLanguage());
+
+    const auto enumeration = doxygen.find("classFoo_1a1");
+    REQUIRE(enumeration->getChildren().size() == 1);
+    CHECK(enumeration->getChildren().front()->getName() == "RED");
+    CHECK(enumeration->getTitle() == "Color");
+}
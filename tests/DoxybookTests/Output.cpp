@@ -0,0 +1,198 @@
+#include <Doxybook/Doxygen.hpp>
+#include <Doxybook/Generator.hpp>
+#include <Doxybook/Output.hpp>
+#include <Doxybook/Path.hpp>
+#include <Doxybook/TextMarkdownPrinter.hpp>
+#include <Doxybook/TextPlainPrinter.hpp>
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+using namespace Doxybook2;
+
+TEST_CASE("Render into memory") {
+    Config config;
+    config.copyImages = false;
+    config.useFolders = false;
+    config.outputDir = "this/folder/does/not/exist";
+    MemoryOutput output;
+    Doxygen doxygen(config);
+    TextPlainPrinter plainPrinter(config, doxygen);
+    TextMarkdownPrinter markdownPrinter(config, IMPORT_DIR, doxygen, &output);
+    JsonConverter jsonConverter(config, doxygen, plainPrinter, markdownPrinter);
+
+    doxygen.load(IMPORT_DIR);
+    doxygen.finalize(plainPrinter, markdownPrinter);
+
+    Generator generator(config, doxygen, jsonConverter, output, std::nullopt);
+
+    SECTION("Manifest") {
+        generator.manifest();
+        REQUIRE(output.contains("manifest.json"));
+        const auto manifest = nlohmann::json::parse(output.get("manifest.json"));
+        CHECK(manifest.is_array());
+        CHECK(!manifest.empty());
+    }
+
+    SECTION("Pages") {
+        generator.print({Kind::NAMESPACE, Kind::CLASS, Kind::STRUCT}, {Kind::NAMESPACE});
+#if defined(__linux__) || defined(__APPLE__)
+        const auto path = std::string("classEngine_1_1Audio_1_1AudioManager.md");
+#else
+        const auto path = std::string("class_engine_1_1_audio_1_1_audio_manager.md");
+#endif
+        REQUIRE(output.contains(path));
+        CHECK(output.get(path).find("AudioManager") != std::string::npos);
+        CHECK(!output.contains("manifest.json"));
+    }
+
+    SECTION("Json") {
+        generator.json({Kind::NAMESPACE, Kind::CLASS}, {});
+        for (const auto& pair : output.getFiles()) {
+            CHECK(pair.first.find(".json") == pair.first.size() - 5);
+            CHECK(nlohmann::json::parse(pair.second).is_object());
+        }
+        CHECK(!output.getFiles().empty());
+    }
+}
+
+TEST_CASE("Render into sharded folders") {
+    Config config;
+    config.copyImages = false;
+    config.useFolders = true;
+    config.folderShardLength = 2;
+    config.outputDir = "this/folder/does/not/exist";
+    MemoryOutput output;
+    Doxygen doxygen(config);
+    TextPlainPrinter plainPrinter(config, doxygen);
+    TextMarkdownPrinter markdownPrinter(config, IMPORT_DIR, doxygen, &output);
+    JsonConverter jsonConverter(config, doxygen, plainPrinter, markdownPrinter);
+
+    doxygen.load(IMPORT_DIR);
+    doxygen.finalize(plainPrinter, markdownPrinter);
+
+    Generator generator(config, doxygen, jsonConverter, output, std::nullopt);
+    generator.print({Kind::NAMESPACE, Kind::CLASS, Kind::STRUCT}, {Kind::NAMESPACE});
+    REQUIRE(!output.getFiles().empty());
+
+    for (const auto& pair : doxygen.getCache()) {
+        const auto& node = *pair.second;
+        if (node.getKind() != Kind::CLASS) {
+            continue;
+        }
+
+        // The url and the path of the generated page use the same shard
+        const auto shard = shardFolderName(config, node.getRefid());
+        CHECK(shard.size() == 2);
+        CHECK(node.getUrl() == "Classes/" + shard + "/" + node.getRefid() + ".md");
+        CHECK(output.contains(Path::join("Classes", shard, node.getRefid() + ".md")));
+    }
+}
+
+TEST_CASE("Render in forked processes") {
+    const auto render = [](const int processes, MemoryOutput& output) {
+        Config config;
+        config.copyImages = false;
+        config.useFolders = false;
+        config.outputDir = "this/folder/does/not/exist";
+        config.renderProcesses = processes;
+        config.renderProcessBatchSize = 3;
+        Doxygen doxygen(config);
+        TextPlainPrinter plainPrinter(config, doxygen);
+        TextMarkdownPrinter markdownPrinter(config, IMPORT_DIR, doxygen, &output);
+        JsonConverter jsonConverter(config, doxygen, plainPrinter, markdownPrinter);
+
+        doxygen.load(IMPORT_DIR);
+        doxygen.finalize(plainPrinter, markdownPrinter);
+
+        Generator generator(config, doxygen, jsonConverter, output, std::nullopt);
+        generator.print({Kind::NAMESPACE, Kind::CLASS, Kind::STRUCT}, {});
+        generator.json({Kind::NAMESPACE, Kind::CLASS}, {});
+        return generator.getStats();
+    };
+
+    MemoryOutput pipeline;
+    MemoryOutput forked;
+    const auto pipelineStats = render(0, pipeline);
+    const auto forkedStats = render(3, forked);
+
+    REQUIRE(!pipeline.getFiles().empty());
+    CHECK(forked.getFiles() == pipeline.getFiles());
+    REQUIRE(forkedStats.size() == pipelineStats.size());
+    for (size_t i = 0; i < forkedStats.size(); i++) {
+        CHECK(forkedStats[i].name == pipelineStats[i].name);
+        CHECK(forkedStats[i].processed == pipelineStats[i].processed);
+    }
+}
+
+static const std::string LISTING_INDEX_XML = R"(<?xml version='1.0' encoding='UTF-8' standalone='no'?>
+<doxygenindex version="1.8.17">
+  <compound refid="main_8cpp" kind="file"><name>main.cpp</name></compound>
+</doxygenindex>
+)";
+
+static const std::string LISTING_FILE_XML = R"(<?xml version='1.0' encoding='UTF-8' standalone='no'?>
+<doxygen version="1.8.17">
+  <compounddef id="main_8cpp" kind="file" language="C++">
+    <compoundname>main.cpp</compoundname>
+    <briefdescription></briefdescription>
+    <detaileddescription></detaileddescription>
+    <programlisting>
+<codeline lineno="1"><highlight class="keywordtype">int</highlight><highlight class="normal"><sp/>main()<sp/>{</highlight></codeline>
+<codeline lineno="2"><highlight class="normal"><sp/><sp/><sp/><sp/></highlight><highlight class="keywordflow">return</highlight><highlight class="normal"><sp/>0;</highlight></codeline>
+<codeline lineno="3"><highlight class="normal">}</highlight></codeline>
+    </programlisting>
+    <location file="main.cpp"/>
+  </compounddef>
+</doxygen>
+)";
+
+TEST_CASE("Source listings") {
+    const auto dir = std::filesystem::temp_directory_path() / "doxybook2_source_listing";
+    std::filesystem::create_directories(dir);
+    std::ofstream((dir / "index.xml").string()) << LISTING_INDEX_XML;
+    std::ofstream((dir / "main_8cpp.xml").string()) << LISTING_FILE_XML;
+    const auto listing = std::string("int main() {\n    return 0;\n}");
+
+    Config config;
+    config.copyImages = false;
+    config.outputDir = "this/folder/does/not/exist";
+
+    MemoryOutput output;
+    const auto render = [&](const SourceListing sourceListing) {
+        config.sourceListing = sourceListing;
+        Doxygen doxygen(config);
+        TextPlainPrinter plainPrinter(config, doxygen);
+        TextMarkdownPrinter markdownPrinter(config, dir.string(), doxygen, &output);
+        JsonConverter jsonConverter(config, doxygen, plainPrinter, markdownPrinter);
+        doxygen.load(dir.string());
+        doxygen.finalize(plainPrinter, markdownPrinter);
+
+        Generator generator(config, doxygen, jsonConverter, output, std::nullopt);
+        generator.print({Kind::FILE}, {});
+        REQUIRE(output.contains(Path::join("Files", "main_8cpp.md")));
+    };
+
+    SECTION("Inline") {
+        render(SourceListing::INLINE);
+        CHECK(output.get(Path::join("Files", "main_8cpp.md")).find(listing) != std::string::npos);
+    }
+
+    SECTION("None") {
+        render(SourceListing::NONE);
+        CHECK(output.get(Path::join("Files", "main_8cpp.md")).find("return 0;") == std::string::npos);
+        CHECK(output.getFiles().size() == 1);
+    }
+
+    SECTION("File") {
+        render(SourceListing::FILE);
+        const auto page = output.get(Path::join("Files", "main_8cpp.md"));
+        CHECK(page.find("return 0;") == std::string::npos);
+        CHECK(page.find("(main_8cpp.source.cpp)") != std::string::npos);
+        REQUIRE(output.contains(Path::join("Files", "main_8cpp.source.cpp")));
+        CHECK(output.get(Path::join("Files", "main_8cpp.source.cpp")) == listing);
+    }
+
+    std::filesystem::remove_all(dir);
+}
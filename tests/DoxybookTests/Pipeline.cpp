@@ -0,0 +1,45 @@
+#include <Doxybook/Pipeline.hpp>
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <stdexcept>
+
+using namespace Doxybook2;
+
+TEST_CASE("Pipeline passes all items through all stages") {
+    std::atomic<int> sum{0};
+    Pipeline<int> pipeline(4);
+    pipeline.addStage("double", 3, [](int& value) { value *= 2; });
+    pipeline.addStage("increment", 1, [](int& value) { value += 1; });
+    pipeline.addStage("sum", 2, [&](int& value) { sum += value; });
+
+    for (auto i = 0; i < 1000; i++) {
+        pipeline.push(i);
+    }
+    const auto stats = pipeline.finish();
+
+    CHECK(sum == 999 * 1000 + 1000);
+    REQUIRE(stats.size() == 3);
+    for (const auto& stage : stats) {
+        CHECK(stage.processed == 1000);
+        CHECK(stage.maxQueueDepth <= 4);
+    }
+    CHECK(stats[0].threads == 3);
+}
+
+TEST_CASE("Pipeline rethrows the first error") {
+    Pipeline<int> pipeline(2);
+    pipeline.addStage("fail", 2, [](int& value) {
+        if (value == 50) {
+            throw std::runtime_error("failed");
+        }
+    });
+
+    CHECK_THROWS_WITH(
+        [&] {
+            for (auto i = 0; i < 100000; i++) {
+                pipeline.push(i);
+            }
+            pipeline.finish();
+        }(),
+        "failed");
+}
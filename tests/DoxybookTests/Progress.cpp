@@ -0,0 +1,75 @@
+#include <Doxybook/Progress.hpp>
+#include <catch2/catch.hpp>
+#include <nlohmann/json.hpp>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace Doxybook2;
+
+static std::vector<nlohmann::json> parseEvents(const std::string& str) {
+    std::vector<nlohmann::json> events;
+    std::stringstream ss(str);
+    std::string line;
+    while (std::getline(ss, line)) {
+        events.push_back(nlohmann::json::parse(line));
+    }
+    return events;
+}
+
+TEST_CASE("Progress events") {
+    std::stringstream ss;
+    Progress::setJsonStream(&ss);
+
+    {
+        Progress progress("render", 1000);
+        std::vector<std::thread> threads;
+        for (auto i = 0; i < 4; i++) {
+            threads.emplace_back([&]() {
+                for (auto n = 0; n < 250; n++) {
+                    progress.increment();
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        CHECK(progress.getDone() == 1000);
+        // The destructor does not report it again
+        progress.finish();
+    }
+
+    Progress::setJsonStream(nullptr);
+
+    const auto events = parseEvents(ss.str());
+    REQUIRE(events.size() >= 2);
+    CHECK(events.front()["event"] == "start");
+    CHECK(events.front()["phase"] == "render");
+    CHECK(events.front()["total"] == 1000);
+    CHECK(events.back()["event"] == "done");
+    CHECK(events.back()["done"] == 1000);
+    CHECK(events.back()["eta"] == 0.0);
+    for (size_t i = 1; i + 1 < events.size(); i++) {
+        CHECK(events[i]["event"] == "progress");
+    }
+}
+
+TEST_CASE("Progress with unknown total") {
+    std::stringstream ss;
+    Progress::setJsonStream(&ss);
+    {
+        Progress progress("load");
+        progress.addTotal(3);
+        progress.set(2);
+        CHECK(progress.getTotal() == 3);
+        CHECK(progress.getDone() == 2);
+    }
+    Progress::setJsonStream(nullptr);
+
+    const auto events = parseEvents(ss.str());
+    REQUIRE(events.size() >= 2);
+    CHECK(events.front()["total"] == 0);
+    CHECK(events.back()["event"] == "done");
+    CHECK(events.back()["total"] == 3);
+    CHECK(events.back()["done"] == 2);
+}
@@ -0,0 +1,58 @@
+#include <Doxybook/Doxygen.hpp>
+#include <Doxybook/Generator.hpp>
+#include <Doxybook/Output.hpp>
+#include <Doxybook/TextMarkdownPrinter.hpp>
+#include <Doxybook/TextPlainPrinter.hpp>
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+
+using namespace Doxybook2;
+
+TEST_CASE("Pages over the render limits are reported") {
+    // A class template that generates far more than the limit
+    const auto dir = std::filesystem::temp_directory_path() / "doxybook2_render_limits";
+    std::filesystem::create_directories(dir);
+    std::ofstream((dir / "kind_class.tmpl").string()) << "{% for i in range(100000) %}too large {% endfor %}";
+
+    Config config;
+    config.copyImages = false;
+    config.useFolders = false;
+    config.renderSizeLimit = 1000;
+    MemoryOutput output;
+    Doxygen doxygen(config);
+    TextPlainPrinter plainPrinter(config, doxygen);
+    TextMarkdownPrinter markdownPrinter(config, IMPORT_DIR, doxygen, &output);
+    JsonConverter jsonConverter(config, doxygen, plainPrinter, markdownPrinter);
+
+    doxygen.load(IMPORT_DIR);
+    doxygen.finalize(plainPrinter, markdownPrinter);
+
+    SECTION("Placeholder") {
+        Generator generator(config, doxygen, jsonConverter, output, dir.string());
+        generator.print({Kind::NAMESPACE, Kind::CLASS}, {Kind::NAMESPACE});
+
+        const auto& violations = generator.getRenderViolations();
+        REQUIRE(!violations.empty());
+        for (const auto& violation : violations) {
+            CHECK(violation.templateName == "kind_class");
+            CHECK(doxygen.find(violation.refid)->getKind() == Kind::CLASS);
+            const auto& contents = output.get(violation.refid + ".md");
+            CHECK(contents.find("This page was not generated") != std::string::npos);
+            CHECK(contents.size() < 1000);
+        }
+    }
+
+    SECTION("Skip") {
+        config.renderLimitPlaceholder = false;
+        Generator generator(config, doxygen, jsonConverter, output, dir.string());
+        generator.print({Kind::NAMESPACE, Kind::CLASS}, {Kind::NAMESPACE});
+
+        REQUIRE(!generator.getRenderViolations().empty());
+        for (const auto& violation : generator.getRenderViolations()) {
+            CHECK(!output.contains(violation.refid + ".md"));
+        }
+    }
+
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,103 @@
+#include <Doxybook/Resources.hpp>
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+
+using namespace Doxybook2;
+
+static const uint64_t MIB = 1024ULL * 1024ULL;
+
+TEST_CASE("Parse the cgroup limits", "[Resources]") {
+    auto limits = Resources::parse("max 100000\n", "max\n");
+    CHECK(limits.cpus == 0.0);
+    CHECK(limits.memory == 0);
+
+    limits = Resources::parse("150000 100000\n", "536870912\n");
+    CHECK(limits.cpus == Approx(1.5));
+    CHECK(limits.memory == 512 * MIB);
+
+    // Missing files (no cgroup v2) and garbage are no limits
+    limits = Resources::parse("", "");
+    CHECK(limits.cpus == 0.0);
+    CHECK(limits.memory == 0);
+    limits = Resources::parse("abc 100000", "lots");
+    CHECK(limits.cpus == 0.0);
+    CHECK(limits.memory == 0);
+}
+
+TEST_CASE("Read the lowest limits of the cgroup and its parents", "[Resources]") {
+    const auto root = std::filesystem::temp_directory_path() / "doxybook2_resources";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "system.slice" / "build.scope");
+    const auto write = [&](const std::filesystem::path& path, const std::string& contents) {
+        std::ofstream file(root / path);
+        file << contents;
+    };
+    write("system.slice/cpu.max", "200000 100000\n");
+    write("system.slice/memory.max", "max\n");
+    write("system.slice/build.scope/cpu.max", "max 100000\n");
+    write("system.slice/build.scope/memory.max", "1073741824\n");
+
+    auto limits = Resources::read(root.string(), "/system.slice/build.scope");
+    CHECK(limits.cpus == Approx(2.0));
+    CHECK(limits.memory == 1024 * MIB);
+
+    limits = Resources::read(root.string(), "/");
+    CHECK(limits.cpus == 0.0);
+    CHECK(limits.memory == 0);
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("Tune the config for the limits", "[Resources]") {
+    const Config defaults;
+
+    SECTION("No limits keep the defaults") {
+        Config config;
+        Resources::tune(config, Resources::Limits{});
+        CHECK(config.schedulerThreads == defaults.schedulerThreads);
+        CHECK(config.inheritedCacheSize == defaults.inheritedCacheSize);
+        CHECK(config.pipelineQueueSize == defaults.pipelineQueueSize);
+        CHECK(config.compressText == defaults.compressText);
+    }
+
+    SECTION("A CPU quota limits the worker threads") {
+        Config config;
+        Resources::tune(config, Resources::Limits{0.5, 0});
+        CHECK(config.schedulerThreads == 1);
+        CHECK(config.inheritedCacheSize == defaults.inheritedCacheSize);
+    }
+
+    SECTION("Plenty of memory keeps the caches") {
+        Config config;
+        Resources::tune(config, Resources::Limits{0.0, 8192 * MIB});
+        CHECK(config.schedulerThreads == defaults.schedulerThreads);
+        CHECK(config.inheritedCacheSize == defaults.inheritedCacheSize);
+        CHECK(config.compressText == defaults.compressText);
+    }
+
+    SECTION("Little memory shrinks the caches and turns on the low memory mode") {
+        Config config;
+        Resources::tune(config, Resources::Limits{0.0, 512 * MIB});
+        CHECK(config.inheritedCacheSize == 16);
+        CHECK(config.pipelineQueueSize == 16);
+        CHECK(config.compressText);
+
+        Resources::tune(config, Resources::Limits{0.0, 64 * MIB});
+        CHECK(config.inheritedCacheSize == 8);
+    }
+
+    SECTION("The config loaded afterwards takes precedence") {
+        Config config;
+        Resources::tune(config, Resources::Limits{1.0, 512 * MIB});
+        loadConfigData(config, R"({"schedulerThreads": 4, "compressText": false})");
+        CHECK(config.schedulerThreads == 4);
+        CHECK(!config.compressText);
+        CHECK(config.inheritedCacheSize == 16);
+    }
+}
+
+TEST_CASE("Describe the limits", "[Resources]") {
+    CHECK(Resources::describe(Resources::Limits{}) == "no CPU limit, no memory limit");
+    CHECK(Resources::describe(Resources::Limits{1.5, 512 * MIB}) == "1.5 CPUs, 512 MiB of memory");
+}
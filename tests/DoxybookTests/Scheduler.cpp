@@ -0,0 +1,129 @@
+#include <Doxybook/Pipeline.hpp>
+#include <Doxybook/Scheduler.hpp>
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <stdexcept>
+
+using namespace Doxybook2;
+
+TEST_CASE("Scheduler runs all tasks, also the ones submitted by tasks") {
+    Scheduler scheduler(4);
+    auto group = scheduler.createGroup("sum");
+    std::atomic<int> sum{0};
+    for (auto i = 0; i < 100; i++) {
+        scheduler.submit(group, [&, i]() {
+            for (auto j = 0; j < 10; j++) {
+                scheduler.submit(group, [&, i, j]() { sum += i * 10 + j; });
+            }
+        });
+    }
+    scheduler.wait(group);
+    CHECK(sum == 999 * 1000 / 2);
+}
+
+TEST_CASE("Scheduler keeps a group under its limit") {
+    Scheduler scheduler(8);
+    auto group = scheduler.createGroup("limited", 2);
+    std::atomic<int> running{0};
+    std::atomic<int> most{0};
+    std::atomic<int> done{0};
+    for (auto i = 0; i < 64; i++) {
+        scheduler.submit(group, [&]() {
+            const auto now = ++running;
+            auto previous = most.load();
+            while (now > previous && !most.compare_exchange_weak(previous, now)) {
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            running--;
+            done++;
+        });
+    }
+    scheduler.wait(group);
+    CHECK(done == 64);
+    CHECK(most <= 2);
+}
+
+TEST_CASE("Scheduler runs higher priorities first") {
+    Scheduler scheduler(1);
+    auto gate = scheduler.createGroup("gate");
+    auto low = scheduler.createGroup("low", 0, Scheduler::Priority::LOW);
+    auto high = scheduler.createGroup("high", 0, Scheduler::Priority::HIGH);
+
+    // Keeps the only thread busy until all of the tasks are queued
+    std::atomic<bool> open{false};
+    scheduler.submit(gate, [&]() {
+        while (!open) {
+            std::this_thread::yield();
+        }
+    });
+
+    std::mutex mutex;
+    std::vector<char> order;
+    for (auto i = 0; i < 5; i++) {
+        scheduler.submit(low, [&]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back('l');
+        });
+        scheduler.submit(high, [&]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back('h');
+        });
+    }
+    open = true;
+    scheduler.wait(gate);
+    scheduler.wait(high);
+    scheduler.wait(low);
+    CHECK(order == std::vector<char>{'h', 'h', 'h', 'h', 'h', 'l', 'l', 'l', 'l', 'l'});
+}
+
+TEST_CASE("Scheduler cancels a group on the first error") {
+    Scheduler scheduler(1);
+    auto group = scheduler.createGroup("fail");
+    auto other = scheduler.createGroup("other");
+    std::atomic<int> executed{0};
+    std::atomic<int> otherExecuted{0};
+    scheduler.submit(group, []() { throw std::runtime_error("failed"); });
+    for (auto i = 0; i < 100; i++) {
+        scheduler.submit(group, [&]() { executed++; });
+        scheduler.submit(other, [&]() { otherExecuted++; });
+    }
+    CHECK_THROWS_WITH(scheduler.wait(group), "failed");
+    scheduler.wait(other);
+    CHECK(executed < 100);
+    CHECK(otherExecuted == 100);
+}
+
+TEST_CASE("Scheduler wait inside of a task does not block the thread") {
+    Scheduler scheduler(1);
+    auto outer = scheduler.createGroup("outer");
+    auto inner = scheduler.createGroup("inner");
+    std::atomic<int> sum{0};
+    scheduler.submit(outer, [&]() {
+        for (auto i = 1; i <= 10; i++) {
+            scheduler.submit(inner, [&, i]() { sum += i; });
+        }
+        scheduler.wait(inner);
+        CHECK(sum == 55);
+    });
+    scheduler.wait(outer);
+    CHECK(sum == 55);
+}
+
+TEST_CASE("Pipelines share a single scheduler thread") {
+    Scheduler scheduler(1);
+    std::atomic<int> sum{0};
+    Pipeline<int> first(1, &scheduler);
+    first.addStage("a", 4, [](int& value) { value += 1; });
+    first.addStage("b", 4, [](int& value) { value *= 2; });
+    first.addStage("c", 4, [&](int& value) { sum += value; }, Scheduler::Priority::HIGH);
+    for (auto i = 0; i < 100; i++) {
+        first.push(i);
+    }
+    const auto stats = first.finish();
+    CHECK(sum == 100 * 101);
+    for (const auto& stage : stats) {
+        CHECK(stage.processed == 100);
+        CHECK(stage.maxQueueDepth <= 1);
+    }
+}
@@ -0,0 +1,246 @@
+#include <Doxybook/Schema.hpp>
+#include <catch2/catch.hpp>
+#include <random>
+#include <sstream>
+
+using namespace Doxybook2;
+
+// The hand written conversion the JsonConverter used before Schema.hpp existed,
+// kept here as the reference the generated output must match.
+static nlohmann::json legacyConvert(const Node::Location& location) {
+    nlohmann::json json;
+    json["file"] = location.file;
+    json["line"] = location.line;
+    json["column"] = location.column;
+    if (location.bodyStart > 0)
+        json["bodyStart"] = location.bodyStart;
+    if (location.bodyEnd > 0)
+        json["bodyEnd"] = location.bodyEnd;
+    if (!location.bodyFile.empty())
+        json["bodyFile"] = location.bodyFile;
+    return json;
+}
+
+static nlohmann::json legacyConvert(const Node::Param& param) {
+    nlohmann::json json;
+    json["type"] = param.type;
+    json["typePlain"] = param.typePlain;
+    json["name"] = param.name;
+    if (!param.defval.empty())
+        json["defval"] = param.defval;
+    if (!param.defvalPlain.empty())
+        json["defvalPlain"] = param.defvalPlain;
+    return json;
+}
+
+static nlohmann::json legacyConvert(const Node::ParameterList& parameterList) {
+    nlohmann::json json = nlohmann::json::array();
+    for (const auto& item : parameterList) {
+        json.push_back({{"name", item.name}, {"text", item.text}});
+    }
+    return json;
+}
+
+static nlohmann::json legacyConvert(const Node::ClassReference& klass) {
+    nlohmann::json json;
+    if (!klass.refid.empty())
+        json["refid"] = klass.refid;
+    json["name"] = klass.name;
+    json["visibility"] = toStr(klass.prot);
+    json["virtual"] = toStr(klass.virt);
+    json["external"] = klass.ptr == nullptr;
+    return json;
+}
+
+static nlohmann::json legacyConvert(const Node::Data& data) {
+    nlohmann::json json;
+    const auto strings = {std::make_pair("details", &data.details),
+        std::make_pair("inbody", &data.inbody),
+        std::make_pair("includes", &data.includes),
+        std::make_pair("type", &data.type),
+        std::make_pair("initializer", &data.initializer),
+        std::make_pair("typePlain", &data.typePlain),
+        std::make_pair("deprecated", &data.deprecated),
+        std::make_pair("programlisting", &data.programlisting)};
+    for (const auto& pair : strings) {
+        if (!pair.second->empty())
+            json[pair.first] = *pair.second;
+    }
+    json["definition"] = data.definition;
+    const auto lists = {std::make_pair("see", &data.see),
+        std::make_pair("returns", &data.returns),
+        std::make_pair("authors", &data.authors),
+        std::make_pair("version", &data.version),
+        std::make_pair("since", &data.since),
+        std::make_pair("date", &data.date),
+        std::make_pair("note", &data.note),
+        std::make_pair("warning", &data.warning),
+        std::make_pair("pre", &data.pre),
+        std::make_pair("post", &data.post),
+        std::make_pair("copyright", &data.copyright),
+        std::make_pair("invariant", &data.invariant),
+        std::make_pair("remark", &data.remark),
+        std::make_pair("attention", &data.attention),
+        std::make_pair("par", &data.par),
+        std::make_pair("rcs", &data.rcs),
+        std::make_pair("todos", &data.todos),
+        std::make_pair("bugs", &data.bugs),
+        std::make_pair("tests", &data.tests)};
+    for (const auto& pair : lists) {
+        if (!pair.second->empty())
+            json[pair.first] = *pair.second;
+    }
+    json["static"] = data.isStatic;
+    json["abstract"] = data.isAbstract;
+    json["const"] = data.isConst;
+    json["explicit"] = data.isExplicit;
+    json["strong"] = data.isStrong;
+    json["inline"] = data.isInline;
+    json["override"] = data.isOverride;
+    if (!data.templateParams.empty()) {
+        json["templateParams"] = nlohmann::json::array();
+        for (const auto& param : data.templateParams) {
+            json["templateParams"].push_back(legacyConvert(param));
+        }
+    }
+    if (!data.location.file.empty())
+        json["location"] = legacyConvert(data.location);
+    if (!data.returnsList.empty())
+        json["returnsList"] = legacyConvert(data.returnsList);
+    if (!data.exceptionsList.empty())
+        json["exceptionsList"] = legacyConvert(data.exceptionsList);
+    if (!data.templateParamsList.empty())
+        json["templateParamsList"] = legacyConvert(data.templateParamsList);
+    if (!data.paramList.empty())
+        json["paramList"] = legacyConvert(data.paramList);
+    json["hasDetails"] = !data.details.empty() || !data.templateParams.empty() || !data.inbody.empty() ||
+                         !data.returnsList.empty() || !data.exceptionsList.empty() ||
+                         !data.templateParamsList.empty() || !data.paramList.empty() || !data.see.empty() ||
+                         !data.returns.empty() || !data.bugs.empty() || !data.tests.empty() || !data.todos.empty() ||
+                         !data.authors.empty() || !data.version.empty() || !data.since.empty() || !data.date.empty() ||
+                         !data.note.empty() || !data.warning.empty() || !data.pre.empty() || !data.post.empty() ||
+                         !data.copyright.empty() || !data.invariant.empty() || !data.remark.empty() ||
+                         !data.attention.empty() || !data.par.empty() || !data.rcs.empty() || !data.deprecated.empty();
+    return json;
+}
+
+class RandomData {
+public:
+    explicit RandomData(const unsigned seed) : rng(seed) {
+    }
+
+    std::string string() {
+        static const std::string chars = "abc \"\\\n\t\x01<>&::";
+        std::string str;
+        const auto length = std::uniform_int_distribution<int>(0, 3)(rng) == 0 ? 0 : 1 + rng() % 16;
+        for (size_t i = 0; i < length; i++) {
+            str += chars[rng() % chars.size()];
+        }
+        return str;
+    }
+
+    int integer() {
+        return std::uniform_int_distribution<int>(-2, 300)(rng);
+    }
+
+    bool boolean() {
+        return rng() % 2 == 0;
+    }
+
+    template <typename T, typename F> std::vector<T> list(F f) {
+        std::vector<T> vec(rng() % 3);
+        for (auto& item : vec) {
+            item = f();
+        }
+        return vec;
+    }
+
+    Node::Param param() {
+        return {string(), string(), string(), string(), string()};
+    }
+
+    Node::Data data() {
+        Node::Data data;
+        for (auto* str : {&data.details,
+                 &data.inbody,
+                 &data.includes,
+                 &data.type,
+                 &data.typePlain,
+                 &data.definition,
+                 &data.initializer,
+                 &data.deprecated,
+                 &data.programlisting}) {
+            *str = string();
+        }
+        for (auto* vec : {&data.see,
+                 &data.returns,
+                 &data.authors,
+                 &data.version,
+                 &data.since,
+                 &data.date,
+                 &data.note,
+                 &data.warning,
+                 &data.pre,
+                 &data.post,
+                 &data.copyright,
+                 &data.invariant,
+                 &data.remark,
+                 &data.attention,
+                 &data.par,
+                 &data.rcs,
+                 &data.bugs,
+                 &data.tests,
+                 &data.todos}) {
+            *vec = list<std::string>([&] { return string(); });
+        }
+        for (auto* b : {&data.isStatic,
+                 &data.isAbstract,
+                 &data.isConst,
+                 &data.isExplicit,
+                 &data.isStrong,
+                 &data.isInline,
+                 &data.isOverride}) {
+            *b = boolean();
+        }
+        data.location = {string(), integer(), integer(), string(), integer(), integer()};
+        data.templateParams = list<Node::Param>([&] { return param(); });
+        for (auto* vec : {&data.paramList, &data.returnsList, &data.templateParamsList, &data.exceptionsList}) {
+            *vec = list<Node::ParameterListItem>([&] { return Node::ParameterListItem{string(), string()}; });
+        }
+        return data;
+    }
+
+private:
+    std::mt19937 rng;
+};
+
+TEST_CASE("Schema output matches the hand written conversion") {
+    RandomData random(1234);
+    for (auto i = 0; i < 500; i++) {
+        const auto data = random.data();
+        CHECK(Schema::toJson(data) == legacyConvert(data));
+    }
+
+    Node::ClassReference klass{"Foo", "classFoo", Visibility::PROTECTED, Virtual::VIRTUAL, nullptr};
+    CHECK(Schema::toJson(klass) == legacyConvert(klass));
+    klass.refid.clear();
+    CHECK(Schema::toJson(klass) == legacyConvert(klass));
+}
+
+TEST_CASE("Schema writers produce the same document") {
+    RandomData random(42);
+    for (auto i = 0; i < 500; i++) {
+        const auto data = random.data();
+        const auto expected = Schema::toJson(data);
+
+        std::stringstream ss;
+        Schema::StreamWriter streamWriter(ss);
+        Schema::write(streamWriter, data);
+        CHECK(nlohmann::json::parse(ss.str()) == expected);
+
+        std::string cbor;
+        Schema::CborWriter cborWriter(cbor);
+        Schema::write(cborWriter, data);
+        CHECK(nlohmann::json::from_cbor(cbor) == expected);
+    }
+}
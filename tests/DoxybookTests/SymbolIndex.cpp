@@ -0,0 +1,158 @@
+#include <Doxybook/Config.hpp>
+#include <Doxybook/Doxygen.hpp>
+#include <Doxybook/Exception.hpp>
+#include <Doxybook/SymbolIndex.hpp>
+#include <Doxybook/TextMarkdownPrinter.hpp>
+#include <Doxybook/TextPlainPrinter.hpp>
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+
+using namespace Doxybook2;
+
+static const std::string INDEX_XML = R"(<?xml version='1.0' encoding='UTF-8' standalone='no'?>
+<doxygenindex version="1.8.17">
+  <compound refid="namespacens" kind="namespace"><name>ns</name></compound>
+  <compound refid="classns_1_1Widget" kind="class"><name>ns::Widget</name></compound>
+  <compound refid="classns_1_1Window" kind="class"><name>ns::Window</name></compound>
+  <compound refid="group__widgets" kind="group"><name>widgets</name></compound>
+</doxygenindex>
+)";
+
+static const std::string NAMESPACE_XML = R"(<?xml version='1.0' encoding='UTF-8' standalone='no'?>
+<doxygen version="1.8.17">
+  <compounddef id="namespacens" kind="namespace" language="C++">
+    <compoundname>ns</compoundname>
+    <innerclass refid="classns_1_1Widget" prot="public">ns::Widget</innerclass>
+    <innerclass refid="classns_1_1Window" prot="public">ns::Window</innerclass>
+    <briefdescription></briefdescription>
+    <detaileddescription></detaileddescription>
+  </compounddef>
+</doxygen>
+)";
+
+static std::string classXml(const std::string& refid, const std::string& name, const std::string& member) {
+    return R"(<?xml version='1.0' encoding='UTF-8' standalone='no'?>
+<doxygen version="1.8.17">
+  <compounddef id=")" +
+           refid + R"(" kind="class" language="C++" prot="public">
+    <compoundname>)" +
+           name + R"(</compoundname>
+    <sectiondef kind="public-func">
+      <memberdef kind="function" id=")" +
+           refid + R"(_1a0" prot="public" static="no" virt="non-virtual">
+        <name>)" +
+           member + R"(</name>
+        <briefdescription><para>The )" +
+           member + R"( function</para></briefdescription>
+        <detaileddescription></detaileddescription>
+      </memberdef>
+    </sectiondef>
+    <briefdescription><para>A )" +
+           name + R"(</para></briefdescription>
+    <detaileddescription></detaileddescription>
+  </compounddef>
+</doxygen>
+)";
+}
+
+static const std::string GROUP_XML = R"(<?xml version='1.0' encoding='UTF-8' standalone='no'?>
+<doxygen version="1.8.17">
+  <compounddef id="group__widgets" kind="group">
+    <compoundname>widgets</compoundname>
+    <title>User Interface</title>
+    <innerclass refid="classns_1_1Widget" prot="public">ns::Widget</innerclass>
+    <innerclass refid="classns_1_1Window" prot="public">ns::Window</innerclass>
+    <briefdescription></briefdescription>
+    <detaileddescription></detaileddescription>
+  </compounddef>
+</doxygen>
+)";
+
+static std::vector<std::string> fullnames(const std::vector<SymbolIndex::Symbol>& symbols) {
+    std::vector<std::string> result;
+    for (const auto& symbol : symbols) {
+        result.emplace_back(symbol.fullname);
+    }
+    return result;
+}
+
+TEST_CASE("Look up symbols in the symbol index", "[SymbolIndex]") {
+    const auto dir = std::filesystem::temp_directory_path() / "doxybook2_symbol_index";
+    std::filesystem::create_directories(dir);
+    const auto write = [&](const std::string& name, const std::string& contents) {
+        std::ofstream file(dir / name);
+        file << contents;
+    };
+    write("index.xml", INDEX_XML);
+    write("namespacens.xml", NAMESPACE_XML);
+    write("classns_1_1Widget.xml", classXml("classns_1_1Widget", "ns::Widget", "draw"));
+    write("classns_1_1Window.xml", classXml("classns_1_1Window", "ns::Window", "close"));
+    write("group__widgets.xml", GROUP_XML);
+
+    Config config;
+    Doxygen doxygen(config);
+    TextPlainPrinter plainPrinter(config, doxygen);
+    TextMarkdownPrinter markdownPrinter(config, dir.string(), doxygen);
+    doxygen.load(dir.string());
+    doxygen.finalize(plainPrinter, markdownPrinter);
+
+    const auto path = (dir / "symbols.idx").string();
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << SymbolIndex::build(doxygen.getIndex());
+    }
+    const SymbolIndex index(path);
+    REQUIRE(index.size() == 6);
+
+    SECTION("Exact lookups by the full name, the name, or the title") {
+        const auto draw = index.findExact("ns::Widget::draw");
+        REQUIRE(draw.size() == 1);
+        CHECK(draw[0].name == "draw");
+        CHECK(draw[0].kind == "function");
+        CHECK(draw[0].refid == "classns_1_1Widget_1a0");
+        CHECK(draw[0].url == doxygen.find("classns_1_1Widget_1a0")->getUrl());
+        CHECK(draw[0].brief == "The draw function");
+        CHECK(index.get(draw[0].parent).fullname == "ns::Widget");
+
+        CHECK(fullnames(index.findExact("draw")) == std::vector<std::string>{"ns::Widget::draw"});
+        CHECK(fullnames(index.findExact("User Interface")) == std::vector<std::string>{"widgets"});
+        CHECK(index.findExact("ns::Widget::dra").empty());
+    }
+
+    SECTION("Prefix lookups") {
+        CHECK(fullnames(index.findPrefix("ns::W", 0)) ==
+              std::vector<std::string>{"ns::Widget", "ns::Widget::draw", "ns::Window", "ns::Window::close"});
+        CHECK(index.findPrefix("ns::W", 2).size() == 2);
+        CHECK(index.findPrefix("nothing", 0).empty());
+    }
+
+    SECTION("Fuzzy lookups") {
+        const auto matches = index.findFuzzy("ns::Widjet", 3);
+        REQUIRE(!matches.empty());
+        CHECK(matches[0].symbol.fullname == "ns::Widget");
+        CHECK(matches[0].score < 1.0);
+        for (size_t i = 1; i < matches.size(); i++) {
+            CHECK(matches[i - 1].score >= matches[i].score);
+        }
+        CHECK(index.findFuzzy("zzzzzz", 3).empty());
+    }
+
+    SECTION("Members of a group") {
+        const auto group = index.findExact("widgets");
+        REQUIRE(group.size() == 1);
+        CHECK(fullnames(index.getChildren(group[0].id)) == std::vector<std::string>{"ns::Widget", "ns::Window"});
+    }
+
+    SECTION("Reject other files") {
+        const auto other = (dir / "other.idx").string();
+        {
+            std::ofstream file(other, std::ios::binary);
+            file << "not an index";
+        }
+        CHECK_THROWS_AS(SymbolIndex(other), Exception);
+        CHECK_THROWS_AS(SymbolIndex((dir / "missing.idx").string()), Exception);
+    }
+
+    std::filesystem::remove_all(dir);
+}
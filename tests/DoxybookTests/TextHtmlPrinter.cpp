@@ -0,0 +1,66 @@
+#include <Doxybook/Config.hpp>
+#include <Doxybook/Doxygen.hpp>
+#include <Doxybook/TextHtmlPrinter.hpp>
+#include <Doxybook/Xml.hpp>
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+
+using namespace Doxybook2;
+
+static std::string printHtml(const std::string& description) {
+    const auto path = (std::filesystem::temp_directory_path() / "doxybook_html_printer.xml").string();
+    {
+        std::ofstream file(path);
+        file << "<?xml version='1.0' encoding='UTF-8' standalone='no'?>\n";
+        file << "<detaileddescription>" << description << "</detaileddescription>\n";
+    }
+
+    Config config;
+    config.copyImages = false;
+    Doxygen doxygen(config);
+    TextHtmlPrinter printer(config, "", doxygen);
+    Xml xml(path);
+    const auto str = printer.print(XmlTextParser::parseParas(xml.firstChildElement("detaileddescription")), "cpp");
+    std::filesystem::remove(path);
+    return str;
+}
+
+TEST_CASE("Print text as HTML") {
+    SECTION("Single paragraph is printed inline and escaped") {
+        CHECK(printHtml("<para>Returns <bold>a &lt; b</bold> &amp; <emphasis>c</emphasis></para>") ==
+              "Returns <strong>a &lt; b</strong> &amp; <em>c</em>");
+    }
+
+    SECTION("Multiple paragraphs") {
+        CHECK(printHtml("<para>First</para><para>Second</para>") == "<p>First</p>\n<p>Second</p>");
+    }
+
+    SECTION("Lists and links") {
+        const auto html = printHtml("<para>See:<itemizedlist>"
+                                    "<listitem><para><ulink url=\"https://example.com/?a=1&amp;b=2\">one</ulink>"
+                                    "</para></listitem>"
+                                    "<listitem><para><computeroutput>x&lt;y</computeroutput></para></listitem>"
+                                    "</itemizedlist></para>");
+        CHECK(html.find("<ul>") != std::string::npos);
+        CHECK(html.find("<li><a href=\"https://example.com/?a=1&amp;b=2\">one</a></li>") != std::string::npos);
+        CHECK(html.find("<li><code>x&lt;y</code></li>") != std::string::npos);
+        CHECK(html.find("</ul>") != std::string::npos);
+    }
+
+    SECTION("Program listing") {
+        const auto html = printHtml("<para><programlisting><codeline><highlight class=\"normal\">if<sp/>(a<sp/>&lt;<sp/>b)"
+                                    "</highlight></codeline></programlisting></para>");
+        CHECK(html.find("<pre><code class=\"language-cpp\">if (a &lt; b)\n</code></pre>") != std::string::npos);
+    }
+
+    SECTION("Sections and tables") {
+        const auto html = printHtml("<sect1 id=\"s\"><title>Usage</title><para>"
+                                    "<table rows=\"2\" cols=\"1\"><row><entry thead=\"yes\"><para>Name</para></entry></row>"
+                                    "<row><entry thead=\"no\"><para>Value</para></entry></row></table>"
+                                    "</para></sect1>");
+        CHECK(html.find("<h1>Usage</h1>") != std::string::npos);
+        CHECK(html.find("<tr><th>Name</th></tr>") != std::string::npos);
+        CHECK(html.find("<tr><td>Value</td></tr>") != std::string::npos);
+    }
+}
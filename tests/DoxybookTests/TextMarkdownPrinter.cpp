@@ -0,0 +1,46 @@
+#include <Doxybook/Config.hpp>
+#include <Doxybook/Doxygen.hpp>
+#include <Doxybook/TextMarkdownPrinter.hpp>
+#include <Doxybook/Xml.hpp>
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+
+using namespace Doxybook2;
+
+static std::string printMarkdown(const std::string& description, const bool linkAndInlineCodeAsHTML) {
+    const auto path = (std::filesystem::temp_directory_path() / "doxybook_markdown_printer.xml").string();
+    {
+        std::ofstream file(path);
+        file << "<?xml version='1.0' encoding='UTF-8' standalone='no'?>\n";
+        file << "<detaileddescription>" << description << "</detaileddescription>\n";
+    }
+
+    Config config;
+    config.copyImages = false;
+    config.linkAndInlineCodeAsHTML = linkAndInlineCodeAsHTML;
+    Doxygen doxygen(config);
+    TextMarkdownPrinter printer(config, "", doxygen);
+    Xml xml(path);
+    const auto str = printer.print(XmlTextParser::parseParas(xml.firstChildElement("detaileddescription")), "cpp");
+    std::filesystem::remove(path);
+    return str;
+}
+
+TEST_CASE("Print text as Markdown") {
+    static const std::string link =
+        "<para><ulink url=\"https://example.com\">see <computeroutput>a_b</computeroutput></ulink> and "
+        "<ulink url=\"\">none</ulink></para>";
+    static const std::string quote = "<para><blockquote><para>a <computeroutput>b_c</computeroutput></para>"
+                                     "</blockquote>after</para>";
+
+    SECTION("Markdown links and inline code") {
+        CHECK(printMarkdown(link, false) == "[see `a_b`](https://example.com) and [none]");
+        CHECK(printMarkdown(quote, false) == "\n\n> a `b_c`\n> \n> \n\nafter");
+    }
+
+    SECTION("HTML links and inline code") {
+        CHECK(printMarkdown(link, true) == "<a href=\"https://example.com\">see <code>a&#95;b</code></a> and none");
+        CHECK(printMarkdown(quote, true) == "\n\n> a <code>b&#95;c</code>\n> \n> \n\nafter");
+    }
+}
@@ -0,0 +1,70 @@
+#include <Doxybook/Doxygen.hpp>
+#include <Doxybook/TextMarkdownPrinter.hpp>
+#include <Doxybook/TextPlainPrinter.hpp>
+#include <Doxybook/TextStore.hpp>
+#include <catch2/catch.hpp>
+
+using namespace Doxybook2;
+
+TEST_CASE("Text store") {
+    TextStore texts;
+    const std::vector<std::string> samples = {
+        "Returns the pointer to the audio buffer",
+        "Returns the size of the audio buffer in bytes",
+        "Returns the pointer to the audio buffer",
+        "Some random class",
+        "abcabcabcabcabcabcabcabcabcabcabcabcabcabc",
+        std::string(1000, 'x'),
+        "",
+    };
+    std::vector<TextStore::Id> ids;
+    for (const auto& sample : samples) {
+        ids.push_back(texts.add(sample));
+    }
+
+    SECTION("Same text is stored once") {
+        CHECK(ids[0] == ids[2]);
+        CHECK(ids[0] != ids[1]);
+        CHECK(ids[6] == TextStore::EMPTY);
+        CHECK(texts.getCount() == samples.size() - 1);
+    }
+
+    SECTION("Compressed text reads back the same") {
+        const auto before = texts.getResidentSize();
+        texts.compress(8);
+        CHECK(texts.isCompressed());
+        CHECK(texts.getResidentSize() < before);
+        for (size_t i = 0; i < samples.size(); i++) {
+            CHECK(texts.get(ids[i]) == samples[i]);
+        }
+
+        const auto added = texts.add("Returns the size of the audio buffer");
+        CHECK(texts.get(added) == "Returns the size of the audio buffer");
+    }
+}
+
+TEST_CASE("Compressed text of the model") {
+    Config config;
+    config.copyImages = false;
+    Doxygen doxygen(config);
+    TextPlainPrinter plainPrinter(config, doxygen);
+    TextMarkdownPrinter markdownPrinter(config, IMPORT_DIR, doxygen);
+    doxygen.load(IMPORT_DIR);
+    doxygen.finalize(plainPrinter, markdownPrinter);
+
+    Config compressedConfig = config;
+    compressedConfig.compressText = true;
+    compressedConfig.compressTextMinLength = 0;
+    Doxygen compressed(compressedConfig);
+    TextPlainPrinter compressedPlainPrinter(compressedConfig, compressed);
+    TextMarkdownPrinter compressedMarkdownPrinter(compressedConfig, IMPORT_DIR, compressed);
+    compressed.load(IMPORT_DIR);
+    compressed.finalize(compressedPlainPrinter, compressedMarkdownPrinter);
+
+    REQUIRE(compressed.getCache().size() == doxygen.getCache().size());
+    for (const auto& pair : doxygen.getCache()) {
+        const auto& node = *compressed.find(pair.first);
+        CHECK(node.getBrief() == pair.second->getBrief());
+        CHECK(node.getSummary() == pair.second->getSummary());
+    }
+}
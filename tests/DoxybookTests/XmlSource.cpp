@@ -0,0 +1,97 @@
+#include <Doxybook/Config.hpp>
+#include <Doxybook/Doxygen.hpp>
+#include <Doxybook/XmlSource.hpp>
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+
+using namespace Doxybook2;
+
+static std::string classXml(const std::string& name, const int members) {
+    std::string str = "<compounddef id=\"class" + name + "\" kind=\"class\" language=\"C++\" prot=\"public\">";
+    str += "<compoundname>" + name + "</compoundname><sectiondef kind=\"public-func\">";
+    for (auto i = 0; i < members; i++) {
+        const auto id = std::to_string(i);
+        str += "<memberdef kind=\"function\" id=\"class" + name + "_1a" + id +
+               "\" prot=\"public\" static=\"no\" virt=\"non-virtual\"><name>f" + id +
+               "</name><briefdescription><para>Does f" + id + "</para></briefdescription></memberdef>\n";
+    }
+    str += "</sectiondef></compounddef>";
+    return str;
+}
+
+TEST_CASE("Combined xml is loaded the same as the xml folder") {
+    static const std::string header = "<?xml version='1.0' encoding='UTF-8' standalone='no'?>\n";
+    const auto dir = std::filesystem::temp_directory_path() / "doxybook2_xml_source";
+    std::filesystem::create_directories(dir);
+
+    // Enough members so that the compounds do not fit into a single chunk of the combined file
+    const std::vector<std::pair<std::string, int>> classes = {{"Foo", 3}, {"Bar", 20000}, {"Baz", 1}};
+
+    std::ofstream index((dir / "index.xml").string());
+    std::ofstream all((dir / "all.xml").string());
+    index << header << "<doxygenindex version=\"1.8.17\">\n";
+    all << header << "<doxygen version=\"1.8.17\">\n";
+    for (const auto& pair : classes) {
+        const auto xml = classXml(pair.first, pair.second);
+        index << "<compound refid=\"class" << pair.first << "\" kind=\"class\"><name>" << pair.first
+              << "</name></compound>\n";
+        std::ofstream((dir / ("class" + pair.first + ".xml")).string())
+            << header << "<doxygen version=\"1.8.17\">" << xml << "</doxygen>\n";
+        all << "  " << xml << "\n";
+    }
+    index << "</doxygenindex>\n";
+    all << "</doxygen>\n";
+    index.close();
+    all.close();
+
+    const auto folderPath = dir.string();
+    const auto combinedPath = (dir / "all.xml").string();
+
+    SECTION("Compounds") {
+        CHECK(!XmlSource::isCombined(folderPath));
+        CHECK(XmlSource::isCombined(combinedPath));
+        CHECK(XmlSource::getInputDir(combinedPath) == folderPath);
+
+        XmlSource folder(folderPath);
+        XmlSource combined(combinedPath);
+
+        std::vector<std::string> folderRefids;
+        std::vector<std::string> combinedRefids;
+        folder.allCompounds([&](const std::string& kind, const std::string& refid) {
+            CHECK(kind == "class");
+            folderRefids.push_back(refid);
+        });
+        combined.allCompounds([&](const std::string& kind, const std::string& refid) {
+            CHECK(kind == "class");
+            combinedRefids.push_back(refid);
+        });
+        CHECK(combinedRefids == std::vector<std::string>{"classFoo", "classBar", "classBaz"});
+        CHECK(folderRefids == combinedRefids);
+
+        for (const auto& refid : combinedRefids) {
+            const auto xml = combined.load(refid);
+            CHECK(XmlSource::getCompounddef(*xml).getAttr("id") == refid);
+        }
+        CHECK_THROWS(combined.load("classMissing"));
+    }
+
+    SECTION("Nodes") {
+        Config config;
+        Doxygen folder(config);
+        folder.load(folderPath);
+        Doxygen combined(config);
+        combined.load(combinedPath);
+
+        for (const auto& pair : classes) {
+            const auto a = folder.find("class" + pair.first);
+            const auto b = combined.find("class" + pair.first);
+            CHECK(b->getName() == pair.first);
+            CHECK(b->getChildren().size() == static_cast<size_t>(pair.second));
+            CHECK(b->getHash() == a->getHash());
+            CHECK(b->getXmlPath() == combinedPath);
+        }
+    }
+
+    std::filesystem::remove_all(dir);
+}